@@ -16,6 +16,8 @@
 #include <Core/Models/Transaction.h>
 #include <Core/Traits/Lockable.h>
 #include <Crypto/BigInteger.h>
+#include <PMMR/TxHashSetDownload.h>
+#include <PMMR/TxHashSetZipFile.h>
 
 #include <vector>
 #include <memory>
@@ -49,10 +51,26 @@ public:
 	virtual uint64_t GetTotalDifficulty(const EChainType chainType) const = 0;
 
 	virtual EBlockChainStatus AddBlock(const FullBlock& block) = 0;
+
+	//
+	// Validates everything in the block that can be checked without the chain state (kernel signatures, rangeproofs, sums, etc.),
+	// and marks the block as validated so AddBlock won't check it again.
+	// This doesn't take the chain lock, so it's safe to verify many blocks concurrently before adding them in order.
+	// Returns false if the block is invalid.
+	//
+	virtual bool VerifyBlockSelfConsistent(const FullBlock& block) const = 0;
 	virtual EBlockChainStatus AddCompactBlock(const CompactBlock& compactBlock) = 0;
 
-	virtual std::string SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) = 0;
+	virtual TxHashSetZipFilePtr SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) = 0;
 	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const std::string& path, SyncStatus& syncStatus) = 0;
+
+	//
+	// Closes the current TxHashSet, and begins extracting the TxHashSet zip for the given block as it's downloaded.
+	// Once the whole zip has been written to the download, it should be passed to ProcessTxHashSetDownload.
+	// Returns nullptr if the block header isn't known.
+	//
+	virtual ITxHashSetDownloadPtr BeginTxHashSetDownload(const Hash& blockHash) = 0;
+	virtual EBlockChainStatus ProcessTxHashSetDownload(ITxHashSetDownloadPtr pDownload, SyncStatus& syncStatus) = 0;
 	virtual EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) = 0;
 	virtual TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const = 0;
 
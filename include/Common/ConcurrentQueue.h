@@ -1,6 +1,7 @@
 #pragma once
 
 #include <deque>
+#include <iterator>
 #include <vector>
 #include <thread>
 #include <functional>
@@ -86,6 +87,22 @@ public:
 		}
 	}
 
+	std::vector<T> pop_all()
+	{
+		std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+		std::vector<T> items(std::make_move_iterator(m_deque.begin()), std::make_move_iterator(m_deque.end()));
+		m_deque.clear();
+
+		return items;
+	}
+
+	size_t size() const
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+		return m_deque.size();
+	}
+
 	//T pop()
 	//{
 	//	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+//
+// Charges every cache entry 1, so a ShardedLRUCache's capacity is its max number of entries.
+//
+struct LRUEntryCounter
+{
+	template<class KEY, class VALUE>
+	size_t operator()(const KEY&, const VALUE&) const { return 1; }
+};
+
+//
+// A thread-safe LRU cache that is split into NUM_SHARDS independently locked shards.
+// Each key is assigned to a shard by its hash, so threads working on different keys rarely contend for the same lock.
+// The capacity is divided evenly between the shards, and each shard evicts its own least recently used entries.
+//
+// The capacity is measured in whatever SIZER charges for each entry: the number of entries by default,
+// or e.g. the number of bytes for a SIZER that returns the entry's size. An entry that's bigger than a shard's capacity isn't cached.
+//
+template<class KEY, class VALUE, class HASHER = std::hash<KEY>, size_t NUM_SHARDS = 16, class SIZER = LRUEntryCounter>
+class ShardedLRUCache
+{
+public:
+	ShardedLRUCache(const size_t capacity)
+		: m_hits(0), m_misses(0)
+	{
+		SetCapacity(capacity);
+	}
+
+	ShardedLRUCache(const ShardedLRUCache&) = delete;
+	ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+	//
+	// Looks up the value for the given key and marks it as most recently used.
+	// Returns false if the key is not cached.
+	//
+	bool Get(const KEY& key, VALUE& valueOut)
+	{
+		Shard& shard = GetShard(key);
+
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		auto iter = shard.entries.find(key);
+		if (iter == shard.entries.end())
+		{
+			++m_misses;
+			return false;
+		}
+
+		shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+		valueOut = iter->second->second;
+		++m_hits;
+		return true;
+	}
+
+	bool Contains(const KEY& key)
+	{
+		Shard& shard = GetShard(key);
+
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		auto iter = shard.entries.find(key);
+		if (iter == shard.entries.end())
+		{
+			++m_misses;
+			return false;
+		}
+
+		shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+		++m_hits;
+		return true;
+	}
+
+	void Put(const KEY& key, const VALUE& value)
+	{
+		Shard& shard = GetShard(key);
+
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		auto iter = shard.entries.find(key);
+		if (iter != shard.entries.end())
+		{
+			shard.charge -= SIZER()(key, iter->second->second);
+			shard.lru.erase(iter->second);
+			shard.entries.erase(iter);
+		}
+
+		const size_t charge = SIZER()(key, value);
+		if (charge > shard.capacity)
+		{
+			return;
+		}
+
+		shard.lru.emplace_front(key, value);
+		shard.entries.insert({ key, shard.lru.begin() });
+		shard.charge += charge;
+		Evict(shard);
+	}
+
+	void Erase(const KEY& key)
+	{
+		Shard& shard = GetShard(key);
+
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		auto iter = shard.entries.find(key);
+		if (iter != shard.entries.end())
+		{
+			shard.charge -= SIZER()(key, iter->second->second);
+			shard.lru.erase(iter->second);
+			shard.entries.erase(iter);
+		}
+	}
+
+	void Clear()
+	{
+		for (Shard& shard : m_shards)
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			shard.entries.clear();
+			shard.lru.clear();
+			shard.charge = 0;
+		}
+	}
+
+	//
+	// Changes the total capacity, evicting the least recently used entries of any shard that is now over capacity.
+	// A capacity of 0 disables the cache.
+	//
+	void SetCapacity(const size_t capacity)
+	{
+		m_capacity = capacity;
+
+		const size_t shardCapacity = (capacity + NUM_SHARDS - 1) / NUM_SHARDS;
+		for (Shard& shard : m_shards)
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			shard.capacity = shardCapacity;
+			Evict(shard);
+		}
+	}
+
+	size_t GetCapacity() const { return m_capacity; }
+	uint64_t GetHits() const { return m_hits; }
+	uint64_t GetMisses() const { return m_misses; }
+
+	size_t GetSize() const
+	{
+		size_t size = 0;
+		for (const Shard& shard : m_shards)
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			size += shard.entries.size();
+		}
+
+		return size;
+	}
+
+	//
+	// Returns the sum of what SIZER charges for each cached entry.
+	//
+	size_t GetCharge() const
+	{
+		size_t charge = 0;
+		for (const Shard& shard : m_shards)
+		{
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			charge += shard.charge;
+		}
+
+		return charge;
+	}
+
+private:
+	struct Shard
+	{
+		Shard() : capacity(0), charge(0) { }
+
+		mutable std::mutex mutex;
+		size_t capacity;
+		size_t charge;
+		std::list<std::pair<KEY, VALUE>> lru;
+		std::unordered_map<KEY, typename std::list<std::pair<KEY, VALUE>>::iterator, HASHER> entries;
+	};
+
+	Shard& GetShard(const KEY& key)
+	{
+		// Mix in the high bits, so the shard doesn't depend only on the lowest byte that the hasher picked.
+		const uint64_t hash = (uint64_t)HASHER()(key);
+		return m_shards[(size_t)((hash ^ (hash >> 32)) % NUM_SHARDS)];
+	}
+
+	// Caller must hold the shard's lock.
+	static void Evict(Shard& shard)
+	{
+		while (shard.charge > shard.capacity)
+		{
+			shard.charge -= SIZER()(shard.lru.back().first, shard.lru.back().second);
+			shard.entries.erase(shard.lru.back().first);
+			shard.lru.pop_back();
+		}
+	}
+
+	std::array<Shard, NUM_SHARDS> m_shards;
+	std::atomic<size_t> m_capacity;
+	std::atomic<uint64_t> m_hits;
+	std::atomic<uint64_t> m_misses;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <Infrastructure/ThreadManager.h>
+#include <Common/Util/ThreadUtil.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//
+// A fixed-size pool of worker threads sharing a single task queue.
+// Threads that are waiting on tasks can help drain the queue (see Wait), so tasks may safely submit and wait on other tasks.
+// Destroying the pool finishes all queued tasks before joining the workers.
+//
+class ThreadPool
+{
+public:
+	ThreadPool(const std::string& name, const size_t numThreads)
+		: m_terminate(false)
+	{
+		const size_t threadsToCreate = std::max((size_t)1, numThreads);
+		m_workers.reserve(threadsToCreate);
+		for (size_t i = 0; i < threadsToCreate; i++)
+		{
+			m_workers.emplace_back(std::thread(Thread_Worker, std::ref(*this), name));
+		}
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_terminate = true;
+		}
+
+		m_condition.notify_all();
+		ThreadUtil::JoinAll(m_workers);
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	//
+	// Returns the number of hardware threads, or 1 if it could not be determined.
+	//
+	static size_t GetDefaultNumThreads()
+	{
+		return std::max((unsigned int)1, std::thread::hardware_concurrency());
+	}
+
+	size_t GetNumThreads() const { return m_workers.size(); }
+
+	size_t GetNumPendingTasks() const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return m_tasks.size();
+	}
+
+	//
+	// Queues the task to be run on one of the worker threads.
+	// Exceptions thrown by the task are rethrown when calling get() on the returned future.
+	//
+	template<class F>
+	auto Submit(F&& task) -> std::future<decltype(task())>
+	{
+		using RESULT_TYPE = decltype(task());
+
+		auto pTask = std::make_shared<std::packaged_task<RESULT_TYPE()>>(std::forward<F>(task));
+		std::future<RESULT_TYPE> future = pTask->get_future();
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_tasks.emplace_back([pTask]() { (*pTask)(); });
+		}
+
+		m_condition.notify_one();
+		return future;
+	}
+
+	//
+	// Blocks until all of the futures are ready, running queued tasks on the calling thread in the meantime.
+	//
+	template<class T>
+	void Wait(const std::vector<std::future<T>>& futures)
+	{
+		for (const std::future<T>& future : futures)
+		{
+			while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				if (!RunPendingTask())
+				{
+					future.wait_for(std::chrono::milliseconds(5));
+				}
+			}
+		}
+	}
+
+private:
+	//
+	// Pops the next task off of the queue and runs it on the calling thread.
+	// Returns false if there were no tasks to run.
+	//
+	bool RunPendingTask()
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_tasks.empty())
+			{
+				return false;
+			}
+
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+
+		task();
+		return true;
+	}
+
+	static void Thread_Worker(ThreadPool& pool, const std::string name)
+	{
+		ThreadManagerAPI::SetCurrentThreadName(name);
+
+		while (true)
+		{
+			std::function<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock(pool.m_mutex);
+				pool.m_condition.wait(lock, [&pool] { return pool.m_terminate || !pool.m_tasks.empty(); });
+
+				if (pool.m_tasks.empty())
+				{
+					return;
+				}
+
+				task = std::move(pool.m_tasks.front());
+				pool.m_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::function<void()>> m_tasks;
+	std::vector<std::thread> m_workers;
+	bool m_terminate;
+};
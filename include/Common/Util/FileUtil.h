@@ -12,6 +12,7 @@
 #include <Windows.h>
 #else
 #include <unistd.h>
+#include <fcntl.h>
 #endif
 
 class FileUtil
@@ -185,6 +186,63 @@ public:
 #endif
 	}
 
+	//
+	// Grows the file to the given size, reserving the disk space for it where the platform allows,
+	// so that writes through a memory mapping of the file can't fail later due to a full disk.
+	//
+	static bool AllocateFile(const std::string& filePath, const uint64_t size)
+	{
+#if defined(__linux__)
+		const int fd = open(StringUtil::ToWide(filePath).c_str(), O_RDWR);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		const bool success = posix_fallocate(fd, 0, (off_t)size) == 0;
+		close(fd);
+
+		return success;
+#else
+		return TruncateFile(filePath, size);
+#endif
+	}
+
+	//
+	// Writes the data over the start of the file (creating it if needed), and waits for it to reach the disk.
+	// The file isn't truncated first, so a small fixed-size file (e.g. a stored size) is never seen empty.
+	//
+	static bool OverwriteAndSync(const fs::path& filePath, const std::vector<unsigned char>& data)
+	{
+#if defined(WIN32)
+		HANDLE hFile = CreateFileW(filePath.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (hFile == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		DWORD bytesWritten = 0;
+		const bool success = WriteFile(hFile, data.data(), (DWORD)data.size(), &bytesWritten, NULL)
+			&& bytesWritten == data.size()
+			&& FlushFileBuffers(hFile);
+
+		CloseHandle(hFile);
+
+		return success;
+#else
+		const int fd = open(filePath.c_str(), O_WRONLY | O_CREAT, 0644);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		const bool success = pwrite(fd, data.data(), data.size(), 0) == (ssize_t)data.size() && fsync(fd) == 0;
+		close(fd);
+
+		return success;
+#endif
+	}
+
 	static std::vector<std::string> GetSubDirectories(const fs::path& filePath, const bool includeHidden)
 	{
 		std::vector<std::string> listOfFiles;
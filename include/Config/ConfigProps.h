@@ -25,12 +25,46 @@ namespace ConfigProps
 		static const std::string PATIENCE_SECS = "PATIENCE_SECS";
 		static const std::string STEM_PROBABILITY = "STEM_PROBABILITY";
 	}
+
+	namespace VerificationCache
+	{
+		static const std::string VERIFICATION_CACHE = "VERIFICATION_CACHE";
+
+		static const std::string RANGEPROOF_CAPACITY = "RANGEPROOF_CAPACITY";
+		static const std::string KERNEL_CAPACITY = "KERNEL_CAPACITY";
+	}
+
+	namespace Database
+	{
+		static const std::string DATABASE = "DATABASE";
+
+		static const std::string SHARED_CACHE_MB = "SHARED_CACHE_MB";
+		static const std::string HEADER_CACHE_SIZE = "HEADER_CACHE_SIZE";
+
+		// Column family sections
+		static const std::string BLOCK = "BLOCK";
+		static const std::string HEADER = "HEADER";
+		static const std::string BLOCK_SUMS = "BLOCK_SUMS";
+		static const std::string OUTPUT_POS = "OUTPUT_POS";
+		static const std::string INPUT_BITMAP = "INPUT_BITMAP";
+
+		// Column family settings
+		static const std::string BLOCK_CACHE_MB = "BLOCK_CACHE_MB";
+		static const std::string COMPRESSION = "COMPRESSION";
+		static const std::string BLOOM_BITS_PER_KEY = "BLOOM_BITS_PER_KEY";
+		static const std::string BLOOM_PREFIX_LENGTH = "BLOOM_PREFIX_LENGTH";
+		static const std::string WHOLE_KEY_FILTERING = "WHOLE_KEY_FILTERING";
+		static const std::string PIN_L0_FILTER_AND_INDEX = "PIN_L0_FILTER_AND_INDEX";
+		static const std::string WRITE_BUFFER_MB = "WRITE_BUFFER_MB";
+	}
 	
 	namespace Server
 	{
 		static const std::string SERVER = "SERVER";
 
 		static const std::string REST_API_PORT = "REST_API_PORT";
+		static const std::string REST_API_THREADS = "REST_API_THREADS";
+		static const std::string REST_API_CACHE_SIZE = "REST_API_CACHE_SIZE";
 		static const std::string OWNER_API_PORT = "OWNER_API_PORT";
 	}
 
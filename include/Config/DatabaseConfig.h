@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <json/json.h>
+#include <Config/ConfigProps.h>
+
+//
+// How the BlockDB tunes a single column family.
+//
+class ColumnFamilyConfig
+{
+public:
+	// Size of the column family's own LRU block cache. 0 shares the database's cache with the other column families.
+	uint32_t GetBlockCacheMB() const { return m_blockCacheMB; }
+
+	// "NONE", "SNAPPY", "ZLIB", "LZ4" or "ZSTD". Falls back to "NONE" when RocksDB wasn't built with the library.
+	const std::string& GetCompression() const { return m_compression; }
+
+	// Bits per key of the bloom filter. 0 disables the filter.
+	uint32_t GetBloomBitsPerKey() const { return m_bloomBitsPerKey; }
+
+	// Length of the key prefix to build prefix blooms from. 0 builds them from whole keys only.
+	uint32_t GetBloomPrefixLength() const { return m_bloomPrefixLength; }
+	bool IsWholeKeyFiltering() const { return m_wholeKeyFiltering; }
+
+	// Keeps the index and filter blocks of level 0 files pinned in the block cache.
+	bool IsPinL0FilterAndIndex() const { return m_pinL0FilterAndIndex; }
+
+	uint32_t GetWriteBufferMB() const { return m_writeBufferMB; }
+
+	//
+	// Constructor
+	//
+	ColumnFamilyConfig(
+		const Json::Value& json,
+		const std::string& name,
+		const uint32_t blockCacheMB,
+		const std::string& compression,
+		const uint32_t writeBufferMB)
+	{
+		m_blockCacheMB = blockCacheMB;
+		m_compression = compression;
+		m_bloomBitsPerKey = 10;
+		m_bloomPrefixLength = 0;
+		m_wholeKeyFiltering = true;
+		m_pinL0FilterAndIndex = true;
+		m_writeBufferMB = writeBufferMB;
+
+		if (json.isMember(name))
+		{
+			const Json::Value& columnJSON = json[name];
+
+			if (columnJSON.isMember(ConfigProps::Database::BLOCK_CACHE_MB))
+			{
+				m_blockCacheMB = columnJSON.get(ConfigProps::Database::BLOCK_CACHE_MB, blockCacheMB).asUInt();
+			}
+
+			if (columnJSON.isMember(ConfigProps::Database::COMPRESSION))
+			{
+				m_compression = columnJSON.get(ConfigProps::Database::COMPRESSION, compression).asString();
+			}
+
+			if (columnJSON.isMember(ConfigProps::Database::BLOOM_BITS_PER_KEY))
+			{
+				m_bloomBitsPerKey = columnJSON.get(ConfigProps::Database::BLOOM_BITS_PER_KEY, 10).asUInt();
+			}
+
+			if (columnJSON.isMember(ConfigProps::Database::BLOOM_PREFIX_LENGTH))
+			{
+				m_bloomPrefixLength = columnJSON.get(ConfigProps::Database::BLOOM_PREFIX_LENGTH, 0).asUInt();
+			}
+
+			if (columnJSON.isMember(ConfigProps::Database::WHOLE_KEY_FILTERING))
+			{
+				m_wholeKeyFiltering = columnJSON.get(ConfigProps::Database::WHOLE_KEY_FILTERING, true).asBool();
+			}
+
+			if (columnJSON.isMember(ConfigProps::Database::PIN_L0_FILTER_AND_INDEX))
+			{
+				m_pinL0FilterAndIndex = columnJSON.get(ConfigProps::Database::PIN_L0_FILTER_AND_INDEX, true).asBool();
+			}
+
+			if (columnJSON.isMember(ConfigProps::Database::WRITE_BUFFER_MB))
+			{
+				m_writeBufferMB = columnJSON.get(ConfigProps::Database::WRITE_BUFFER_MB, writeBufferMB).asUInt();
+			}
+		}
+	}
+
+private:
+	uint32_t m_blockCacheMB;
+	std::string m_compression;
+	uint32_t m_bloomBitsPerKey;
+	uint32_t m_bloomPrefixLength;
+	bool m_wholeKeyFiltering;
+	bool m_pinL0FilterAndIndex;
+	uint32_t m_writeBufferMB;
+};
+
+//
+// RocksDB tuning for the BlockDB.
+//
+// Full blocks are large and rarely read after they're processed, so by default they're compressed and given a small
+// cache of their own, leaving the shared cache to the headers, block sums and output positions, which are read constantly.
+//
+class DatabaseConfig
+{
+public:
+	// Size of the LRU block cache shared by every column family that doesn't have its own.
+	uint32_t GetSharedCacheMB() const { return m_sharedCacheMB; }
+
+	// Max number of deserialized block headers to keep in memory. 0 disables the cache.
+	uint32_t GetHeaderCacheSize() const { return m_headerCacheSize; }
+
+	const ColumnFamilyConfig& GetBlock() const { return m_block; }
+	const ColumnFamilyConfig& GetHeader() const { return m_header; }
+	const ColumnFamilyConfig& GetBlockSums() const { return m_blockSums; }
+	const ColumnFamilyConfig& GetOutputPos() const { return m_outputPos; }
+	const ColumnFamilyConfig& GetInputBitmap() const { return m_inputBitmap; }
+
+	//
+	// Constructor
+	//
+	DatabaseConfig(const Json::Value& json)
+		: m_sharedCacheMB(256),
+		m_headerCacheSize(16384),
+		m_block(GetSection(json), ConfigProps::Database::BLOCK, 32, "LZ4", 64),
+		m_header(GetSection(json), ConfigProps::Database::HEADER, 0, "NONE", 32),
+		m_blockSums(GetSection(json), ConfigProps::Database::BLOCK_SUMS, 0, "NONE", 16),
+		m_outputPos(GetSection(json), ConfigProps::Database::OUTPUT_POS, 0, "NONE", 64),
+		m_inputBitmap(GetSection(json), ConfigProps::Database::INPUT_BITMAP, 0, "NONE", 16)
+	{
+		const Json::Value& databaseJSON = GetSection(json);
+		if (databaseJSON.isMember(ConfigProps::Database::SHARED_CACHE_MB))
+		{
+			m_sharedCacheMB = databaseJSON.get(ConfigProps::Database::SHARED_CACHE_MB, 256).asUInt();
+		}
+
+		if (databaseJSON.isMember(ConfigProps::Database::HEADER_CACHE_SIZE))
+		{
+			m_headerCacheSize = databaseJSON.get(ConfigProps::Database::HEADER_CACHE_SIZE, 16384).asUInt();
+		}
+	}
+
+private:
+	static const Json::Value& GetSection(const Json::Value& json)
+	{
+		static const Json::Value EMPTY(Json::objectValue);
+		if (json.isMember(ConfigProps::Database::DATABASE))
+		{
+			return json[ConfigProps::Database::DATABASE];
+		}
+
+		return EMPTY;
+	}
+
+	uint32_t m_sharedCacheMB;
+	uint32_t m_headerCacheSize;
+	ColumnFamilyConfig m_block;
+	ColumnFamilyConfig m_header;
+	ColumnFamilyConfig m_blockSums;
+	ColumnFamilyConfig m_outputPos;
+	ColumnFamilyConfig m_inputBitmap;
+};
@@ -3,7 +3,9 @@
 #include <Common/Util/FileUtil.h>
 #include <Config/DandelionConfig.h>
 #include <Config/ClientMode.h>
+#include <Config/DatabaseConfig.h>
 #include <Config/P2PConfig.h>
+#include <Config/VerificationCacheConfig.h>
 
 #include <cstdint>
 #include <json/json.h>
@@ -16,16 +18,19 @@ public:
 	//
 	const P2PConfig& GetP2P() const { return m_p2pConfig; }
 	const DandelionConfig& GetDandelion() const { return m_dandelion; }
+	const VerificationCacheConfig& GetVerificationCache() const { return m_verificationCache; }
+	const DatabaseConfig& GetDatabase() const { return m_database; }
 	EClientMode GetClientMode() const { return EClientMode::FAST_SYNC; }
 	const fs::path& GetChainPath() const { return m_chainPath; }
 	const fs::path& GetDatabasePath() const { return m_databasePath; }
 	const fs::path& GetTxHashSetPath() const { return m_txHashSetPath; }
+	const fs::path& GetTxHashSetDownloadPath() const { return m_txHashSetDownloadPath; }
 
 	//
 	// Constructor
 	//
 	NodeConfig(const Json::Value& json, const fs::path& dataPath)
-		: m_p2pConfig(json), m_dandelion(json)
+		: m_p2pConfig(json), m_dandelion(json), m_verificationCache(json), m_database(json)
 	{
 		const fs::path nodePath = FileUtil::ToPath(dataPath.u8string() + "NODE/");
 
@@ -41,13 +46,19 @@ public:
 		fs::create_directories(FileUtil::ToPath(m_txHashSetPath.u8string() + "kernel/"));
 		fs::create_directories(FileUtil::ToPath(m_txHashSetPath.u8string() + "output/"));
 		fs::create_directories(FileUtil::ToPath(m_txHashSetPath.u8string() + "rangeproof/"));
+
+		// Downloaded TxHashSets are extracted here, and only moved into the TxHashSet directory once they're validated.
+		m_txHashSetDownloadPath = FileUtil::ToPath(nodePath.u8string() + "TXHASHSET_DOWNLOAD/");
 	}
 
 private:
 	fs::path m_chainPath;
 	fs::path m_databasePath;
 	fs::path m_txHashSetPath;
+	fs::path m_txHashSetDownloadPath;
 
 	P2PConfig m_p2pConfig;
 	DandelionConfig m_dandelion;
+	VerificationCacheConfig m_verificationCache;
+	DatabaseConfig m_database;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <json/json.h>
 #include <Config/ConfigProps.h>
@@ -12,6 +13,10 @@ public:
 	// Getters
 	//
 	uint32_t GetRestAPIPort() const { return m_restAPIPort; }
+	uint32_t GetRestAPIThreads() const { return m_restAPIThreads; }
+
+	// The max number of bytes of responses to immutable resources (e.g. blocks and headers by hash) to keep cached. 0 disables the cache.
+	uint32_t GetRestAPICacheSize() const { return m_restAPICacheSize; }
 	const std::string& GetGrinJoinSecretKey() const { return m_grinjoinSecretKey; }
 
 	//
@@ -28,6 +33,9 @@ public:
 			m_restAPIPort = 13413;
 		}
 
+		m_restAPIThreads = 5;
+		m_restAPICacheSize = 32 * 1024 * 1024;
+
 		if (json.isMember(ConfigProps::Server::SERVER))
 		{
 			const Json::Value& serverJSON = json[ConfigProps::Server::SERVER];
@@ -36,10 +44,22 @@ public:
 			{
 				m_restAPIPort = serverJSON.get(ConfigProps::Server::REST_API_PORT, m_restAPIPort).asInt();
 			}
+
+			if (serverJSON.isMember(ConfigProps::Server::REST_API_THREADS))
+			{
+				m_restAPIThreads = (std::max)(serverJSON.get(ConfigProps::Server::REST_API_THREADS, m_restAPIThreads).asUInt(), 1u);
+			}
+
+			if (serverJSON.isMember(ConfigProps::Server::REST_API_CACHE_SIZE))
+			{
+				m_restAPICacheSize = serverJSON.get(ConfigProps::Server::REST_API_CACHE_SIZE, m_restAPICacheSize).asUInt();
+			}
 		}
 	}
 
 private:
 	uint32_t m_restAPIPort;
+	uint32_t m_restAPIThreads;
+	uint32_t m_restAPICacheSize;
 	std::string m_grinjoinSecretKey;
 };
\ No newline at end of file
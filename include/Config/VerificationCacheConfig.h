@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <json/json.h>
+#include <Config/ConfigProps.h>
+
+class VerificationCacheConfig
+{
+public:
+	// Max number of verified (commitment, rangeproof) pairs to remember. 0 disables the cache.
+	uint32_t GetRangeProofCapacity() const { return m_rangeProofCapacity; }
+
+	// Max number of kernels with verified signatures to remember. 0 disables the cache.
+	uint32_t GetKernelCapacity() const { return m_kernelCapacity; }
+
+	//
+	// Constructor
+	//
+	VerificationCacheConfig(const Json::Value& json)
+	{
+		m_rangeProofCapacity = 20000;
+		m_kernelCapacity = 20000;
+
+		if (json.isMember(ConfigProps::VerificationCache::VERIFICATION_CACHE))
+		{
+			const Json::Value& cacheJSON = json[ConfigProps::VerificationCache::VERIFICATION_CACHE];
+
+			if (cacheJSON.isMember(ConfigProps::VerificationCache::RANGEPROOF_CAPACITY))
+			{
+				m_rangeProofCapacity = cacheJSON.get(ConfigProps::VerificationCache::RANGEPROOF_CAPACITY, 20000).asUInt();
+			}
+
+			if (cacheJSON.isMember(ConfigProps::VerificationCache::KERNEL_CAPACITY))
+			{
+				m_kernelCapacity = cacheJSON.get(ConfigProps::VerificationCache::KERNEL_CAPACITY, 20000).asUInt();
+			}
+		}
+	}
+
+private:
+	uint32_t m_rangeProofCapacity;
+	uint32_t m_kernelCapacity;
+};
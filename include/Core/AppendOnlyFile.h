@@ -11,6 +11,11 @@
 #include <Core/Exceptions/FileException.h>
 #include <Infrastructure/Logger.h>
 #include <Common/Util/FileUtil.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -21,15 +26,53 @@
 #define MPATH_STR m_path.string()
 #endif
 
+//
+// A file that is appended to and rewound in batches, and read through a read-write memory mapping.
+//
+// The file is grown in large preallocated extents, so appends are copied straight into the mapping,
+// and the file only needs to be remapped when an extent fills up. Because the end of the file may be unused,
+// the committed (logical) size is persisted (and synced) separately in "<path>.size", and is only updated after the data is synced.
+// Bytes past the logical size are never read, so a crash mid-flush just leaves the previously committed size.
+//
+// Committed bytes are never overwritten before Flush. Once a batch rewinds into committed data, everything it appends
+// is staged in memory until Flush, which first persists the lowered size, then copies the staged bytes into the mapping.
+// A crash at any point therefore leaves either the committed data, or (mid-flush) its untouched prefix.
+//
+// On destruction, uncommitted changes are discarded, the file is trimmed to its logical size and the size file is removed,
+// so files that aren't open always have their natural sizes (e.g. when zipping a TxHashSet snapshot).
+//
 class AppendOnlyFile
 {
+	static const uint64_t EXTENT_SIZE = 8 * 1024 * 1024;
+
 public:
 	AppendOnlyFile(const std::string& path)
 		: m_path(StringUtil::ToWide(path)),
-		m_bufferIndex(0),
-		m_fileSize(0)
+		m_sizePath(StringUtil::ToWide(path + ".size")),
+		m_fileSize(0),
+		m_size(0),
+		m_capacity(0),
+		m_stagedIndex(0)
+	{
+
+	}
+
+	~AppendOnlyFile()
 	{
+		if (m_mmap.is_mapped())
+		{
+			Discard();
 
+			std::error_code error;
+			m_mmap.sync(error);
+			m_mmap.unmap();
+
+			if (FileUtil::TruncateFile(m_path.u8string(), m_fileSize))
+			{
+				std::error_code removeError;
+				fs::remove(m_sizePath, removeError);
+			}
+		}
 	}
 
 	AppendOnlyFile(const AppendOnlyFile& file) = delete;
@@ -56,139 +99,223 @@ public:
 			outFile.close();
 		}
 
-		m_fileSize = FileUtil::GetFileSize(m_path.u8string());
-		m_bufferIndex = m_fileSize;
+		m_capacity = FileUtil::GetFileSize(m_path.u8string());
 
-		if (m_fileSize > 0)
+		// Files without a size file were closed cleanly (or written by another implementation), so they're all data.
+		m_fileSize = m_capacity;
+		std::vector<unsigned char> sizeBytes;
+		if (FileUtil::ReadFile(m_sizePath, sizeBytes) && sizeBytes.size() == 8)
 		{
-			std::error_code error;
-			m_mmap = mio::make_mmap_source(MPATH_STR, error);
-			if (error.value() > 0)
-			{
-				LOG_ERROR_F("Failed to mmap file: {}", error.value());
-				throw FILE_EXCEPTION_F("Failed to mmap file: {}", m_path);
-			}
+			m_fileSize = (std::min)(ByteBuffer(std::move(sizeBytes)).ReadU64(), m_capacity);
 		}
-	}
 
-	bool Flush()
-	{
-		if (m_fileSize == m_bufferIndex && m_buffer.empty())
-		{
-			return true;
-		}
+		m_size = m_fileSize;
+		m_stagedIndex = m_fileSize;
 
-		if (m_fileSize < m_bufferIndex)
+		if (m_capacity > 0)
 		{
-			return false;
+			Map();
 		}
+	}
 
-		m_mmap.unmap();
-
-		if (m_fileSize > m_bufferIndex)
+	bool Flush()
+	{
+		if (m_size == m_fileSize && !IsStaging())
 		{
-			FileUtil::TruncateFile(m_path.u8string(), m_bufferIndex);
+			return true;
 		}
 
-		if (!m_buffer.empty())
+		if (IsStaging())
 		{
-			std::ofstream file(m_path.c_str(), std::ios::out | std::ios::binary | std::ios::app);
-			if (!file.is_open())
+			// Committed data is about to be overwritten, so only the untouched prefix is valid until the sync finishes.
+			if (!WriteLogicalSize(m_stagedIndex))
 			{
 				return false;
 			}
 
-			file.seekp(m_bufferIndex, std::ios::beg);
-
-			if (!m_buffer.empty())
+			Reserve(m_size);
+			if (!m_staged.empty())
 			{
-				file.write((const char*)& m_buffer[0], m_buffer.size());
+				memcpy(m_mmap.data() + m_stagedIndex, m_staged.data(), m_staged.size());
 			}
-
-			file.close();
 		}
 
-		m_fileSize = m_bufferIndex + m_buffer.size();
-
-		m_bufferIndex = m_fileSize;
-		m_buffer.clear();
-
-		if (m_fileSize > 0)
+		if (m_mmap.is_mapped())
 		{
 			std::error_code error;
-			m_mmap = mio::make_mmap_source(MPATH_STR, error);
+			m_mmap.sync(error);
 			if (error.value() > 0)
 			{
-				LOG_ERROR_F("Failed to mmap file: {}", error.value());
+				LOG_ERROR_F("Failed to sync file {}: {}", m_path, error.value());
+				return false;
 			}
 		}
 
+		if (!WriteLogicalSize(m_size))
+		{
+			return false;
+		}
+
+		m_fileSize = m_size;
+		m_stagedIndex = m_size;
+		m_staged.clear();
+
 		return true;
 	}
 
 	void Append(const std::vector<unsigned char>& data)
 	{
-		m_buffer.insert(m_buffer.end(), data.cbegin(), data.cend());
+		if (!data.empty())
+		{
+			Append(data.data(), data.size());
+		}
 	}
 
-	bool Rewind(const uint64_t nextPosition)
+	void Append(const unsigned char* pData, const size_t numBytes)
 	{
-		if (!Flush())
+		if (IsStaging())
 		{
-			return false;
+			m_staged.insert(m_staged.end(), pData, pData + numBytes);
+		}
+		else
+		{
+			Reserve(m_size + numBytes);
+			memcpy(m_mmap.data() + m_size, pData, numBytes);
 		}
 
-		if (nextPosition > m_fileSize)
+		m_size += numBytes;
+	}
+
+	bool Rewind(const uint64_t nextPosition)
+	{
+		if (nextPosition > m_size)
 		{
 			return false;
 		}
 
-		if (nextPosition <= m_bufferIndex)
+		if (nextPosition < m_stagedIndex)
 		{
-			m_buffer.clear();
-			m_bufferIndex = nextPosition;
+			// Rewinding into committed data, so appends are staged from here on.
+			m_stagedIndex = nextPosition;
+			m_staged.clear();
 		}
-		else
+		else if (IsStaging())
 		{
-			m_buffer.erase(m_buffer.begin() + nextPosition - m_bufferIndex, m_buffer.end());
+			m_staged.resize(nextPosition - m_stagedIndex);
 		}
 
+		m_size = nextPosition;
 		return true;
 	}
 
 	bool Discard()
 	{
-		m_bufferIndex = m_fileSize;
-		m_buffer.clear();
+		m_size = m_fileSize;
+		m_stagedIndex = m_fileSize;
+		m_staged.clear();
 
 		return true;
 	}
 
 	uint64_t GetSize() const
 	{
-		return m_bufferIndex + m_buffer.size();
+		return m_size;
 	}
 
-	bool Read(const uint64_t position, const uint64_t numBytes, std::vector<unsigned char>& data) const
+	//
+	// Returns a pointer to the requested bytes without copying them out of the mmap (or the staged appends).
+	// The pointer is only valid until the next Append, Flush, Rewind or Discard.
+	// Returns nullptr if the requested range is out of bounds, or straddles the position a batch rewound to.
+	// Callers rewind to whole records, so a record is never split that way.
+	//
+	const unsigned char* Read(const uint64_t position, const uint64_t numBytes) const
 	{
-		if (position < m_bufferIndex)
+		if (position + numBytes > m_size)
 		{
-			data = std::vector<unsigned char>(m_mmap.cbegin() + position, m_mmap.cbegin() + position + numBytes);
+			return nullptr;
 		}
-		else
+
+		if (IsStaging() && position + numBytes > m_stagedIndex)
 		{
-			const uint64_t firstBufferIndex = position - m_bufferIndex;
+			if (position < m_stagedIndex)
+			{
+				return nullptr;
+			}
 
-			data = std::vector<unsigned char>(m_buffer.cbegin() + firstBufferIndex, m_buffer.cbegin() + firstBufferIndex + numBytes);
+			return m_staged.data() + (position - m_stagedIndex);
 		}
 
-		return true;
+		return (const unsigned char*)m_mmap.data() + position;
 	}
 
 private:
+	// True once the current batch has rewound into committed data.
+	bool IsStaging() const { return m_stagedIndex < m_fileSize; }
+
+	void Map()
+	{
+		std::error_code error;
+		m_mmap = mio::make_mmap_sink(MPATH_STR, error);
+		if (error.value() > 0)
+		{
+			LOG_ERROR_F("Failed to mmap file: {}", error.value());
+			throw FILE_EXCEPTION_F("Failed to mmap file: {}", m_path);
+		}
+	}
+
+	//
+	// Grows the file and its mapping to the next whole extent if it can't hold the given number of bytes.
+	//
+	void Reserve(const uint64_t numBytes)
+	{
+		if (numBytes <= m_capacity)
+		{
+			return;
+		}
+
+		const uint64_t capacity = ((numBytes + EXTENT_SIZE - 1) / EXTENT_SIZE) * EXTENT_SIZE;
+
+		m_mmap.unmap();
+		if (!FileUtil::AllocateFile(m_path.u8string(), capacity))
+		{
+			LOG_ERROR_F("Failed to grow file {} to {} bytes", m_path, capacity);
+			throw FILE_EXCEPTION_F("Failed to grow file: {}", m_path);
+		}
+
+		m_capacity = capacity;
+		Map();
+	}
+
+	bool WriteLogicalSize(const uint64_t size)
+	{
+		Serializer serializer;
+		serializer.Append<uint64_t>(size);
+
+		if (!FileUtil::OverwriteAndSync(m_sizePath, serializer.GetBytes()))
+		{
+			LOG_ERROR_F("Failed to write file: {}", m_sizePath);
+			return false;
+		}
+
+		return true;
+	}
+
 	fs::path m_path;
-	uint64_t m_bufferIndex;
+	fs::path m_sizePath;
+
+	// Committed size, as persisted in the size file.
 	uint64_t m_fileSize;
-	std::vector<unsigned char> m_buffer;
-	mio::mmap_source m_mmap;
+
+	// Current size, including uncommitted appends and rewinds.
+	uint64_t m_size;
+
+	// Number of bytes allocated for the file and mapped.
+	uint64_t m_capacity;
+
+	// The lowest position rewound to since the last flush. When that's below m_fileSize,
+	// the bytes [m_stagedIndex, m_size) are kept in m_staged instead of being written over committed data.
+	uint64_t m_stagedIndex;
+	std::vector<unsigned char> m_staged;
+
+	mio::mmap_sink m_mmap;
 };
\ No newline at end of file
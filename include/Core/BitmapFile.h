@@ -3,11 +3,15 @@
 #include <Core/Traits/Batchable.h>
 #include <Roaring.h>
 #include <Common/Util/BitUtil.h>
+#include <Core/Exceptions/FileException.h>
+#include <Infrastructure/Logger.h>
+#include <Common/Util/FileUtil.h>
+#include <mio/mmap.hpp>
 #include <fstream>
 #include <functional>
 #include <algorithm>
-#include <map>
 #include <memory>
+#include <vector>
 
 #ifdef _WIN32
 #define MPATH_STR m_path.wstring()
@@ -17,12 +21,18 @@
 
 // NOTE: Uses bit positions numbered from 0-7, starting at the left.
 // For example, 65 (01000001) has bit positions 1 and 7 set.
+//
+// Uncommitted changes are kept in a page-granular overlay over the read-only mmap.
+// The first write to a page copies it from the mmap, and all later reads and writes of that page go to the copy.
+// Commit writes each run of consecutive dirty pages with a single write, then remaps the file.
 class BitmapFile : public Traits::IBatchable
 {
+	static const uint64_t PAGE_SIZE = 4096;
+
 public:
 	static std::shared_ptr<BitmapFile> Load(const std::string& path)
 	{
-		auto pBitmapFile = std::make_shared<BitmapFile>(BitmapFile(path));
+		auto pBitmapFile = std::shared_ptr<BitmapFile>(new BitmapFile(path));
 		pBitmapFile->Load();
 		return pBitmapFile;
 	}
@@ -38,35 +48,62 @@ public:
 
 	virtual void Commit() override final
 	{
-		if (!m_modifiedBytes.empty())
+		if (!IsDirty())
 		{
-			m_mmap.unmap();
+			return;
+		}
 
-			std::ofstream file(m_path.c_str(), std::ios_base::binary | std::ios_base::out | std::ios_base::in);
+		m_mmap.unmap();
+
+		std::ofstream file(m_path.c_str(), std::ios_base::binary | std::ios_base::out | std::ios_base::in);
+		if (!file.is_open())
+		{
+			LOG_ERROR_F("Failed to open file: {}", m_path);
+			throw FILE_EXCEPTION_F("Failed to open file: {}", m_path);
+		}
 
-			for (auto iter : m_modifiedBytes)
+		uint64_t pageIndex = 0;
+		while (pageIndex < m_pages.size())
+		{
+			if (m_pages[pageIndex] == nullptr)
 			{
-				file.seekp(iter.first);
-				file.write((const char*)&iter.second, 1);
+				++pageIndex;
+				continue;
 			}
 
-			file.close();
-
-			std::error_code error;
-			m_mmap = mio::make_mmap_source(MPATH_STR, error);
-			if (error.value() > 0)
+			// Coalesce consecutive dirty pages into one contiguous write.
+			const uint64_t firstPage = pageIndex;
+			std::vector<uint8_t> bytes;
+			while (pageIndex < m_pages.size() && m_pages[pageIndex] != nullptr)
 			{
-				// TODO: Handle this
+				bytes.insert(bytes.end(), m_pages[pageIndex]->cbegin(), m_pages[pageIndex]->cend());
+				++pageIndex;
 			}
 
-			m_modifiedBytes.clear();
-			SetDirty(false);
+			const uint64_t offset = firstPage * PAGE_SIZE;
+			bytes.resize((std::min)((uint64_t)bytes.size(), m_numBytes - offset));
+
+			file.seekp(offset);
+			file.write((const char*)bytes.data(), bytes.size());
+		}
+
+		file.close();
+		if (file.fail())
+		{
+			LOG_ERROR_F("Failed to write file: {}", m_path);
+			throw FILE_EXCEPTION_F("Failed to write file: {}", m_path);
 		}
+
+		m_pages.clear();
+		m_fileSize = m_numBytes;
+		Map();
+		SetDirty(false);
 	}
 
 	virtual void Rollback() override final
 	{
-		m_modifiedBytes.clear();
+		m_pages.clear();
+		m_numBytes = m_fileSize;
 		SetDirty(false);
 	}
 
@@ -77,10 +114,7 @@ public:
 
 	void Set(const uint64_t position)
 	{
-		SetDirty(true);
-		uint8_t byte = GetByte(position / 8);
-		byte |= BitToByte(position % 8);
-		m_modifiedBytes[position / 8] = byte;
+		GetWritableByte(position / 8) |= BitToByte(position % 8);
 	}
 
 	void Set(const Roaring& positionsToSet)
@@ -93,10 +127,7 @@ public:
 
 	void Unset(const uint64_t position)
 	{
-		SetDirty(true);
-		uint8_t byte = GetByte(position / 8);
-		byte &= (0xff ^ BitToByte(position % 8));
-		m_modifiedBytes[position / 8] = byte;
+		GetWritableByte(position / 8) &= (0xff ^ BitToByte(position % 8));
 	}
 
 	void Unset(const Roaring& positionsToUnset)
@@ -107,19 +138,69 @@ public:
 		}
 	}
 
+	//
+	// Returns numBytes bytes of the bitmap starting at startByte. Bytes past the end of the bitmap are returned as 0.
+	//
+	std::vector<uint8_t> GetBytes(const uint64_t startByte, const uint64_t numBytes) const
+	{
+		std::vector<uint8_t> bytes(numBytes, 0);
+
+		uint64_t byteIndex = startByte;
+		const uint64_t endByte = (std::min)(startByte + numBytes, m_numBytes);
+		while (byteIndex < endByte)
+		{
+			const uint64_t pageIndex = byteIndex / PAGE_SIZE;
+			const uint64_t pageEnd = (std::min)((pageIndex + 1) * PAGE_SIZE, endByte);
+			const uint8_t* pSource = GetPageData(pageIndex);
+			if (pSource != nullptr)
+			{
+				std::copy(pSource + (byteIndex % PAGE_SIZE), pSource + (byteIndex % PAGE_SIZE) + (pageEnd - byteIndex), bytes.begin() + (byteIndex - startByte));
+			}
+			else if (byteIndex < m_mmap.size())
+			{
+				const uint8_t* pMapped = (const uint8_t*)m_mmap.data();
+				const uint64_t mappedEnd = (std::min)(pageEnd, (uint64_t)m_mmap.size());
+				std::copy(pMapped + byteIndex, pMapped + mappedEnd, bytes.begin() + (byteIndex - startByte));
+			}
+
+			byteIndex = pageEnd;
+		}
+
+		return bytes;
+	}
+
 	const bool& operator[] (const size_t position) const
 	{
 		return IsSet(position) ? s_true : s_false;
 	}
 
+	//
+	// Sets the given positions, and unsets every position from size onward.
+	//
 	void Rewind(const size_t size, const Roaring& positionsToAdd)
 	{
 		Set(positionsToAdd);
 
-		size_t currentSize = GetNumBytes() * 8;
-		for (size_t i = size; i < currentSize; i++)
+		if (size >= m_numBytes * 8)
+		{
+			return;
+		}
+
+		// Clear the bits in the partial byte, then zero whole bytes a page at a time.
+		uint64_t byteIndex = size / 8;
+		if (size % 8 != 0)
+		{
+			GetWritableByte(byteIndex) &= (uint8_t)(0xff << (8 - (size % 8)));
+			++byteIndex;
+		}
+
+		while (byteIndex < m_numBytes)
 		{
-			Unset(i);
+			const uint64_t pageIndex = byteIndex / PAGE_SIZE;
+			const uint64_t pageEnd = (std::min)((pageIndex + 1) * PAGE_SIZE, m_numBytes);
+			std::vector<uint8_t>& page = GetWritablePage(pageIndex);
+			std::fill(page.begin() + (byteIndex % PAGE_SIZE), page.begin() + (pageEnd - (pageIndex * PAGE_SIZE)), (uint8_t)0);
+			byteIndex = pageEnd;
 		}
 	}
 
@@ -127,10 +208,15 @@ public:
 	{
 		Roaring bitmap;
 
-		const uint64_t numBytes = GetNumBytes();
-		for (uint32_t i = 0; i < (uint32_t)numBytes; i++)
+		const std::vector<uint8_t> bytes = GetBytes(0, m_numBytes);
+		for (uint32_t i = 0; i < (uint32_t)bytes.size(); i++)
 		{
-			const uint8_t byte = GetByte(i);
+			const uint8_t byte = bytes[i];
+			if (byte == 0)
+			{
+				continue;
+			}
+
 			for (uint8_t j = 0; j < 8; j++)
 			{
 				if ((byte & BitToByte(j)) > 0)
@@ -144,7 +230,8 @@ public:
 	}
 
 private:
-	BitmapFile(const std::string& path) : m_path(StringUtil::ToWide(path)) { }
+	BitmapFile(const std::string& path)
+		: m_path(StringUtil::ToWide(path)), m_fileSize(0), m_numBytes(0) { }
 
 	void Load()
 	{
@@ -166,9 +253,14 @@ private:
 			outFile.close();
 		}
 
-		m_size = FileUtil::GetFileSize(m_path.u8string());
+		m_fileSize = FileUtil::GetFileSize(m_path.u8string());
+		m_numBytes = m_fileSize;
+		Map();
+	}
 
-		if (m_size > 0)
+	void Map()
+	{
+		if (m_fileSize > 0)
 		{
 			std::error_code error;
 			m_mmap = mio::make_mmap_source(MPATH_STR, error);
@@ -180,12 +272,23 @@ private:
 		}
 	}
 
+	// Returns the overlay copy of the page, or nullptr if the page hasn't been modified.
+	const uint8_t* GetPageData(const uint64_t pageIndex) const
+	{
+		if (pageIndex < m_pages.size() && m_pages[pageIndex] != nullptr)
+		{
+			return m_pages[pageIndex]->data();
+		}
+
+		return nullptr;
+	}
+
 	uint8_t GetByte(const uint64_t byteIndex) const
 	{
-		auto iter = m_modifiedBytes.find(byteIndex);
-		if (iter != m_modifiedBytes.cend())
+		const uint8_t* pPage = GetPageData(byteIndex / PAGE_SIZE);
+		if (pPage != nullptr)
 		{
-			return iter->second;
+			return pPage[byteIndex % PAGE_SIZE];
 		}
 		else if (byteIndex < m_mmap.size())
 		{
@@ -195,20 +298,36 @@ private:
 		return 0;
 	}
 
-	uint64_t GetNumBytes() const
+	std::vector<uint8_t>& GetWritablePage(const uint64_t pageIndex)
 	{
-		size_t size = 0;
-		if (!m_modifiedBytes.empty())
+		SetDirty(true);
+
+		if (pageIndex >= m_pages.size())
 		{
-			size = m_modifiedBytes.crbegin()->first + 1;
+			m_pages.resize(pageIndex + 1);
 		}
 
-		if (!m_mmap.empty())
+		if (m_pages[pageIndex] == nullptr)
 		{
-			size = (std::max)(size, m_mmap.size() + 1);
+			auto pPage = std::make_unique<std::vector<uint8_t>>(PAGE_SIZE, (uint8_t)0);
+
+			const uint64_t pageStart = pageIndex * PAGE_SIZE;
+			if (pageStart < m_mmap.size())
+			{
+				const uint64_t mappedEnd = (std::min)(pageStart + PAGE_SIZE, (uint64_t)m_mmap.size());
+				std::copy(m_mmap.cbegin() + pageStart, m_mmap.cbegin() + mappedEnd, pPage->begin());
+			}
+
+			m_pages[pageIndex] = std::move(pPage);
 		}
 
-		return size;
+		return *m_pages[pageIndex];
+	}
+
+	uint8_t& GetWritableByte(const uint64_t byteIndex)
+	{
+		m_numBytes = (std::max)(m_numBytes, byteIndex + 1);
+		return GetWritablePage(byteIndex / PAGE_SIZE)[byteIndex % PAGE_SIZE];
 	}
 
 	// Returns a byte with the given bit (0-7) set.
@@ -218,17 +337,15 @@ private:
 		return 1 << (7 - bit);
 	}
 
-	bool IsBitSet(const uint8_t byte, const uint64_t position) const
-	{
-		const uint8_t bitPosition = (uint8_t)position % 8;
-
-		return (byte >> (7 - bitPosition)) & 1;
-	}
-
 	fs::path m_path;
-	std::map<uint64_t, uint8_t> m_modifiedBytes;
 	mio::mmap_source m_mmap;
-	uint64_t m_size;
+	uint64_t m_fileSize;
+
+	// Logical size of the bitmap in bytes, including uncommitted writes past the end of the file.
+	uint64_t m_numBytes;
+
+	// Modified pages, indexed by page number. nullptr for pages that are unchanged from the mmap.
+	std::vector<std::unique_ptr<std::vector<uint8_t>>> m_pages;
 
 	static const bool s_true{ false };
 	static const bool s_false{ false };
@@ -59,15 +59,29 @@ public:
 		return m_pFile->GetSize() / NUM_BYTES;
 	}
 
-	std::vector<unsigned char> GetDataAt(const uint64_t position) const
+	//
+	// Returns a pointer to the NUM_BYTES bytes at the given position, read directly from the underlying file.
+	// The pointer is only valid until the next AddData, Commit, Rollback or Rewind.
+	//
+	const unsigned char* GetDataPtrAt(const uint64_t position) const
 	{
-		std::vector<unsigned char> data;
-		if (!m_pFile->Read(position * NUM_BYTES, NUM_BYTES, data))
+		const unsigned char* pData = m_pFile->Read(position * NUM_BYTES, NUM_BYTES);
+		if (pData == nullptr)
 		{
 			throw FILE_EXCEPTION(StringUtil::Format("Failed to read data at position {}", position));
 		}
 
-		return data;
+		return pData;
+	}
+
+	//
+	// Returns a pointer to numElements consecutive elements, starting at the given position, read directly from the underlying file.
+	// Returns nullptr if they aren't contiguous in memory, which only happens when they straddle the position a batch rewound to.
+	// The pointer is only valid until the next AddData, Commit, Rollback or Rewind.
+	//
+	const unsigned char* GetDataPtrRange(const uint64_t position, const uint64_t numElements) const
+	{
+		return m_pFile->Read(position * NUM_BYTES, numElements * NUM_BYTES);
 	}
 
 	void AddData(const std::vector<unsigned char>& data)
@@ -79,7 +93,7 @@ public:
 	void AddData(const CBigInteger<NUM_BYTES>& data)
 	{
 		SetDirty(true);
-		m_pFile->Append(data.GetData());
+		m_pFile->Append(data.data(), NUM_BYTES);
 	}
 
 private:
@@ -3,6 +3,8 @@
 #include <Core/Models/OutputIdentifier.h>
 #include <Core/Models/OutputLocation.h>
 #include <Crypto/RangeProof.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
 
 class OutputDTO
 {
@@ -24,6 +26,27 @@ public:
 	const OutputIdentifier& GetIdentifier() const { return m_identifier; }
 	const OutputLocation& GetLocation() const { return m_location; }
 	const RangeProof& GetRangeProof() const { return m_rangeProof; }
+
+	//
+	// Serialization/Deserialization
+	//
+	void Serialize(Serializer& serializer) const
+	{
+		serializer.Append<uint8_t>(m_spent ? 1 : 0);
+		m_identifier.Serialize(serializer);
+		m_location.Serialize(serializer);
+		m_rangeProof.Serialize(serializer);
+	}
+
+	static OutputDTO Deserialize(ByteBuffer& byteBuffer)
+	{
+		const bool spent = byteBuffer.ReadU8() == 1;
+		OutputIdentifier identifier = OutputIdentifier::Deserialize(byteBuffer);
+		OutputLocation location = OutputLocation::Deserialize(byteBuffer);
+		RangeProof rangeProof = RangeProof::Deserialize(byteBuffer);
+
+		return OutputDTO(spent, identifier, location, rangeProof);
+	}
 	
 private:
 	bool m_spent;
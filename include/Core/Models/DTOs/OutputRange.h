@@ -1,6 +1,10 @@
 #pragma once
 
 #include <Core/Models/DTOs/OutputDTO.h>
+#include <Core/Exceptions/DeserializationException.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <vector>
 
 class OutputRange
 {
@@ -15,6 +19,45 @@ public:
 	uint64_t GetLastRetrievedIndex() const { return m_lastRetrievedIndex; }
 	const std::vector<OutputDTO>& GetOutputs() const { return m_outputs; }
 
+	//
+	// Serialization/Deserialization
+	//
+	// This is the binary format used to transfer outputs in bulk (e.g. for wallet restores):
+	// the highest and last retrieved indices, followed by the number of outputs and the outputs themselves.
+	// Each output's rangeproof is prefixed with its length.
+	//
+	void Serialize(Serializer& serializer) const
+	{
+		serializer.Append<uint64_t>(m_highestIndex);
+		serializer.Append<uint64_t>(m_lastRetrievedIndex);
+		serializer.Append<uint64_t>(m_outputs.size());
+		for (const OutputDTO& output : m_outputs)
+		{
+			output.Serialize(serializer);
+		}
+	}
+
+	static OutputRange Deserialize(ByteBuffer& byteBuffer)
+	{
+		const uint64_t highestIndex = byteBuffer.ReadU64();
+		const uint64_t lastRetrievedIndex = byteBuffer.ReadU64();
+
+		const uint64_t numOutputs = byteBuffer.ReadU64();
+		if (numOutputs > byteBuffer.GetRemainingSize())
+		{
+			throw DESERIALIZATION_EXCEPTION();
+		}
+
+		std::vector<OutputDTO> outputs;
+		outputs.reserve(numOutputs);
+		for (uint64_t i = 0; i < numOutputs; i++)
+		{
+			outputs.emplace_back(OutputDTO::Deserialize(byteBuffer));
+		}
+
+		return OutputRange(highestIndex, lastRetrievedIndex, std::move(outputs));
+	}
+
 private:
 	uint64_t m_highestIndex;
 	uint64_t m_lastRetrievedIndex;
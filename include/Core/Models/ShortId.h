@@ -32,6 +32,7 @@ public:
 	ShortId& operator=(const ShortId& other) = default;
 	ShortId& operator=(ShortId&& other) noexcept = default;
 	bool operator<(const ShortId& shortId) const { return m_id < shortId.m_id; }
+	bool operator==(const ShortId& shortId) const { return m_id == shortId.m_id; }
 
 	//
 	// Getters
@@ -59,4 +60,17 @@ static struct
 	{
 		return a.GetHash() < b.GetHash();
 	}
-} SortShortIdsByHash;
\ No newline at end of file
+} SortShortIdsByHash;
+
+namespace std
+{
+	template<>
+	struct hash<ShortId>
+	{
+		size_t operator()(const ShortId& shortId) const
+		{
+			const CBigInteger<6>& id = shortId.GetId();
+			return BitUtil::ConvertToU64(0, 0, id[0], id[1], id[2], id[3], id[4], id[5]);
+		}
+	};
+}
\ No newline at end of file
@@ -19,13 +19,23 @@ class ByteBuffer
 {
 public:
 	ByteBuffer(const std::vector<unsigned char>& bytes)
-		: m_index(0), m_bytes(bytes)
+		: m_index(0), m_pBytes(bytes.data()), m_size(bytes.size())
 	{
 
 	}
 
 	ByteBuffer(std::vector<unsigned char>&& bytes)
-		: m_index(0), m_bytes(std::move(bytes))
+		: m_index(0), m_pBytes(bytes.data()), m_size(bytes.size())
+	{
+
+	}
+
+	//
+	// Reads directly from the given memory without copying it.
+	// The caller must keep the memory alive for as long as the ByteBuffer is used.
+	//
+	ByteBuffer(const unsigned char* pBytes, const size_t size)
+		: m_index(0), m_pBytes(pBytes), m_size(size)
 	{
 
 	}
@@ -33,20 +43,20 @@ public:
 	template<class T>
 	void ReadBigEndian(T& t)
 	{
-		if (m_index + sizeof(T) > m_bytes.size())
+		if (m_index + sizeof(T) > m_size)
 		{
 			throw DESERIALIZATION_EXCEPTION();
 		}
 
 		if (EndianHelper::IsBigEndian())
 		{
-			memcpy(&t, &m_bytes[m_index], sizeof(T));
+			memcpy(&t, m_pBytes + m_index, sizeof(T));
 		}
 		else
 		{
 			std::vector<unsigned char> temp;
 			temp.resize(sizeof(T));
-			std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
+			std::reverse_copy(m_pBytes + m_index, m_pBytes + m_index + sizeof(T), temp.begin());
 			memcpy(&t, &temp[0], sizeof(T));
 		}
 
@@ -56,7 +66,7 @@ public:
 	template<class T>
 	void ReadLittleEndian(T& t)
 	{
-		if (m_index + sizeof(T) > m_bytes.size())
+		if (m_index + sizeof(T) > m_size)
 		{
 			throw DESERIALIZATION_EXCEPTION();
 		}
@@ -65,12 +75,12 @@ public:
 		{
 			std::vector<unsigned char> temp;
 			temp.resize(sizeof(T));
-			std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
+			std::reverse_copy(m_pBytes + m_index, m_pBytes + m_index + sizeof(T), temp.begin());
 			memcpy(&t, &temp[0], sizeof(T));
 		}
 		else
 		{
-			memcpy(&t, &m_bytes[m_index], sizeof(T));
+			memcpy(&t, m_pBytes + m_index, sizeof(T));
 		}
 
 		m_index += sizeof(T);
@@ -156,35 +166,34 @@ public:
 			return "";
 		}
 
-		if (m_index + stringLength > m_bytes.size())
+		if (m_index + stringLength > m_size)
 		{
 			throw DESERIALIZATION_EXCEPTION();
 		}
 
-		std::vector<unsigned char> temp(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + stringLength);
+		std::string str((const char*)m_pBytes + m_index, stringLength);
 		m_index += stringLength;
 
-		return std::string((char*)&temp[0], stringLength);
+		return str;
 	}
 
 	template<size_t NUM_BYTES>
 	CBigInteger<NUM_BYTES> ReadBigInteger()
 	{
-		if (m_index + NUM_BYTES > m_bytes.size())
+		if (m_index + NUM_BYTES > m_size)
 		{
 			throw DESERIALIZATION_EXCEPTION();
 		}
 
-		std::vector<unsigned char> data(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + NUM_BYTES);
-
+		const size_t index = m_index;
 		m_index += NUM_BYTES;
 
-		return CBigInteger<NUM_BYTES>(std::move(data));
+		return CBigInteger<NUM_BYTES>(m_pBytes + index);
 	}
 
 	std::vector<unsigned char> ReadVector(const uint64_t numBytes)
 	{
-		if (m_index + numBytes > m_bytes.size())
+		if (m_index + numBytes > m_size)
 		{
 			throw DESERIALIZATION_EXCEPTION();
 		}
@@ -192,15 +201,16 @@ public:
 		const size_t index = m_index;
 		m_index += numBytes;
 
-		return std::vector<unsigned char>(m_bytes.cbegin() + index, m_bytes.cbegin() + index + numBytes);
+		return std::vector<unsigned char>(m_pBytes + index, m_pBytes + index + numBytes);
 	}
 
 	size_t GetRemainingSize() const
 	{
-		return m_bytes.size() - m_index;
+		return m_size - m_index;
 	}
 
 private:
 	size_t m_index;
-	const std::vector<unsigned char>& m_bytes;
+	const unsigned char* m_pBytes;
+	size_t m_size;
 };
@@ -18,6 +18,13 @@ public:
 		m_serialized.reserve(expectedSize);
 	}
 
+	// Serializes into the given buffer's storage (e.g. a recycled buffer), discarding its contents but keeping its capacity.
+	explicit Serializer(std::vector<unsigned char>&& buffer)
+		: m_serialized(std::move(buffer))
+	{
+		m_serialized.clear();
+	}
+
 	template <class T>
 	void Append(const T& t)
 	{
@@ -69,13 +76,41 @@ public:
 	template<size_t NUM_BYTES>
 	void AppendBigInteger(const CBigInteger<NUM_BYTES>& bigInteger)
 	{
-		const std::vector<unsigned char>& data = bigInteger.GetData();
-		//std::reverse(data.begin(), data.end());
-		m_serialized.insert(m_serialized.end(), data.cbegin(), data.cend());
+		m_serialized.insert(m_serialized.end(), bigInteger.begin(), bigInteger.end());
 	}
 
+	//
+	// Overwrites sizeof(T) bytes at the given offset, which must already have been appended (e.g. to back-patch a length).
+	//
+	template <class T>
+	void Overwrite(const size_t offset, const T& t)
+	{
+		unsigned char temp[sizeof(T)];
+		memcpy(&temp[0], &t, sizeof(T));
+
+		if (EndianHelper::IsBigEndian())
+		{
+			std::copy(temp, temp + sizeof(T), m_serialized.begin() + offset);
+		}
+		else
+		{
+			std::reverse_copy(temp, temp + sizeof(T), m_serialized.begin() + offset);
+		}
+	}
+
+	// Empties the serializer, but keeps its capacity so it can be reused without reallocating.
+	void Clear() { m_serialized.clear(); }
+
 	const std::vector<unsigned char>& GetBytes() const { return m_serialized; }
 
+	// Moves the serialized bytes out, leaving the serializer empty.
+	std::vector<unsigned char> TakeBytes()
+	{
+		std::vector<unsigned char> bytes;
+		bytes.swap(m_serialized);
+		return bytes;
+	}
+
 	const unsigned char* data() const { return m_serialized.data(); }
 	size_t size() const { return m_serialized.size(); }
 
@@ -2,6 +2,7 @@
 
 #include <Crypto/Crypto.h>
 #include <Core/Models/TransactionKernel.h>
+#include <Core/Validation/VerificationCache.h>
 #include <Infrastructure/Logger.h>
 
 class KernelSignatureValidator
@@ -9,21 +10,37 @@ class KernelSignatureValidator
 public:
 	// Verify the tx kernels.
 	// No ability to batch verify these right now so just do them individually.
-	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels)
+	// When useCache is true, kernels found in the VerificationCache are skipped, and newly verified kernels are added to it.
+	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels, const bool useCache = true)
 	{
+		std::vector<const TransactionKernel*> kernelsToVerify;
+		kernelsToVerify.reserve(kernels.size());
+		for (const TransactionKernel& kernel : kernels)
+		{
+			if (!useCache || !VerificationCache::GetInstance().IsKernelVerified(kernel))
+			{
+				kernelsToVerify.push_back(&kernel);
+			}
+		}
+
+		if (kernelsToVerify.empty())
+		{
+			return true;
+		}
+
 		std::vector<const Commitment*> commitments;
-		commitments.reserve(kernels.size());
+		commitments.reserve(kernelsToVerify.size());
 		std::vector<const Signature*> signatures;
-		signatures.reserve(kernels.size());
+		signatures.reserve(kernelsToVerify.size());
 		std::vector<Hash> msgs;
-		msgs.reserve(kernels.size());
+		msgs.reserve(kernelsToVerify.size());
 		std::vector<const Hash*> messages;
-		messages.reserve(kernels.size());
+		messages.reserve(kernelsToVerify.size());
 
 		// Verify the transaction proof validity. Entails handling the commitment as a public key and checking the signature verifies with the fee as message.
-		for (size_t i = 0; i < kernels.size(); i++)
+		for (size_t i = 0; i < kernelsToVerify.size(); i++)
 		{
-			const TransactionKernel& kernel = kernels[i];
+			const TransactionKernel& kernel = *kernelsToVerify[i];
 			commitments.push_back(&kernel.GetExcessCommitment());
 			signatures.push_back(&kernel.GetExcessSignature());
 			msgs.emplace_back(kernel.GetSignatureMessage());
@@ -37,6 +54,14 @@ public:
 			return false;
 		}
 
+		if (useCache)
+		{
+			for (const TransactionKernel* pKernel : kernelsToVerify)
+			{
+				VerificationCache::GetInstance().MarkKernelVerified(*pKernel);
+			}
+		}
+
 		LOG_TRACE("Verify success");
 		return true;
 	}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Common/ShardedLRUCache.h>
+#include <Core/Models/TransactionKernel.h>
+#include <Crypto/Commitment.h>
+#include <Crypto/RangeProof.h>
+#include <Crypto/Hash.h>
+#include <utility>
+
+//
+// Remembers which range proofs and kernel signatures have already been verified, so transactions seen on arrival,
+// again during stem/fluff aggregation, and again in a block only pay for the expensive crypto once.
+// Range proofs are keyed by (commitment, proof hash) and kernels by kernel hash, so a different proof or signature
+// for an already-verified commitment is never mistaken for a verified one.
+//
+class VerificationCache
+{
+public:
+	static VerificationCache& GetInstance();
+
+	void SetCapacity(const size_t rangeProofCapacity, const size_t kernelCapacity);
+
+	bool IsRangeProofVerified(const Commitment& commitment, const RangeProof& rangeProof);
+	void MarkRangeProofVerified(const Commitment& commitment, const RangeProof& rangeProof);
+
+	bool IsKernelVerified(const TransactionKernel& kernel);
+	void MarkKernelVerified(const TransactionKernel& kernel);
+
+	uint64_t GetRangeProofHits() const { return m_rangeProofs.GetHits(); }
+	uint64_t GetRangeProofMisses() const { return m_rangeProofs.GetMisses(); }
+	uint64_t GetKernelHits() const { return m_kernels.GetHits(); }
+	uint64_t GetKernelMisses() const { return m_kernels.GetMisses(); }
+
+private:
+	VerificationCache();
+
+	typedef std::pair<Commitment, Hash> RangeProofKey;
+
+	struct RangeProofKeyHasher
+	{
+		size_t operator()(const RangeProofKey& key) const
+		{
+			return std::hash<Commitment>()(key.first) ^ std::hash<Hash>()(key.second);
+		}
+	};
+
+	static RangeProofKey GetKey(const Commitment& commitment, const RangeProof& rangeProof);
+
+	ShardedLRUCache<RangeProofKey, bool, RangeProofKeyHasher> m_rangeProofs;
+	ShardedLRUCache<Hash, bool> m_kernels;
+};
@@ -6,7 +6,10 @@
 
 #include <Core/Traits/Printable.h>
 #include <cstdint>
+#include <cstring>
+#include <array>
 #include <vector>
+#include <type_traits>
 #include <string>
 #include <stdexcept>
 #include <sstream>
@@ -15,33 +18,41 @@
 
 #pragma warning(disable: 4505)
 
+//
+// Fixed-size big-endian integer.
+// By default, the bytes are stored inline in a std::array, so values can be copied and compared without touching the heap.
+// When a custom allocator is provided (e.g. for secure types), the bytes are instead stored in a std::vector using that allocator.
+//
 template<size_t NUM_BYTES, class ALLOC = std::allocator<unsigned char>>
 class CBigInteger : public Traits::IPrintable
 {
+	static constexpr bool IS_INLINE = std::is_same<ALLOC, std::allocator<unsigned char>>::value;
+	using STORAGE = typename std::conditional<IS_INLINE, std::array<unsigned char, NUM_BYTES>, std::vector<unsigned char, ALLOC>>::type;
+
 public:
 	//
 	// Constructors
 	//
 	CBigInteger()
-		: m_data(NUM_BYTES)
+		: m_data(CreateStorage())
 	{
 	}
 
 	CBigInteger(const std::vector<unsigned char, ALLOC>& data)
-		: m_data(data)
-	{
-
-	}
-
-	CBigInteger(std::vector<unsigned char, ALLOC>&& data)
-		: m_data(std::move(data))
+		: m_data(CreateStorage())
 	{
+		if (data.size() != NUM_BYTES)
+		{
+			throw std::invalid_argument("Expected " + std::to_string(NUM_BYTES) + " bytes, but received " + std::to_string(data.size()));
+		}
 
+		std::copy(data.cbegin(), data.cend(), m_data.begin());
 	}
 
 	CBigInteger(const unsigned char* data)
-		: m_data(data, data + NUM_BYTES)
+		: m_data(CreateStorage())
 	{
+		std::copy(data, data + NUM_BYTES, m_data.begin());
 	}
 
 	CBigInteger(const CBigInteger& bigInteger) = default;
@@ -60,45 +71,50 @@ public:
 		}
 	}
 
-	inline const std::vector<unsigned char, ALLOC>& GetData() const
+	//
+	// Returns a copy of the bytes.
+	// Prefer data()/size() or begin()/end() to avoid the allocation.
+	//
+	inline std::vector<unsigned char, ALLOC> GetData() const
 	{
-		return m_data;
+		return std::vector<unsigned char, ALLOC>(m_data.cbegin(), m_data.cend());
 	}
 
 	static CBigInteger<NUM_BYTES, ALLOC> ValueOf(const unsigned char value)
 	{
-		std::vector<unsigned char, ALLOC> data(NUM_BYTES);
-		data[NUM_BYTES - 1] = value;
-		return CBigInteger<NUM_BYTES, ALLOC>(std::move(data));
+		CBigInteger<NUM_BYTES, ALLOC> result;
+		result[NUM_BYTES - 1] = value;
+		return result;
 	}
 
 	static CBigInteger<NUM_BYTES, ALLOC> FromHex(const std::string& hex);
 
 	static CBigInteger<NUM_BYTES, ALLOC> GetMaximumValue()
 	{
-		std::vector<unsigned char, ALLOC> data(NUM_BYTES);
-		for (int i = 0; i < NUM_BYTES; i++)
-		{
-			data[i] = 0xFF;
-		}
-
-		return CBigInteger<NUM_BYTES, ALLOC>(&data[0]);
+		CBigInteger<NUM_BYTES, ALLOC> result;
+		std::fill(result.m_data.begin(), result.m_data.end(), (unsigned char)0xFF);
+		return result;
 	}
 
-	inline size_t size() const { return NUM_BYTES; }
+	static constexpr size_t size() { return NUM_BYTES; }
 	inline unsigned char* data() { return m_data.data(); }
 	inline const unsigned char* data() const { return m_data.data(); }
+	inline const unsigned char* begin() const { return m_data.data(); }
+	inline const unsigned char* end() const { return m_data.data() + NUM_BYTES; }
 
-	const unsigned char* ToCharArray() const { return &m_data[0]; }
+	const unsigned char* ToCharArray() const { return m_data.data(); }
 	std::string ToHex() const
 	{
-		std::ostringstream stream;
-		for (const unsigned char byte : m_data)
+		static const char* HEX_CHARS = "0123456789abcdef";
+
+		std::string hex(NUM_BYTES * 2, '0');
+		for (size_t i = 0; i < NUM_BYTES; i++)
 		{
-			stream << std::hex << std::setfill('0') << std::setw(2) << std::nouppercase << (int)byte;
+			hex[2 * i] = HEX_CHARS[m_data[i] >> 4];
+			hex[(2 * i) + 1] = HEX_CHARS[m_data[i] & 0x0F];
 		}
 
-		return stream.str();
+		return hex;
 	}
 	virtual std::string Format() const override final { return ToHex(); }
 
@@ -126,23 +142,7 @@ public:
 
 	inline bool operator<(const CBigInteger& rhs) const
 	{
-		if (this == &rhs)
-		{
-			return false;
-		}
-
-		auto rhsIter = rhs.m_data.cbegin();
-		for (auto iter = this->m_data.cbegin(); iter != this->m_data.cend(); iter++)
-		{
-			if (*rhsIter != *iter)
-			{
-				return *iter < *rhsIter;
-			}
-
-			rhsIter++;
-		}
-
-		return false;
+		return std::memcmp(m_data.data(), rhs.m_data.data(), NUM_BYTES) < 0;
 	}
 
 	inline bool operator>(const CBigInteger& rhs) const
@@ -152,20 +152,7 @@ public:
 
 	inline bool operator==(const CBigInteger& rhs) const
 	{
-		if (this == &rhs)
-		{
-			return true;
-		}
-
-		for (size_t i = 0; i < NUM_BYTES; i++)
-		{
-			if (this->m_data[i] != rhs.m_data[i])
-			{
-				return false;
-			}
-		}
-
-		return true;
+		return std::memcmp(m_data.data(), rhs.m_data.data(), NUM_BYTES) == 0;
 	}
 
 	inline bool operator!=(const CBigInteger& rhs) const
@@ -175,12 +162,12 @@ public:
 
 	inline bool operator<=(const CBigInteger& rhs) const
 	{
-		return *this < rhs || *this == rhs;
+		return !(rhs < *this);
 	}
 
 	inline bool operator>=(const CBigInteger& rhs) const
 	{
-		return *this > rhs || *this == rhs;
+		return !(*this < rhs);
 	}
 
 	inline CBigInteger operator^=(const CBigInteger& rhs)
@@ -191,7 +178,19 @@ public:
 	}
 
 private:
-	std::vector<unsigned char, ALLOC> m_data;
+	static STORAGE CreateStorage()
+	{
+		if constexpr (IS_INLINE)
+		{
+			return STORAGE{};
+		}
+		else
+		{
+			return STORAGE(NUM_BYTES);
+		}
+	}
+
+	STORAGE m_data;
 };
 
 static inline unsigned char FromHexChar(const char value)
@@ -232,13 +231,13 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::FromHex(const std::
 		throw std::exception();
 	}
 
-	std::vector<unsigned char, ALLOC> data(NUM_BYTES);
+	CBigInteger<NUM_BYTES, ALLOC> result;
 	for (size_t i = 0; i < hexNoSpaces.length(); i += 2)
 	{
-		data[i / 2] = (FromHexChar(hexNoSpaces[i]) * 16 + FromHexChar(hexNoSpaces[i + 1]));
+		result[i / 2] = (FromHexChar(hexNoSpaces[i]) * 16 + FromHexChar(hexNoSpaces[i + 1]));
 	}
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&data[0]);
+	return result;
 }
 
 #ifdef INCLUDE_TEST_MATH
@@ -246,7 +245,7 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::FromHex(const std::
 template<size_t NUM_BYTES, class ALLOC>
 CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const int divisor) const
 {
-	std::vector<unsigned char, ALLOC> quotient(NUM_BYTES);
+	CBigInteger<NUM_BYTES, ALLOC> quotient;
 
 	int remainder = 0;
 	for (int i = 0; i < NUM_BYTES; i++)
@@ -256,7 +255,7 @@ CBigInteger<NUM_BYTES, ALLOC> CBigInteger<NUM_BYTES, ALLOC>::operator/(const int
 		remainder -= quotient[i] * divisor;
 	}
 
-	return CBigInteger<NUM_BYTES, ALLOC>(&quotient[0]);
+	return quotient;
 }
 
 #endif
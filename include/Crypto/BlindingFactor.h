@@ -46,7 +46,7 @@ public:
 	// Getters
 	//
 	inline const CBigInteger<32>& GetBytes() const { return m_blindingFactorBytes; }
-	inline const std::vector<unsigned char>& GetVec() const { return m_blindingFactorBytes.GetData(); }
+	inline std::vector<unsigned char> GetVec() const { return m_blindingFactorBytes.GetData(); }
 	inline const unsigned char* data() const { return m_blindingFactorBytes.data(); }
 
 	//
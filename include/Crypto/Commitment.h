@@ -48,7 +48,7 @@ public:
 	// Getters
 	//
 	inline const CBigInteger<33>& GetBytes() const { return m_commitmentBytes; }
-	inline const std::vector<unsigned char>& GetVec() const { return m_commitmentBytes.GetData(); }
+	inline std::vector<unsigned char> GetVec() const { return m_commitmentBytes.GetData(); }
 	inline const unsigned char* data() const { return m_commitmentBytes.data(); }
 
 	//
@@ -86,7 +86,7 @@ namespace std
 	{
 		size_t operator()(const Commitment& commitment) const
 		{
-			const std::vector<unsigned char>& bytes = commitment.GetVec();
+			const CBigInteger<33>& bytes = commitment.GetBytes();
 			return BitUtil::ConvertToU64(bytes[0], bytes[4], bytes[8], bytes[12], bytes[16], bytes[20], bytes[24], bytes[28]);
 		}
 	};
@@ -38,7 +38,7 @@ public:
 
 	std::vector<uint32_t> ToKeyIndices(const EBulletproofType& bulletproofType) const
 	{
-		ByteBuffer byteBuffer(m_proofMessageBytes.GetData());
+		ByteBuffer byteBuffer(m_proofMessageBytes.data(), m_proofMessageBytes.size());
 
 		size_t length = 3;
 		if (bulletproofType == EBulletproofType::ENHANCED)
@@ -3,6 +3,7 @@
 #include <Crypto/SecretKey.h>
 #include <Crypto/ProofMessage.h>
 #include <stdint.h>
+#include <memory>
 
 class RewoundProof
 {
@@ -20,7 +20,7 @@ public:
 	}
 
 	inline const CBigInteger<NUM_BYTES>& GetBytes() const { return m_seed; }
-	inline const std::vector<unsigned char>& GetVec() const { return m_seed.GetData(); }
+	inline std::vector<unsigned char> GetVec() const { return m_seed.GetData(); }
 
 	inline const unsigned char* data() const { return m_seed.data(); }
 	inline size_t size() const { return m_seed.size(); }
@@ -8,6 +8,8 @@
 #include <Core/Models/OutputLocation.h>
 #include <Core/Traits/Batchable.h>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class IBlockDB : public Traits::IBatchable
 {
@@ -28,6 +30,13 @@ public:
 	virtual void AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location) = 0;
 	virtual std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const = 0;
 
+	//
+	// Adds or looks up the positions of many outputs at once, in a single batch.
+	// GetOutputPositions returns the position of each output in the same order as the commitments, or nullptr for any that aren't found.
+	//
+	virtual void AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>& outputPositions) = 0;
+	virtual std::vector<std::unique_ptr<OutputLocation>> GetOutputPositions(const std::vector<Commitment>& outputCommitments) const = 0;
+
 	virtual void AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap) = 0;
 	virtual std::unique_ptr<Roaring> GetBlockInputBitmap(const Hash& blockHash) const = 0;
 };
\ No newline at end of file
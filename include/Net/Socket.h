@@ -6,17 +6,36 @@
 
 #include <inttypes.h>
 #include <vector>
+#include <deque>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
 #include <asio.hpp>
 
-class Socket : public Traits::IPrintable
+//
+// A TCP socket whose reads and writes are performed on the io_context it was connected or accepted on.
+//
+// Send queues the bytes to be written asynchronously, so any thread may send without interleaving messages.
+// Everything queued while a write is in progress is written together by the next one, using a single gathering write.
+// Receive and HasReceivedData are synchronous, and must not be used while an AsyncReceive is outstanding.
+//
+class Socket : public Traits::IPrintable, public std::enable_shared_from_this<Socket>
 {
 public:
 	Socket(const SocketAddress& address);
 	virtual ~Socket();
 
+	//
+	// Connects to the socket's address. The given context must be running on other threads.
+	//
 	bool Connect(std::shared_ptr<asio::io_context> pContext);
+
+	//
+	// Accepts the next connection on the acceptor, running the acceptor's context until one arrives.
+	// The socket is bound to the given context, which need not be the acceptor's.
+	//
 	bool Accept(std::shared_ptr<asio::io_context> pContext, asio::ip::tcp::acceptor& acceptor, const std::atomic_bool& terminate);
 
 	bool CloseSocket();
@@ -42,23 +61,79 @@ public:
 	bool SetBlocking(const bool blocking);
 	inline bool IsBlocking() const { return m_blocking; }
 
+	//
+	// Queues the message to be written, waiting up to the send timeout for the queue to drain below MAX_BYTES_QUEUED.
+	// Returns false if the queue didn't drain in time, and throws a SocketException if an earlier write failed.
+	//
 	bool Send(const std::vector<unsigned char>& message, const bool incrementCount);
 
+	//
+	// Same as Send, but for a buffer containing numMessages serialized messages, which is moved into the send queue.
+	// The caller is responsible for counting the messages in the RateCounter.
+	//
+	bool SendBatch(std::vector<unsigned char>&& bytes, const size_t numMessages);
+
+	//
+	// Returns an empty buffer to serialize the next batch into.
+	// Once a batch has been written, its buffer is kept (up to MAX_SPARE_BUFFER_CAPACITY) to be handed out again here,
+	// so a connection that keeps sending batches doesn't reallocate one for every flush.
+	//
+	std::vector<unsigned char> TakeSpareBuffer();
+
+	// The number of messages, and the number of bytes, that have been queued but not yet written.
+	size_t GetMessagesQueued() const;
+	size_t GetBytesQueued() const;
+
 	bool HasReceivedData();
 	bool Receive(const size_t numBytes, const bool incrementCount, std::vector<unsigned char>& data);
 
+	//
+	// Reads exactly numBytes, then calls the callback from the socket's context.
+	//
+	typedef std::function<void(const asio::error_code&, std::vector<unsigned char>&&)> ReceiveCallback;
+	void AsyncReceive(const size_t numBytes, const bool incrementCount, ReceiveCallback callback);
+
 private:
+	static const size_t MAX_BYTES_QUEUED = 8 * 1024 * 1024;
+	static const size_t MAX_BUFFERS_PER_WRITE = 64;
+	static const size_t MAX_SPARE_BUFFER_CAPACITY = 1024 * 1024;
+
+	struct QueuedWrite
+	{
+		std::vector<unsigned char> bytes;
+		size_t numMessages;
+	};
+
+	void WriteNext();
+
+	//
+	// Records an error from a connect, read or write, which may be on the socket's context or the caller's thread.
+	// A real error is never replaced, so EAGAIN can't make a failed socket look active again.
+	//
+	void SetError(const asio::error_code& error);
+	asio::error_code GetError() const;
+
 	std::shared_ptr<asio::ip::tcp::socket> m_pSocket;
 	std::shared_ptr<asio::io_context> m_pContext;
-	asio::error_code m_errorCode;
+	std::unique_ptr<asio::io_context::strand> m_pStrand;
 
-	bool m_socketOpen;
+	std::atomic<bool> m_socketOpen;
 	SocketAddress m_address;
 	bool m_blocking;
 	unsigned long m_receiveTimeout;
 	unsigned long m_sendTimeout;
 	int m_receiveBufferSize;
 	RateCounter m_rateCounter;
+
+	mutable std::mutex m_sendMutex;
+	std::condition_variable m_sendCondition;
+	std::deque<QueuedWrite> m_sendQueue;
+	size_t m_bytesQueued;
+	size_t m_messagesQueued;
+	bool m_writing;
+	asio::error_code m_writeError;
+	asio::error_code m_errorCode;
+	std::vector<unsigned char> m_spareBuffer;
 };
 
 typedef std::shared_ptr<Socket> SocketPtr;
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <json/json.h>
 #include <string>
 #include <optional>
+#include <vector>
 
 class HTTPUtil
 {
@@ -93,6 +94,50 @@ public:
 		return std::nullopt;
 	}
 
+	// Checks whether an Accept-Encoding header value allows the given content coding, honoring q-values.
+	// Ex: "gzip, deflate;q=0.5" accepts "deflate", but "deflate;q=0" and "gzip, *;q=0" don't.
+	static bool AcceptsEncoding(const std::string& acceptEncoding, const std::string& encoding)
+	{
+		std::optional<bool> wildcardOpt = std::nullopt;
+		for (const std::string& element : StringUtil::Split(acceptEncoding, ","))
+		{
+			const std::vector<std::string> params = StringUtil::Split(element, ";");
+			if (params.empty())
+			{
+				continue;
+			}
+
+			double qValue = 1.0;
+			for (size_t i = 1; i < params.size(); i++)
+			{
+				const std::vector<std::string> keyValue = StringUtil::Split(params[i], "=");
+				if (keyValue.size() == 2 && StringUtil::ToLower(StringUtil::Trim(keyValue[0])) == "q")
+				{
+					try
+					{
+						qValue = std::stod(StringUtil::Trim(keyValue[1]));
+					}
+					catch (const std::exception&)
+					{
+						qValue = 0.0;
+					}
+				}
+			}
+
+			const std::string coding = StringUtil::ToLower(StringUtil::Trim(params[0]));
+			if (coding == StringUtil::ToLower(encoding))
+			{
+				return qValue > 0.0;
+			}
+			else if (coding == "*")
+			{
+				wildcardOpt = std::make_optional(qValue > 0.0);
+			}
+		}
+
+		return wildcardOpt.value_or(false);
+	}
+
 	static HTTP::EHTTPMethod GetHTTPMethod(struct mg_connection* conn)
 	{
 		const struct mg_request_info* req_info = mg_get_request_info(conn);
@@ -169,6 +214,24 @@ public:
 		return 200;
 	}
 
+	static int BuildSuccessResponseBinary(struct mg_connection* conn, const std::vector<unsigned char>& response, const std::string& contentEncoding = "")
+	{
+		const std::string encodingHeader = contentEncoding.empty() ? "" : "Content-Encoding: " + contentEncoding + "\r\n";
+
+		mg_printf(conn,
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Length: %lu\r\n"
+			"Content-Type: application/octet-stream\r\n"
+			"%s"
+			"Connection: close\r\n\r\n",
+			(unsigned long)response.size(),
+			encodingHeader.c_str());
+
+		mg_write(conn, response.data(), response.size());
+
+		return 200;
+	}
+
 	static int BuildBadRequestResponse(struct mg_connection* conn, const std::string& response)
 	{
 		unsigned long len = (unsigned long)response.size();
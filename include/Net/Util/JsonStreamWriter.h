@@ -0,0 +1,144 @@
+#pragma once
+
+#include "civetweb/include/civetweb.h"
+
+#include <json/json.h>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//
+// Writes a compact JSON response straight to the connection using chunked transfer encoding.
+//
+// Large responses can be written one element at a time, so the whole document never has to be built as a Json::Value,
+// or formatted into a single string, before it's sent. Output is buffered and sent in chunks of about CHUNK_SIZE bytes.
+//
+// The 200 response header is sent on construction, so any errors must be detected before creating the writer.
+// Finish() must be called once the outermost object or array is ended.
+//
+// Example: writer.BeginObject(); writer.Key("outputs"); writer.BeginArray(); writer.Value(outputJSON); ... writer.EndArray(); writer.EndObject(); return writer.Finish();
+//
+class JsonStreamWriter
+{
+	static const size_t CHUNK_SIZE = 64 * 1024;
+
+public:
+	JsonStreamWriter(struct mg_connection* pConnection)
+		: m_pConnection(pConnection), m_afterKey(false)
+	{
+		Json::StreamWriterBuilder builder;
+		builder["indentation"] = ""; // Removes whitespaces
+		m_pWriter = std::unique_ptr<Json::StreamWriter>(builder.newStreamWriter());
+
+		mg_printf(m_pConnection,
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: application/json\r\n"
+			"Transfer-Encoding: chunked\r\n"
+			"Connection: close\r\n\r\n");
+	}
+
+	void BeginObject()
+	{
+		WriteSeparator();
+		m_buffer << '{';
+		m_firstInScope.push_back(true);
+	}
+
+	void EndObject()
+	{
+		m_buffer << '}';
+		m_firstInScope.pop_back();
+		FlushIfFull();
+	}
+
+	void BeginArray()
+	{
+		WriteSeparator();
+		m_buffer << '[';
+		m_firstInScope.push_back(true);
+	}
+
+	void EndArray()
+	{
+		m_buffer << ']';
+		m_firstInScope.pop_back();
+		FlushIfFull();
+	}
+
+	void Key(const std::string& key)
+	{
+		WriteSeparator();
+		m_buffer << Json::valueToQuotedString(key.c_str()) << ':';
+		m_afterKey = true;
+	}
+
+	void Value(const Json::Value& value)
+	{
+		WriteSeparator();
+		m_pWriter->write(value, &m_buffer);
+		FlushIfFull();
+	}
+
+	void KeyValue(const std::string& key, const Json::Value& value)
+	{
+		Key(key);
+		Value(value);
+	}
+
+	int Finish()
+	{
+		Flush();
+
+		// A zero-length chunk terminates the response.
+		mg_send_chunk(m_pConnection, "", 0);
+
+		return 200;
+	}
+
+private:
+	void WriteSeparator()
+	{
+		if (m_afterKey)
+		{
+			m_afterKey = false;
+		}
+		else if (!m_firstInScope.empty())
+		{
+			if (!m_firstInScope.back())
+			{
+				m_buffer << ',';
+			}
+
+			m_firstInScope.back() = false;
+		}
+	}
+
+	void FlushIfFull()
+	{
+		if ((size_t)m_buffer.tellp() >= CHUNK_SIZE)
+		{
+			Flush();
+		}
+	}
+
+	void Flush()
+	{
+		const std::string chunk = m_buffer.str();
+		if (!chunk.empty())
+		{
+			mg_send_chunk(m_pConnection, chunk.c_str(), (unsigned int)chunk.size());
+		}
+
+		m_buffer.str("");
+		m_buffer.clear();
+	}
+
+	struct mg_connection* m_pConnection;
+	std::unique_ptr<Json::StreamWriter> m_pWriter;
+	std::ostringstream m_buffer;
+
+	// Whether nothing has been written yet in each open object/array, from outermost to innermost.
+	std::vector<bool> m_firstInScope;
+	bool m_afterKey;
+};
\ No newline at end of file
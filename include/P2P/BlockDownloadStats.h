@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Net/IPAddress.h>
+#include <stdint.h>
+#include <vector>
+
+//
+// A snapshot of the block download scheduler's view of a single peer.
+//
+struct BlockDownloadPeerStats
+{
+	IPAddress address;
+	size_t numInFlight;
+	size_t window;
+	uint64_t latencyMs;
+	double blocksPerSecond;
+	uint64_t blocksReceived;
+	uint64_t requestsTimedOut;
+	uint64_t requestsReassigned;
+};
+
+//
+// A snapshot of the block download scheduler, used to tune it while syncing blocks.
+//
+struct BlockDownloadStats
+{
+	size_t numInFlight;
+	uint64_t lowestRequested;
+	uint64_t highestRequested;
+	std::vector<BlockDownloadPeerStats> peers;
+};
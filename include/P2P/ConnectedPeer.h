@@ -8,12 +8,12 @@ class ConnectedPeer : public Traits::IPrintable
 {
 public:
 	ConnectedPeer(PeerPtr peer, const EDirection direction, const uint16_t portNumber)
-		: m_pPeer(peer), m_direction(direction), m_portNumber(portNumber), m_totalDifficulty(0), m_height(0)
+		: m_pPeer(peer), m_direction(direction), m_portNumber(portNumber), m_totalDifficulty(0), m_height(0), m_sendQueueDepth(0), m_bytesInFlight(0)
 	{
 
 	}
 	ConnectedPeer(const ConnectedPeer& peer)
-		: m_pPeer(peer.m_pPeer), m_direction(peer.m_direction), m_portNumber(peer.m_portNumber), m_totalDifficulty(peer.m_totalDifficulty.load()), m_height(peer.m_height.load())
+		: m_pPeer(peer.m_pPeer), m_direction(peer.m_direction), m_portNumber(peer.m_portNumber), m_totalDifficulty(peer.m_totalDifficulty.load()), m_height(peer.m_height.load()), m_sendQueueDepth(peer.m_sendQueueDepth), m_bytesInFlight(peer.m_bytesInFlight)
 	{
 
 	}
@@ -26,12 +26,23 @@ public:
 		m_height.exchange(height);
 	}
 
+	//
+	// Snapshots the connection's send queue, so the stats can be reported along with a copy of the ConnectedPeer.
+	//
+	void UpdateSendStats(const size_t sendQueueDepth, const size_t bytesInFlight)
+	{
+		m_sendQueueDepth = sendQueueDepth;
+		m_bytesInFlight = bytesInFlight;
+	}
+
 	PeerConstPtr GetPeer() const noexcept { return m_pPeer; }
 	PeerPtr GetPeer() noexcept { return m_pPeer; }
 	const EDirection GetDirection() const noexcept { return m_direction; }
 	uint16_t GetPort() const noexcept { return m_portNumber; }
 	uint64_t GetTotalDifficulty() const noexcept { return m_totalDifficulty.load(); }
 	uint64_t GetHeight() const noexcept { return m_height.load(); }
+	size_t GetSendQueueDepth() const noexcept { return m_sendQueueDepth; }
+	size_t GetBytesInFlight() const noexcept { return m_bytesInFlight; }
 
 	void UpdateVersion(const uint32_t version) { m_pPeer->UpdateVersion(version); }
 	void UpdateCapabilities(const Capabilities& capabilities) { m_pPeer->UpdateCapabilities(capabilities); }
@@ -46,5 +57,6 @@ private:
 	uint16_t m_portNumber;
 	std::atomic<uint64_t> m_totalDifficulty;
 	std::atomic<uint64_t> m_height;
-	// TODO: Add Connection Stats
+	size_t m_sendQueueDepth;
+	size_t m_bytesInFlight;
 };
\ No newline at end of file
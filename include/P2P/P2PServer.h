@@ -10,6 +10,7 @@
 #include <P2P/SyncStatus.h>
 #include <P2P/Peer.h>
 #include <P2P/ConnectedPeer.h>
+#include <P2P/BlockDownloadStats.h>
 #include <TxPool/TransactionPool.h>
 #include <Database/Database.h>
 #include <optional>
@@ -45,6 +46,11 @@ public:
 
 	virtual std::vector<ConnectedPeer> GetConnectedPeers() const = 0;
 
+	//
+	// Returns the state of the block download scheduler (the blocks in flight, and each peer's window, latency, and throughput).
+	//
+	virtual BlockDownloadStats GetBlockDownloadStats() const = 0;
+
 	virtual std::optional<PeerConstPtr> GetPeer(
 		const IPAddress& address
 	) const = 0;
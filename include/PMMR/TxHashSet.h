@@ -16,6 +16,7 @@ class OutputIdentifier;
 class IBlockChainServer;
 class IBlockDB;
 class Transaction;
+class TransactionInput;
 class SyncStatus;
 
 class ITxHashSet : public Traits::IBatchable
@@ -25,11 +26,13 @@ public:
 
 	//
 	// Validates all hashes, signatures, etc in the entire TxHashSet.
+	// If kernelsValidated is true, the kernel MMR was already validated while the TxHashSet was downloading, so it's skipped.
 	// This is typically only used during initial sync.
 	//
 	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(
 		const BlockHeader& header,
 		const IBlockChainServer& blockChainServer,
+		const bool kernelsValidated,
 		SyncStatus& syncStatus
 	) = 0;
 
@@ -60,6 +63,22 @@ public:
 		const Transaction& transaction
 	) const = 0;
 
+	//
+	// Returns true if the input spends a mature output that is in the current UTXO set. Otherwise, false.
+	//
+	virtual bool IsValidInput(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const TransactionInput& input
+	) const = 0;
+
+	//
+	// Returns true if no output with the given commitment exists in the current UTXO set. Otherwise, false.
+	//
+	virtual bool IsUniqueOutput(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const Commitment& commitment
+	) const = 0;
+
 	//
 	// Appends all new kernels, outputs, and rangeproofs to the MMRs, and prunes all of the inputs.
 	//
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <PMMR/TxHashSet.h>
+#include <Core/Models/BlockHeader.h>
+#include <memory>
+
+//
+// A TxHashSet zip that's extracted as it's downloaded.
+//
+// Each file is written to a staging directory as its bytes arrive, and the kernel MMR is validated (hashes, history and signatures)
+// in the background as soon as its files are complete, while the rest of the zip is still downloading.
+// The TxHashSet directory isn't touched until Install() is called, so a bad or abandoned download leaves the current TxHashSet intact.
+//
+class ITxHashSetDownload
+{
+public:
+	virtual ~ITxHashSetDownload() = default;
+
+	virtual BlockHeaderPtr GetHeader() const = 0;
+
+	//
+	// Extracts the next numBytes of the zip. Throws if the zip is malformed, contains an entry more than once, or can't be written.
+	//
+	virtual void Write(const unsigned char* pData, const size_t numBytes) = 0;
+
+	//
+	// Waits for the kernel MMR to be validated.
+	// Returns false if the zip was incomplete or the kernel MMR is invalid.
+	//
+	virtual bool Finish() = 0;
+
+	//
+	// Replaces the TxHashSet directory with the extracted files, and loads the TxHashSet rewound to the header.
+	// Finish() must have succeeded, and the current TxHashSet must be closed first.
+	// The kernel MMR doesn't need to be validated again, but the rest of the TxHashSet does.
+	//
+	virtual ITxHashSetPtr Install() = 0;
+};
+
+typedef std::shared_ptr<ITxHashSetDownload> ITxHashSetDownloadPtr;
@@ -2,10 +2,14 @@
 
 #include <Common/ImportExport.h>
 #include <PMMR/TxHashSet.h>
+#include <PMMR/TxHashSetDownload.h>
+#include <PMMR/TxHashSetZipFile.h>
 #include <Config/Config.h>
 #include <Database/BlockDb.h>
 #include <Core/Traits/Lockable.h>
 #include <filesystem.h>
+#include <future>
+#include <mutex>
 
 #ifdef MW_PMMR
 #define TXHASHSET_API EXPORT
@@ -17,7 +21,7 @@ class TXHASHSET_API TxHashSetManager
 {
 public:
 	TxHashSetManager(const Config& config);
-	~TxHashSetManager() = default;
+	~TxHashSetManager();
 
 	std::shared_ptr<Locked<ITxHashSet>> Open(BlockHeaderPtr pConfirmedTip);
 	void Close() { m_pTxHashSet.reset(); }
@@ -27,13 +31,47 @@ public:
 	void SetTxHashSet(ITxHashSetPtr pTxHashSet) { m_pTxHashSet = std::make_shared<Locked<ITxHashSet>>(Locked<ITxHashSet>(pTxHashSet)); }
 
 	static ITxHashSetPtr LoadFromZip(const Config& config, const fs::path& zipFilePath, BlockHeaderPtr pHeader);
-	bool SaveSnapshot(std::shared_ptr<const IBlockDB> pBlockDB, BlockHeaderPtr pHeader, const std::string& zipFilePath);
+
+	//
+	// Returns a download that extracts a TxHashSet zip into a staging directory as the zip's bytes arrive.
+	// The current TxHashSet is left alone until the download is installed.
+	//
+	static ITxHashSetDownloadPtr BeginDownload(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer);
+
+	//
+	// Loads a TxHashSet that was just extracted from a zip, rewinding it to the header.
+	//
+	static ITxHashSetPtr LoadExtracted(const Config& config, BlockHeaderPtr pHeader);
+
+	//
+	// Returns a zip of the TxHashSet as of the given block, or nullptr if it couldn't be created.
+	// The most recent snapshot is cached, so peers requesting the same block share one zip, which must not be modified.
+	// Peers requesting a block whose zip is still being written wait for that zip, rather than writing their own.
+	// The zip is removed once it's been replaced by a newer snapshot and the last reference to it is released.
+	// The block DB is only read while the TxHashSet is locked, so the caller doesn't need to hold any other lock.
+	//
+	TxHashSetZipFilePtr SaveSnapshot(std::shared_ptr<const IBlockDB> pBlockDB, BlockHeaderPtr pHeader);
+
+	//
+	// Must be called whenever the TxHashSet is rewound. Drops the cached snapshot if its block was rewound past,
+	// and keeps any snapshot that's being written from being cached.
+	//
+	void OnRewind(const BlockHeader& header);
 
 private:
+	TxHashSetZipFilePtr WriteSnapshot(std::shared_ptr<Locked<ITxHashSet>> pTxHashSet, const IBlockDB& blockDB, const BlockHeader& header, const uint64_t snapshotId);
+
 	const Config& m_config;
 	std::shared_ptr<Locked<ITxHashSet>> m_pTxHashSet;
 
-	// TODO: Needs mutex
+	// Only held while checking or updating the members below, never while a zip is written.
+	mutable std::mutex m_snapshotMutex;
+	BlockHeaderPtr m_pSnapshotHeader;
+	TxHashSetZipFilePtr m_pSnapshot;
+	Hash m_pendingHash;
+	std::shared_future<TxHashSetZipFilePtr> m_pendingSnapshot;
+	uint64_t m_nextSnapshotId;
+	uint64_t m_numRewinds;
 };
 
 typedef std::shared_ptr<TxHashSetManager> TxHashSetManagerPtr;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Common/Util/FileUtil.h>
+#include <memory>
+#include <string>
+
+//
+// A TxHashSet snapshot zip, shared by every peer it's being sent to.
+// The file is removed when the last reference is released, so replacing the cached snapshot
+// never removes (or fails to remove, on Windows) a zip that a peer is still reading.
+//
+class TxHashSetZipFile
+{
+public:
+	TxHashSetZipFile(const std::string& path) : m_path(path) { }
+	~TxHashSetZipFile() { FileUtil::RemoveFile(m_path); }
+
+	TxHashSetZipFile(const TxHashSetZipFile&) = delete;
+	TxHashSetZipFile& operator=(const TxHashSetZipFile&) = delete;
+
+	const std::string& GetPath() const { return m_path; }
+
+private:
+	std::string m_path;
+};
+
+typedef std::shared_ptr<const TxHashSetZipFile> TxHashSetZipFilePtr;
\ No newline at end of file
@@ -33,6 +33,22 @@ public:
 		const BlockHeader& previousHeader
 	) const;
 
+	//
+	// Validates the total difficulty and secondary scaling of the header against the headers before it.
+	// Returns true if they're valid. Together with IsCycleValid, this is the same as IsPoWValid.
+	//
+	bool IsDifficultyValid(
+		const BlockHeader& header,
+		const BlockHeader& previousHeader
+	) const;
+
+	//
+	// Validates the header's cuckoo cycle. This doesn't depend on any other header or the DB,
+	// so it can be checked for many headers in parallel, before the chain is locked.
+	// Returns true if the cycle is valid.
+	//
+	bool IsCycleValid(const BlockHeader& header) const;
+
 private:
 	const Config& m_config;
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
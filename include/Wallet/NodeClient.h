@@ -40,9 +40,17 @@ public:
 
 	//
 	// Returns a list of outputs starting at the given insertion index.
+	// Large ranges (e.g. for wallet restores) are fine, since the outputs are read sequentially from the PMMR.
 	//
 	virtual std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const = 0;
 
+	//
+	// Returns the serialized OutputRange (see OutputRange::Serialize) of the outputs starting at the given insertion index.
+	// The /v1/txhashset/outputs/bulk API returns the same serialization (after the cursor id), so a client of a remote node doesn't need to re-encode it.
+	// Returns an empty vector if the outputs aren't available.
+	//
+	virtual std::vector<unsigned char> GetOutputsBulk(const uint64_t startIndex, const uint64_t maxNumOutputs) const = 0;
+
 	//
 	// Posts the transaction to the P2P Network.
 	//
@@ -10,7 +10,7 @@ public:
 		std::vector<unsigned char> keyBytes;
 		keyBytes.reserve(33);
 		keyBytes.push_back(0);
-		keyBytes.insert(keyBytes.end(), privateKey.GetVec().cbegin(), privateKey.GetVec().cend());
+		keyBytes.insert(keyBytes.end(), privateKey.GetBytes().begin(), privateKey.GetBytes().end());
 		return PrivateExtKey(network, depth, parentFingerprint, childNumber, std::move(chainCode), CBigInteger<33>(std::move(keyBytes)), std::move(privateKey));
 	}
 
@@ -25,7 +25,7 @@ public:
 		SecretKey chainCode = byteBuffer.ReadBigInteger<32>();
 		CBigInteger<33> keyBytes = byteBuffer.ReadBigInteger<33>();
 
-		std::vector<unsigned char> privateKeyBytes(keyBytes.GetData().cbegin() + 1, keyBytes.GetData().cend());
+		std::vector<unsigned char> privateKeyBytes(keyBytes.begin() + 1, keyBytes.end());
 		SecretKey privateKey(std::move(privateKeyBytes));
 
 		return PrivateExtKey(network, depth, parentFingerprint, childNumber, std::move(chainCode), std::move(keyBytes), std::move(privateKey));
@@ -29,7 +29,8 @@ BlockChainServer::BlockChainServer(
 	m_pTxHashSetManager(pTxHashSetManager),
 	m_pTransactionPool(pTransactionPool),
 	m_pChainState(pChainState),
-	m_pHeaderMMR(pHeaderMMR)
+	m_pHeaderMMR(pHeaderMMR),
+	m_pHeaderValidationPool(std::make_shared<ThreadPool>("HEADER_VALIDATE", ThreadPool::GetDefaultNumThreads()))
 {
 
 }
@@ -41,9 +42,7 @@ std::shared_ptr<BlockChainServer> BlockChainServer::Create(
 	std::shared_ptr<ITransactionPool> pTransactionPool)
 {
 	const FullBlock& genesisBlock = config.GetEnvironment().GetGenesisBlock();
-	std::shared_ptr<BlockIndex> pGenesisIndex = std::make_shared<BlockIndex>(genesisBlock.GetHash(), 0);
-
-	std::shared_ptr<Locked<ChainStore>> pChainStore = ChainStore::Load(config, pGenesisIndex);
+	std::shared_ptr<Locked<ChainStore>> pChainStore = ChainStore::Load(config, genesisBlock.GetHash());
 	std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR = HeaderMMRAPI::OpenHeaderMMR(config);
 
 	std::shared_ptr<Locked<ChainState>> pChainState = ChainState::Create(
@@ -105,6 +104,21 @@ EBlockChainStatus BlockChainServer::AddBlock(const FullBlock& block)
 	}
 }
 
+bool BlockChainServer::VerifyBlockSelfConsistent(const FullBlock& block) const
+{
+	try
+	{
+		// The self-consistency checks don't use the block DB, so no lock is needed.
+		BlockValidator(nullptr, nullptr).VerifySelfConsistent(block);
+		return true;
+	}
+	catch (std::exception& e)
+	{
+		LOG_DEBUG_F("Block {} is not self-consistent: {}", block, e.what());
+		return false;
+	}
+}
+
 EBlockChainStatus BlockChainServer::AddCompactBlock(const CompactBlock& compactBlock)
 {
 	const Hash& hash = compactBlock.GetHash();
@@ -112,8 +126,8 @@ EBlockChainStatus BlockChainServer::AddCompactBlock(const CompactBlock& compactB
 
 	{
 		auto pReader = m_pChainState->Read();
-		auto pConfirmed = pReader->GetChainStore()->GetConfirmedChain()->GetByHeight(height);
-		if (pConfirmed != nullptr && pConfirmed->GetHash() == hash)
+		auto confirmedOpt = pReader->GetChainStore()->GetConfirmedChain()->GetByHeight(height);
+		if (confirmedOpt.has_value() && confirmedOpt->GetHash() == hash)
 		{
 			return EBlockChainStatus::ALREADY_EXISTS;
 		}
@@ -141,34 +155,32 @@ EBlockChainStatus BlockChainServer::AddCompactBlock(const CompactBlock& compactB
 	return EBlockChainStatus::TRANSACTIONS_MISSING;
 }
 
-std::string BlockChainServer::SnapshotTxHashSet(BlockHeaderPtr pBlockHeader)
+TxHashSetZipFilePtr BlockChainServer::SnapshotTxHashSet(BlockHeaderPtr pBlockHeader)
 {
-	auto pReader = m_pChainState->Read();
-	const uint64_t horizon = Consensus::GetHorizonHeight(pReader->GetHeight(EChainType::CONFIRMED));
-	if (pBlockHeader->GetHeight() < horizon)
+	std::shared_ptr<const IBlockDB> pBlockDB = nullptr;
+
 	{
-		throw BAD_DATA_EXCEPTION("TxHashSet snapshot requested beyond horizon.");
+		auto pReader = m_pChainState->Read();
+		const uint64_t horizon = Consensus::GetHorizonHeight(pReader->GetHeight(EChainType::CONFIRMED));
+		if (pBlockHeader->GetHeight() < horizon)
+		{
+			throw BAD_DATA_EXCEPTION("TxHashSet snapshot requested beyond horizon.");
+		}
+
+		pBlockDB = pReader->GetBlockDB().GetShared();
 	}
 
+	// The chain isn't held locked while the snapshot is written. The TxHashSet is read-locked instead, which keeps reorgs from rewinding it mid-write.
 	try
 	{
-		fs::path destination = fs::temp_directory_path() / "Snapshots";
-		destination /= StringUtil::Format(
-			"TxHashSet.{}.zip",
-			pBlockHeader->ShortHash()
-		);
-
-		if (m_pTxHashSetManager->SaveSnapshot(pReader->GetBlockDB().GetShared(), pBlockHeader, destination))
-		{
-			return destination;
-		}
+		return m_pTxHashSetManager->SaveSnapshot(pBlockDB, pBlockHeader);
 	}
 	catch (std::exception& e)
 	{
 		LOG_ERROR_F("TxHashSet snapshot failed with exception: {}", e.what());
 	}
 
-	return "";
+	return nullptr;
 }
 
 EBlockChainStatus BlockChainServer::ProcessTransactionHashSet(const Hash& blockHash, const std::string& path, SyncStatus& syncStatus)
@@ -189,6 +201,29 @@ EBlockChainStatus BlockChainServer::ProcessTransactionHashSet(const Hash& blockH
 	return EBlockChainStatus::INVALID;
 }
 
+ITxHashSetDownloadPtr BlockChainServer::BeginTxHashSetDownload(const Hash& blockHash)
+{
+	return TxHashSetProcessor(m_config, *this, m_pChainState).BeginDownload(blockHash);
+}
+
+EBlockChainStatus BlockChainServer::ProcessTxHashSetDownload(ITxHashSetDownloadPtr pDownload, SyncStatus& syncStatus)
+{
+	try
+	{
+		const bool success = TxHashSetProcessor(m_config, *this, m_pChainState).ProcessDownload(pDownload, syncStatus);
+		if (success)
+		{
+			return EBlockChainStatus::SUCCESS;
+		}
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to process TxHashSet: {}", e.what());
+	}
+
+	return EBlockChainStatus::INVALID;
+}
+
 EBlockChainStatus BlockChainServer::AddTransaction(TransactionPtr pTransaction, const EPoolType poolType)
 {
 	try
@@ -247,7 +282,7 @@ EBlockChainStatus BlockChainServer::AddBlockHeaders(const std::vector<BlockHeade
 {
 	try
 	{
-		return BlockHeaderProcessor(m_config, m_pChainState).ProcessSyncHeaders(blockHeaders);
+		return BlockHeaderProcessor(m_config, m_pChainState).ProcessSyncHeaders(blockHeaders, *m_pHeaderValidationPool);
 	}
 	catch (BadDataException&)
 	{
@@ -355,9 +390,9 @@ bool BlockChainServer::HasBlock(const uint64_t height, const Hash& hash) const
 {
 	auto pChainStateReader = m_pChainState->Read();
 	
-	auto pIndex = pChainStateReader->GetChainStore()->GetConfirmedChain()->GetByHeight(height);
+	auto indexOpt = pChainStateReader->GetChainStore()->GetConfirmedChain()->GetByHeight(height);
 
-	return pIndex != nullptr && pIndex->GetHash() == hash;
+	return indexOpt.has_value() && indexOpt->GetHash() == hash;
 }
 
 std::vector<std::pair<uint64_t, Hash>> BlockChainServer::GetBlocksNeeded(const uint64_t maxNumBlocks) const
@@ -9,6 +9,7 @@
 #include <Database/Database.h>
 #include <PMMR/TxHashSetManager.h>
 #include <P2P/SyncStatus.h>
+#include <Common/ThreadPool.h>
 #include <stdint.h>
 #include <mutex>
 
@@ -33,13 +34,16 @@ public:
 	virtual uint64_t GetTotalDifficulty(const EChainType chainType) const override final;
 
 	virtual EBlockChainStatus AddBlock(const FullBlock& block) override final;
+	virtual bool VerifyBlockSelfConsistent(const FullBlock& block) const override final;
 	virtual EBlockChainStatus AddCompactBlock(const CompactBlock& block) override final;
 
 	virtual EBlockChainStatus AddBlockHeader(BlockHeaderPtr pBlockHeader) override final;
 	virtual EBlockChainStatus AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) override final;
 
-	virtual std::string SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) override final;
+	virtual TxHashSetZipFilePtr SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) override final;
 	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const std::string& path, SyncStatus& syncStatus) override final;
+	virtual ITxHashSetDownloadPtr BeginTxHashSetDownload(const Hash& blockHash) override final;
+	virtual EBlockChainStatus ProcessTxHashSetDownload(ITxHashSetDownloadPtr pDownload, SyncStatus& syncStatus) override final;
 	virtual EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) override final;
 	virtual TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const override final;
 
@@ -76,4 +80,7 @@ private:
 	std::shared_ptr<ITransactionPool> m_pTransactionPool;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
 	std::shared_ptr<Locked<IHeaderMMR>> m_pHeaderMMR;
+
+	// Checks the proof of work of synced headers. Kept for the life of the server, rather than started for every batch.
+	std::shared_ptr<ThreadPool> m_pHeaderValidationPool;
 };
@@ -4,6 +4,13 @@
 #include <BlockChain/ChainType.h>
 #include <Core/Models/BlockHeader.h>
 
+//
+// A block's position in a chain.
+//
+// Chains don't allocate these. The hashes live contiguously in each chain's memory-mapped file (the hash at height h
+// is simply entry h), and a BlockIndex is just a by-value copy of one entry, so it's cheap to create and pass around,
+// and it stays valid after the chain it came from is extended or rewound.
+//
 class BlockIndex
 {
 public:
@@ -1,89 +1,59 @@
 #include "Chain.h"
-#include "ChainStore.h"
 
 #include <Core/Exceptions/BlockChainException.h>
 
-Chain::Chain(
-	const EChainType chainType,
-	std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
-	std::shared_ptr<DataFile<32>> pDataFile,
-	std::vector<std::shared_ptr<const BlockIndex>>&& indices)
+Chain::Chain(const EChainType chainType, std::shared_ptr<DataFile<32>> pDataFile)
 	: m_chainType(chainType),
-	m_pBlockIndexAllocator(pBlockIndexAllocator),
+	m_pDataFile(pDataFile),
 	m_dataFile(pDataFile),
-	m_dataFileWriter(),
-	m_indices(std::move(indices)),
-	m_height(m_indices.size() - 1)
+	m_dataFileWriter()
 {
 
 }
 
-std::shared_ptr<Chain> Chain::Load(
-	std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
-	const EChainType chainType,
-	const std::string& path,
-	std::shared_ptr<const BlockIndex> pGenesisIndex)
+std::shared_ptr<Chain> Chain::Load(const EChainType chainType, const std::string& path, const Hash& genesisHash)
 {
 	std::shared_ptr<DataFile<32>> pDataFile = DataFile<32>::Load(path);
 
 	if (pDataFile->GetSize() == 0)
 	{
-		const auto bytes = pGenesisIndex->GetHash().GetData();
-		pDataFile->AddData(bytes);
+		pDataFile->AddData(genesisHash);
 		pDataFile->Commit();
 	}
 
-	std::vector<std::shared_ptr<const BlockIndex>> indices;
-	indices.push_back(pGenesisIndex);
-
-	while (indices.size() < pDataFile->GetSize())
-	{
-		Hash hash = pDataFile->GetDataAt(indices.size());
-		indices.emplace_back(pBlockIndexAllocator->GetOrCreateIndex(std::move(hash), indices.size()));
-	}
-
-	return std::make_shared<Chain>(Chain(chainType, pBlockIndexAllocator, pDataFile, std::move(indices)));
+	return std::shared_ptr<Chain>(new Chain(chainType, pDataFile));
 }
 
-std::shared_ptr<const BlockIndex> Chain::GetByHeight(const uint64_t height) const
+std::optional<BlockIndex> Chain::GetByHeight(const uint64_t height) const
 {
-	if (m_height >= height)
+	if (GetHeight() >= height)
 	{
-		return m_indices[height];
+		return std::make_optional(BlockIndex(GetHash(height), height));
 	}
 
-	return nullptr;
+	return std::nullopt;
 }
 
-std::shared_ptr<const BlockIndex> Chain::AddBlock(const Hash& hash)
+BlockIndex Chain::AddBlock(const Hash& hash)
 {
 	SetDirty(true);
 
-	const uint64_t height = m_height + 1;
-	std::shared_ptr<const BlockIndex> pBlockIndex = m_pBlockIndexAllocator->GetOrCreateIndex(hash, height);
-	m_indices.push_back(pBlockIndex);
+	m_dataFileWriter->AddData(hash);
 
-	const auto bytes = pBlockIndex->GetHash().GetData();
-	m_dataFileWriter->AddData(bytes);
-
-	++m_height;
-	return pBlockIndex;
+	return BlockIndex(hash, GetHeight());
 }
 
 void Chain::Rewind(const uint64_t lastHeight)
 {
-	if (m_height < lastHeight)
+	if (GetHeight() < lastHeight)
 	{
 		throw BLOCK_CHAIN_EXCEPTION("Tried to rewind forward.");
 	}
 
-	if (m_height > lastHeight)
+	if (GetHeight() > lastHeight)
 	{
 		SetDirty(true);
-		m_indices.erase(m_indices.begin() + lastHeight + 1, m_indices.end());
-
 		m_dataFileWriter->Rewind(lastHeight + 1);
-		m_height = lastHeight;
 	}
 }
 
@@ -102,15 +72,6 @@ void Chain::Rollback()
 	if (IsDirty())
 	{
 		m_dataFileWriter->Rollback();
-		m_indices.clear();
-
-		while (m_indices.size() < m_dataFileWriter->GetSize())
-		{
-			Hash hash = m_dataFileWriter->GetDataAt(m_indices.size());
-			m_indices.push_back(m_pBlockIndexAllocator->GetOrCreateIndex(std::move(hash), m_indices.size()));
-		}
-
-		m_height = m_indices.size() - 1;
 	}
 
 	SetDirty(false);
@@ -4,30 +4,33 @@
 
 #include <Core/Traits/Lockable.h>
 #include <Core/DataFile.h>
-
-// Forward Declarations
-class BlockIndexAllocator;
-class ChainStore;
-
+#include <optional>
+
+//
+// The hashes of a chain's blocks, indexed by height.
+//
+// The hashes are read directly out of the chain's memory-mapped DataFile (entry h is the hash at height h),
+// so loading a chain doesn't copy or allocate anything per block, and the file's size is the chain's only state.
+// Rewinding just moves the end of the file back, and Rollback just restores the file.
+//
 class Chain : Traits::IBatchable
 {
 public:
 	static std::shared_ptr<Chain> Load(
-		std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
 		const EChainType chainType,
 		const std::string& path,
-		std::shared_ptr<const BlockIndex> pGenesisIndex
+		const Hash& genesisHash
 	);
 
-	std::shared_ptr<const BlockIndex> GetByHeight(const uint64_t height) const;
+	std::optional<BlockIndex> GetByHeight(const uint64_t height) const;
 
-	const Hash& GetHash(const uint64_t height) const { return m_indices[height]->GetHash(); }
-	std::shared_ptr<const BlockIndex> GetTip() const { return m_indices[m_height]; }
-	uint64_t GetHeight() const { return m_height; }
+	Hash GetHash(const uint64_t height) const { return Hash(m_pDataFile->GetDataPtrAt(height)); }
+	BlockIndex GetTip() const { return BlockIndex(GetHash(GetHeight()), GetHeight()); }
+	uint64_t GetHeight() const { return m_pDataFile->GetSize() - 1; }
 
 	inline EChainType GetType() const { return m_chainType; }
 
-	std::shared_ptr<const BlockIndex> AddBlock(const Hash& hash);
+	BlockIndex AddBlock(const Hash& hash);
 	void Rewind(const uint64_t lastHeight);
 
 	virtual void Commit() override final;
@@ -36,50 +39,13 @@ public:
 	virtual void OnEndWrite() override final;
 
 private:
-	Chain(
-		const EChainType chainType,
-		std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
-		std::shared_ptr<DataFile<32>> pDataFile,
-		std::vector<std::shared_ptr<const BlockIndex>>&& indices
-	);
+	Chain(const EChainType chainType, std::shared_ptr<DataFile<32>> pDataFile);
 
 	const EChainType m_chainType;
-	std::shared_ptr<BlockIndexAllocator> m_pBlockIndexAllocator;
-	std::vector<std::shared_ptr<const BlockIndex>> m_indices;
-	size_t m_height;
+
+	// Reads go straight to the file. They're already serialized by the ChainStore's lock,
+	// and during a batch they need to see the batch's uncommitted blocks.
+	std::shared_ptr<const DataFile<32>> m_pDataFile;
 	Locked<DataFile<32>> m_dataFile;
 	Writer<DataFile<32>> m_dataFileWriter;
-};
-
-class BlockIndexAllocator
-{
-public:
-	BlockIndexAllocator() = default;
-
-	void AddChain(std::shared_ptr<const Chain> pChain)
-	{
-		m_chains.push_back(pChain);
-	}
-
-	std::shared_ptr<const BlockIndex> GetOrCreateIndex(const Hash& hash, const uint64_t height) const
-	{
-		return GetOrCreateIndex(Hash(hash), height);
-	}
-
-	std::shared_ptr<const BlockIndex> GetOrCreateIndex(Hash&& hash, const uint64_t height) const
-	{
-		for (std::shared_ptr<const Chain> pChain : m_chains)
-		{
-			std::shared_ptr<const BlockIndex> pIndex = pChain->GetByHeight(height);
-			if (pIndex != nullptr && pIndex->GetHash() == hash)
-			{
-				return pIndex;
-			}
-		}
-
-		return std::make_shared<const BlockIndex>(BlockIndex(std::move(hash), height));
-	}
-
-private:
-	std::vector<std::shared_ptr<const Chain>> m_chains;
 };
\ No newline at end of file
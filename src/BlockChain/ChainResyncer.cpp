@@ -17,10 +17,9 @@ bool ChainResyncer::ResyncChain()
 	auto pCandidateChain = pLockedState->GetChainStore()->GetCandidateChain();
 	
 	pLockedState->GetHeaderMMR()->Rewind(1);
-	for (uint64_t i = 1; i <= pCandidateChain->GetTip()->GetHeight(); i++)
+	for (uint64_t i = 1; i <= pCandidateChain->GetHeight(); i++)
 	{
-		auto pIndex = pCandidateChain->GetByHeight(i);
-		const Hash hash = pIndex->GetHash();
+		const Hash hash = pCandidateChain->GetHash(i);
 
 		auto pHeader = pLockedState->GetBlockDB()->GetBlockHeader(hash);
 		if (pHeader == nullptr)
@@ -33,7 +32,7 @@ bool ChainResyncer::ResyncChain()
 	}
 
 	auto pSyncChain = pLockedState->GetChainStore()->GetSyncChain();
-	pSyncChain->Rewind(pCandidateChain->GetTip()->GetHeight());
+	pSyncChain->Rewind(pCandidateChain->GetHeight());
 
 	pLockedState->Commit();
 
@@ -34,15 +34,15 @@ std::shared_ptr<Locked<ChainState>> ChainState::Create(
 	BlockHeaderPtr pGenesisHeader)
 {
 	std::shared_ptr<const Chain> pCandidateChain = pChainStore->Read()->GetCandidateChain();
-	const uint64_t candidateHeight = pCandidateChain->GetTip()->GetHeight();
+	const uint64_t candidateHeight = pCandidateChain->GetHeight();
 	if (candidateHeight == 0)
 	{
 		pDatabase->Write()->AddBlockHeader(pGenesisHeader);
 		pHeaderMMR->Write()->AddHeader(*pGenesisHeader);
 	}
 
-	auto pConfirmedIndex = pChainStore->Read()->GetConfirmedChain()->GetTip();
-	auto pConfirmedHeader = pDatabase->Read()->GetBlockHeader(pConfirmedIndex->GetHash());
+	const BlockIndex confirmedIndex = pChainStore->Read()->GetConfirmedChain()->GetTip();
+	auto pConfirmedHeader = pDatabase->Read()->GetBlockHeader(confirmedIndex.GetHash());
 	pTxHashSetManager->Open(pConfirmedHeader);
 
 	std::shared_ptr<ChainState> pChainState(new ChainState(config, pChainStore, pDatabase, pHeaderMMR, pTransactionPool, pTxHashSetManager));
@@ -51,14 +51,14 @@ std::shared_ptr<Locked<ChainState>> ChainState::Create(
 
 void ChainState::UpdateSyncStatus(SyncStatus& syncStatus) const
 {
-	const Hash& candidateHeadHash = GetChainStore()->GetChain(EChainType::CANDIDATE)->GetTip()->GetHash();
+	const Hash candidateHeadHash = GetChainStore()->GetChain(EChainType::CANDIDATE)->GetTip().GetHash();
 	auto pCandidateHead = GetBlockDB()->GetBlockHeader(candidateHeadHash);
 	if (pCandidateHead != nullptr)
 	{
 		syncStatus.UpdateHeaderStatus(pCandidateHead->GetHeight(), pCandidateHead->GetTotalDifficulty());
 	}
 
-	const Hash& confirmedHeadHash = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetTip()->GetHash();
+	const Hash confirmedHeadHash = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetTip().GetHash();
 	auto pConfirmedHead = GetBlockDB()->GetBlockHeader(confirmedHeadHash);
 	if (pConfirmedHead != nullptr)
 	{
@@ -84,7 +84,7 @@ uint64_t ChainState::GetTotalDifficulty(const EChainType chainType) const
 
 BlockHeaderPtr ChainState::GetTipBlockHeader(const EChainType chainType) const
 {
-	const Hash& headHash = GetChainStore()->GetChain(chainType)->GetTip()->GetHash();
+	const Hash headHash = GetChainStore()->GetChain(chainType)->GetTip().GetHash();
 
 	return GetBlockDB()->GetBlockHeader(headHash);
 }
@@ -96,10 +96,10 @@ BlockHeaderPtr ChainState::GetBlockHeaderByHash(const Hash& hash) const
 
 BlockHeaderPtr ChainState::GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const
 {
-	auto pBlockIndex = GetChainStore()->GetChain(chainType)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
+	auto blockIndexOpt = GetChainStore()->GetChain(chainType)->GetByHeight(height);
+	if (blockIndexOpt.has_value())
 	{
-		return GetBlockDB()->GetBlockHeader(pBlockIndex->GetHash());
+		return GetBlockDB()->GetBlockHeader(blockIndexOpt->GetHash());
 	}
 
 	return BlockHeaderPtr(nullptr);
@@ -112,10 +112,10 @@ BlockHeaderPtr ChainState::GetBlockHeaderByCommitment(const Commitment& outputCo
 	std::unique_ptr<OutputLocation> pOutputLocation = GetBlockDB()->GetOutputPosition(outputCommitment);
 	if (pOutputLocation != nullptr)
 	{
-		auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(pOutputLocation->GetBlockHeight());
-		if (pBlockIndex != nullptr)
+		auto blockIndexOpt = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(pOutputLocation->GetBlockHeight());
+		if (blockIndexOpt.has_value())
 		{
-			return GetBlockDB()->GetBlockHeader(pBlockIndex->GetHash());
+			return GetBlockDB()->GetBlockHeader(blockIndexOpt->GetHash());
 		}
 	}
 
@@ -129,10 +129,10 @@ std::unique_ptr<FullBlock> ChainState::GetBlockByHash(const Hash& hash) const
 
 std::unique_ptr<FullBlock> ChainState::GetBlockByHeight(const uint64_t height) const
 {
-	auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
+	auto blockIndexOpt = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
+	if (blockIndexOpt.has_value())
 	{
-		return GetBlockDB()->GetBlock(pBlockIndex->GetHash());
+		return GetBlockDB()->GetBlock(blockIndexOpt->GetHash());
 	}
 
 	return std::unique_ptr<FullBlock>(nullptr);
@@ -151,23 +151,31 @@ std::unique_ptr<BlockWithOutputs> ChainState::GetBlockWithOutputs(const uint64_t
 		return std::unique_ptr<BlockWithOutputs>(nullptr);
 	}
 
-	auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
+	auto blockIndexOpt = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
+	if (blockIndexOpt.has_value())
 	{
-		std::unique_ptr<FullBlock> pBlock = GetBlockDB()->GetBlock(pBlockIndex->GetHash());
+		std::unique_ptr<FullBlock> pBlock = GetBlockDB()->GetBlock(blockIndexOpt->GetHash());
 		if (pBlock != nullptr)
 		{
 			std::vector<OutputDTO> outputsFound;
 			outputsFound.reserve(pBlock->GetTransactionBody().GetOutputs().size());
 
 			const std::vector<TransactionOutput>& outputs = pBlock->GetTransactionBody().GetOutputs();
+			std::vector<Commitment> commitments;
+			commitments.reserve(outputs.size());
 			for (const TransactionOutput& output : outputs)
 			{
-				std::unique_ptr<OutputLocation> pOutputLocation = GetBlockDB()->GetOutputPosition(output.GetCommitment());
+				commitments.push_back(output.GetCommitment());
+			}
+
+			const std::vector<std::unique_ptr<OutputLocation>> outputLocations = GetBlockDB()->GetOutputPositions(commitments);
+			for (size_t i = 0; i < outputs.size(); i++)
+			{
+				const std::unique_ptr<OutputLocation>& pOutputLocation = outputLocations[i];
 				if (pOutputLocation != nullptr)
 				{
 					const bool spent = !pTxHashSet->IsUnspent(*pOutputLocation);
-					outputsFound.emplace_back(OutputDTO(spent, OutputIdentifier::FromOutput(output), *pOutputLocation, output.GetRangeProof()));
+					outputsFound.emplace_back(OutputDTO(spent, OutputIdentifier::FromOutput(outputs[i]), *pOutputLocation, outputs[i].GetRangeProof()));
 				}
 			}
 
@@ -184,15 +192,15 @@ std::vector<std::pair<uint64_t, Hash>> ChainState::GetBlocksNeeded(const uint64_
 	blocksNeeded.reserve(maxNumBlocks);
 
 	std::shared_ptr<const Chain> pCandidateChain = GetChainStore()->GetCandidateChain();
-	const uint64_t candidateHeight = pCandidateChain->GetTip()->GetHeight();
+	const uint64_t candidateHeight = pCandidateChain->GetHeight();
 
-	uint64_t nextHeight = GetChainStore()->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED)->GetHeight() + 1;
+	uint64_t nextHeight = GetChainStore()->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED).GetHeight() + 1;
 	while (nextHeight <= candidateHeight)
 	{
-		auto pIndex = pCandidateChain->GetByHeight(nextHeight);
-		if (!m_pOrphanPool->IsOrphan(nextHeight, pIndex->GetHash()))
+		const Hash hash = pCandidateChain->GetHash(nextHeight);
+		if (!m_pOrphanPool->IsOrphan(nextHeight, hash))
 		{
-			blocksNeeded.emplace_back(std::pair<uint64_t, Hash>(nextHeight, pIndex->GetHash()));
+			blocksNeeded.emplace_back(std::pair<uint64_t, Hash>(nextHeight, hash));
 
 			if (blocksNeeded.size() == maxNumBlocks)
 			{
@@ -11,36 +11,31 @@ ChainStore::ChainStore(std::shared_ptr<Chain> pConfirmedChain, std::shared_ptr<C
 
 }
 
-std::shared_ptr<Locked<ChainStore>> ChainStore::Load(const Config& config, std::shared_ptr<BlockIndex> pGenesisIndex)
+std::shared_ptr<Locked<ChainStore>> ChainStore::Load(const Config& config, const Hash& genesisHash)
 {
 	LOG_TRACE("Loading Chain");
-	std::shared_ptr<BlockIndexAllocator> pAllocator = std::make_shared<BlockIndexAllocator>();
 
-	std::shared_ptr<Chain> pConfirmedChain = Chain::Load(pAllocator, EChainType::CONFIRMED, config.GetNodeConfig().GetChainPath().u8string() + "confirmed.chain", pGenesisIndex);
+	std::shared_ptr<Chain> pConfirmedChain = Chain::Load(EChainType::CONFIRMED, config.GetNodeConfig().GetChainPath().u8string() + "confirmed.chain", genesisHash);
 	if (pConfirmedChain == nullptr)
 	{
 		LOG_INFO("Failed to load confirmed chain");
 		throw std::exception();
 	}
 
-	pAllocator->AddChain(pConfirmedChain);
-	std::shared_ptr<Chain> pCandidateChain = Chain::Load(pAllocator, EChainType::CANDIDATE, config.GetNodeConfig().GetChainPath().u8string() + "candidate.chain", pGenesisIndex);
+	std::shared_ptr<Chain> pCandidateChain = Chain::Load(EChainType::CANDIDATE, config.GetNodeConfig().GetChainPath().u8string() + "candidate.chain", genesisHash);
 	if (pCandidateChain == nullptr)
 	{
 		LOG_INFO("Failed to load candidate chain");
 		throw std::exception();
 	}
 
-	pAllocator->AddChain(pCandidateChain);
-	std::shared_ptr<Chain> pSyncChain = Chain::Load(pAllocator, EChainType::SYNC, config.GetNodeConfig().GetChainPath().u8string() + "sync.chain", pGenesisIndex);
+	std::shared_ptr<Chain> pSyncChain = Chain::Load(EChainType::SYNC, config.GetNodeConfig().GetChainPath().u8string() + "sync.chain", genesisHash);
 	if (pSyncChain == nullptr)
 	{
 		LOG_INFO("Failed to load sync chain");
 		throw std::exception();
 	}
 
-	pAllocator->AddChain(pSyncChain);
-
 	auto pChainStore = std::shared_ptr<ChainStore>(new ChainStore(pConfirmedChain, pCandidateChain, pSyncChain));
 	return std::make_shared<Locked<ChainStore>>(Locked<ChainStore>(pChainStore));
 }
@@ -73,23 +68,19 @@ void ChainStore::OnEndWrite()
 	m_pConfirmedChain->OnEndWrite();
 }
 
-std::shared_ptr<const BlockIndex> ChainStore::FindCommonIndex(const EChainType chainType1, const EChainType chainType2) const
+BlockIndex ChainStore::FindCommonIndex(const EChainType chainType1, const EChainType chainType2) const
 {
 	std::shared_ptr<const Chain> pChain1 = GetChain(chainType1);
 	std::shared_ptr<const Chain> pChain2 = GetChain(chainType2);
 
-	uint64_t height = (std::min)(pChain1->GetTip()->GetHeight(), pChain2->GetTip()->GetHeight());
-	std::shared_ptr<const BlockIndex> pChain1Index = pChain1->GetByHeight(height);
-	std::shared_ptr<const BlockIndex> pChain2Index = pChain2->GetByHeight(height);
-
-	while (pChain1Index->GetHash() != pChain2Index->GetHash())
+	// Every chain starts at genesis, so this always terminates.
+	uint64_t height = (std::min)(pChain1->GetHeight(), pChain2->GetHeight());
+	while (height > 0 && pChain1->GetHash(height) != pChain2->GetHash(height))
 	{
 		--height;
-		pChain1Index = pChain1->GetByHeight(height);
-		pChain2Index = pChain2->GetByHeight(height);
 	}
 
-	return pChain1Index;
+	return BlockIndex(pChain1->GetHash(height), height);
 }
 
 void ChainStore::ReorgChain(const EChainType source, const EChainType destination)
@@ -102,18 +93,12 @@ void ChainStore::ReorgChain(const EChainType source, const EChainType destinatio
 	std::shared_ptr<Chain> pSourceChain = GetChain(source);
 	std::shared_ptr<Chain> pDestinationChain = GetChain(destination);
 
-	if (pSourceChain->GetTip()->GetHeight() < height)
+	if (pSourceChain->GetHeight() < height)
 	{
 		throw BLOCK_CHAIN_EXCEPTION("Can't reorg beyond tip");
 	}
 
-	std::shared_ptr<const BlockIndex> pBlockIndex = FindCommonIndex(source, destination);
-	if (pBlockIndex == nullptr)
-	{
-		throw BLOCK_CHAIN_EXCEPTION("No common header found.");
-	}
-
-	const uint64_t commonHeight = pBlockIndex->GetHeight();
+	const uint64_t commonHeight = FindCommonIndex(source, destination).GetHeight();
 	pDestinationChain->Rewind(commonHeight);
 	for (uint64_t i = commonHeight + 1; i <= height; i++)
 	{
@@ -126,9 +111,9 @@ void ChainStore::AddBlock(const EChainType source, const EChainType destination,
 	std::shared_ptr<Chain> pSourceChain = GetChain(source);
 	std::shared_ptr<Chain> pDestinationChain = GetChain(destination);
 
-	if (pDestinationChain->GetTip()->GetHeight() + 1 == height)
+	if (pDestinationChain->GetHeight() + 1 == height)
 	{
-		if (pSourceChain->GetTip()->GetHeight() >= height)
+		if (pSourceChain->GetHeight() >= height)
 		{
 			pDestinationChain->AddBlock(pSourceChain->GetHash(height));
 			return;
@@ -8,7 +8,7 @@
 class ChainStore : public Traits::IBatchable
 {
 public:
-	static std::shared_ptr<Locked<ChainStore>> Load(const Config& config, std::shared_ptr<BlockIndex>);
+	static std::shared_ptr<Locked<ChainStore>> Load(const Config& config, const Hash& genesisHash);
 
 	virtual void Commit() override final;
 	virtual void Rollback() override final;
@@ -17,8 +17,7 @@ public:
 
 	std::shared_ptr<Chain> GetChain(const EChainType chainType);
 	std::shared_ptr<const Chain> GetChain(const EChainType chainType) const;
-	//std::shared_ptr<BlockIndex> GetOrCreateIndex(const Hash& hash, const uint64_t height);
-	std::shared_ptr<const BlockIndex> FindCommonIndex(const EChainType chainType1, const EChainType chainType2) const;
+	BlockIndex FindCommonIndex(const EChainType chainType1, const EChainType chainType2) const;
 
 	//
 	// Applies all of the blocks from the source chain to the destination chain, up to the specified height.
@@ -10,6 +10,9 @@
 
 static const size_t SYNC_BATCH_SIZE = 128;
 
+// Number of headers each task validates when checking headers in parallel.
+static const size_t VALIDATION_TASK_SIZE = 16;
+
 BlockHeaderProcessor::BlockHeaderProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState)
 	: m_config(config), m_pChainState(pChainState)
 {
@@ -28,16 +31,16 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(BlockHeaderPtr pHead
 	auto pCandidateChain = pLockedState->GetChainStore()->GetCandidateChain();
 
 	// Check if header already processed
-	auto pCandidateIndex = pCandidateChain->GetByHeight(pHeader->GetHeight());
-	if (pCandidateIndex != nullptr && pCandidateIndex->GetHash() == pHeader->GetHash())
+	auto candidateIndexOpt = pCandidateChain->GetByHeight(pHeader->GetHeight());
+	if (candidateIndexOpt.has_value() && candidateIndexOpt->GetHash() == pHeader->GetHash())
 	{
 		LOG_DEBUG_F("Header {} already processed.", *pHeader);
 		return EBlockChainStatus::ALREADY_EXISTS;
 	}
 
 	// If this is not the next header needed, process as an orphan.
-	auto pLastIndex = pCandidateChain->GetTip();
-	if (pLastIndex->GetHash() != pHeader->GetPreviousBlockHash())
+	const BlockIndex lastIndex = pCandidateChain->GetTip();
+	if (lastIndex.GetHash() != pHeader->GetPreviousBlockHash())
 	{
 		return ProcessOrphan(pLockedState, pHeader);
 	}
@@ -45,7 +48,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(BlockHeaderPtr pHead
 	LOG_TRACE_F("Processing next candidate header: {}", *pHeader);
 
 	// Validate the header.
-	auto pPreviousHeaderPtr = pBlockDB->GetBlockHeader(pLastIndex->GetHash());
+	auto pPreviousHeaderPtr = pBlockDB->GetBlockHeader(lastIndex.GetHash());
 	if (!BlockHeaderValidator(m_config, pBlockDB, pHeaderMMR).IsValidHeader(*pHeader, *pPreviousHeaderPtr))
 	{
 		LOG_ERROR_F("Header {} failed to validate", *pHeader);
@@ -78,13 +81,13 @@ EBlockChainStatus BlockHeaderProcessor::ProcessOrphan(Writer<ChainState> pLocked
 		while (pTempHeader != nullptr)
 		{
 			reorgHeaders.push_back(pTempHeader);
-			auto pIndex = pCandidateChain->GetByHeight(pTempHeader->GetHeight());
-			if (pIndex != nullptr && pIndex->GetHash() == pTempHeader->GetHash())
+			auto indexOpt = pCandidateChain->GetByHeight(pTempHeader->GetHeight());
+			if (indexOpt.has_value() && indexOpt->GetHash() == pTempHeader->GetHash())
 			{
 				// All headers exist. Reorg.
 				std::reverse(reorgHeaders.begin(), reorgHeaders.end());
 
-				const EBlockChainStatus processChunkStatus = ProcessChunkedSyncHeaders(pLockedState, reorgHeaders);
+				const EBlockChainStatus processChunkStatus = ProcessChunkedSyncHeaders(pLockedState, reorgHeaders, false);
 				if (processChunkStatus == EBlockChainStatus::SUCCESS || processChunkStatus == EBlockChainStatus::ALREADY_EXISTS)
 				{
 					pLockedState->Commit();
@@ -107,7 +110,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessOrphan(Writer<ChainState> pLocked
 	return EBlockChainStatus::ORPHANED;
 }
 
-EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<BlockHeaderPtr>& headers)
+EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<BlockHeaderPtr>& headers, ThreadPool& validationPool)
 {
 	if (headers.empty())
 	{
@@ -130,6 +133,17 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 		}
 	}
 
+	// Check the cuckoo cycles and other context-free rules of every new header in parallel, before taking the chain lock.
+	// Headers already in the sync chain were validated when they were added, so peers resending them cost nothing.
+	const std::vector<BlockHeaderPtr> newHeaders = FilterKnownHeaders(headers);
+	if (newHeaders.empty())
+	{
+		LOG_DEBUG("Headers already processed.");
+		return EBlockChainStatus::SUCCESS;
+	}
+
+	ValidateContextFree(newHeaders, validationPool);
+
 	const size_t size = headers.size();
 	size_t index = 0;
 
@@ -141,7 +155,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 		if (index % SYNC_BATCH_SIZE == 0 || index == size)
 		{
 			auto pChainStateBatch = m_pChainState->BatchWrite();
-			const EBlockChainStatus processChunkStatus = ProcessChunkedSyncHeaders(pChainStateBatch, chunkedHeaders);
+			const EBlockChainStatus processChunkStatus = ProcessChunkedSyncHeaders(pChainStateBatch, chunkedHeaders, true);
 			if (processChunkStatus == EBlockChainStatus::SUCCESS)
 			{
 				pChainStateBatch->Commit();
@@ -158,7 +172,10 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 	return EBlockChainStatus::SUCCESS;
 }
 
-EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(Writer<ChainState> pLockedState, const std::vector<BlockHeaderPtr>& headers)
+EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(
+	Writer<ChainState> pLockedState,
+	const std::vector<BlockHeaderPtr>& headers,
+	const bool contextFreeValidated)
 {
 	auto pHeaderMMR = pLockedState->GetHeaderMMR();
 	auto pChainStore = pLockedState->GetChainStore();
@@ -171,8 +188,8 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(Writer<ChainSt
 	for (size_t i = 0; i < headers.size(); i++)
 	{
 		auto pHeader = headers[i];
-		auto pSyncHeader = pSyncChain->GetByHeight(pHeader->GetHeight());
-		if (pSyncHeader == nullptr || pHeader->GetHash() != pSyncHeader->GetHash())
+		auto syncHeaderOpt = pSyncChain->GetByHeight(pHeader->GetHeight());
+		if (!syncHeaderOpt.has_value() || pHeader->GetHash() != syncHeaderOpt->GetHash())
 		{
 			newHeaders.push_back(pHeader);
 		}
@@ -190,7 +207,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(Writer<ChainSt
 	RewindMMR(pLockedState, newHeaders);
 
 	// Validate the headers.
-	ValidateHeaders(pLockedState, newHeaders);
+	ValidateHeaders(pLockedState, newHeaders, contextFreeValidated);
 
 	// Add the headers to the sync chain.
 	AddSyncHeaders(pLockedState, newHeaders);
@@ -222,11 +239,11 @@ void BlockHeaderProcessor::PrepareSyncChain(Writer<ChainState> pLockedState, con
 
 	// Check if previous header exists and matches previous hash.
 	const Hash& previousHash = headers.front()->GetPreviousBlockHash();
-	auto pPrevSync = pSyncChain->GetByHeight(headers.front()->GetHeight() - 1);
-	if (pPrevSync == nullptr || pPrevSync->GetHash() != previousHash)
+	auto prevSyncOpt = pSyncChain->GetByHeight(headers.front()->GetHeight() - 1);
+	if (!prevSyncOpt.has_value() || prevSyncOpt->GetHash() != previousHash)
 	{
-		auto pPrevCandidate = pCandidateChain->GetByHeight(headers.front()->GetHeight() - 1);
-		if (pPrevCandidate != nullptr && pPrevCandidate->GetHash() == previousHash)
+		auto prevCandidateOpt = pCandidateChain->GetByHeight(headers.front()->GetHeight() - 1);
+		if (prevCandidateOpt.has_value() && prevCandidateOpt->GetHash() == previousHash)
 		{
 			pChainStore->ReorgChain(EChainType::CANDIDATE, EChainType::SYNC);
 		}
@@ -247,11 +264,11 @@ void BlockHeaderProcessor::RewindMMR(Writer<ChainState> pLockedState, const std:
 
 	const uint64_t firstHeight = headers.front()->GetHeight();
 
-	auto pCommonIndex = pChainStore->FindCommonIndex(EChainType::SYNC, EChainType::CANDIDATE);
-	if (pCommonIndex->GetHeight() < (firstHeight - 1))
+	const BlockIndex commonIndex = pChainStore->FindCommonIndex(EChainType::SYNC, EChainType::CANDIDATE);
+	if (commonIndex.GetHeight() < (firstHeight - 1))
 	{
-		pHeaderMMR->Rewind(pCommonIndex->GetHeight() + 1);
-		for (size_t height = pCommonIndex->GetHeight() + 1; height < firstHeight; height++)
+		pHeaderMMR->Rewind(commonIndex.GetHeight() + 1);
+		for (size_t height = commonIndex.GetHeight() + 1; height < firstHeight; height++)
 		{
 			auto pHeader = pLockedState->GetBlockHeaderByHeight(height, EChainType::SYNC);
 			if (pHeader == nullptr)
@@ -268,7 +285,64 @@ void BlockHeaderProcessor::RewindMMR(Writer<ChainState> pLockedState, const std:
 	}
 }
 
-void BlockHeaderProcessor::ValidateHeaders(Writer<ChainState> pLockedState, const std::vector<BlockHeaderPtr>& headers)
+std::vector<BlockHeaderPtr> BlockHeaderProcessor::FilterKnownHeaders(const std::vector<BlockHeaderPtr>& headers) const
+{
+	auto pReader = m_pChainState->Read();
+	auto pSyncChain = pReader->GetChainStore()->GetSyncChain();
+
+	std::vector<BlockHeaderPtr> newHeaders;
+	for (const BlockHeaderPtr& pHeader : headers)
+	{
+		auto syncHeaderOpt = pSyncChain->GetByHeight(pHeader->GetHeight());
+		if (!syncHeaderOpt.has_value() || pHeader->GetHash() != syncHeaderOpt->GetHash())
+		{
+			newHeaders.push_back(pHeader);
+		}
+	}
+
+	return newHeaders;
+}
+
+void BlockHeaderProcessor::ValidateContextFree(const std::vector<BlockHeaderPtr>& headers, ThreadPool& validationPool) const
+{
+	LOG_TRACE_F("Validating {} headers in parallel", headers.size());
+
+	const size_t numTasks = (headers.size() + VALIDATION_TASK_SIZE - 1) / VALIDATION_TASK_SIZE;
+
+	std::vector<std::future<bool>> futures;
+	futures.reserve(numTasks);
+	for (size_t begin = 0; begin < headers.size(); begin += VALIDATION_TASK_SIZE)
+	{
+		const size_t end = (std::min)(begin + VALIDATION_TASK_SIZE, headers.size());
+		futures.push_back(validationPool.Submit([this, &headers, begin, end]() {
+			for (size_t i = begin; i < end; i++)
+			{
+				if (!BlockHeaderValidator::IsValidContextFree(m_config, *headers[i]))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}));
+	}
+
+	validationPool.Wait(futures);
+
+	for (size_t i = 0; i < futures.size(); i++)
+	{
+		if (!futures[i].get())
+		{
+			LOG_ERROR_F("Header invalid in batch starting at {}", *headers[i * VALIDATION_TASK_SIZE]);
+			throw BAD_DATA_EXCEPTION("Header invalid.");
+		}
+	}
+}
+
+void BlockHeaderProcessor::ValidateHeaders(
+	Writer<ChainState> pLockedState,
+	const std::vector<BlockHeaderPtr>& headers,
+	const bool contextFreeValidated)
 {
 	LOG_TRACE("Validating headers");
 
@@ -286,7 +360,10 @@ void BlockHeaderProcessor::ValidateHeaders(Writer<ChainState> pLockedState, cons
 
 	for (auto pHeader : headers)
 	{
-		if (!validator.IsValidHeader(*pHeader, *pPreviousHeader))
+		const bool valid = contextFreeValidated ?
+			validator.IsValidInContext(*pHeader, *pPreviousHeader) :
+			validator.IsValidHeader(*pHeader, *pPreviousHeader);
+		if (!valid)
 		{
 			LOG_ERROR_F("Header invalid: {}", *pHeader);
 			throw BAD_DATA_EXCEPTION("Header invalid.");
@@ -307,15 +384,15 @@ void BlockHeaderProcessor::AddSyncHeaders(Writer<ChainState> pLockedState, const
 	const Hash& previousHash = headers.front()->GetPreviousBlockHash();
 
 	// Ensure chain is on correct fork.
-	auto pPrevious = pSyncChain->GetByHeight(firstHeaderHeight - 1);
-	if (pPrevious == nullptr || pPrevious->GetHash() != previousHash)
+	auto previousOpt = pSyncChain->GetByHeight(firstHeaderHeight - 1);
+	if (!previousOpt.has_value() || previousOpt->GetHash() != previousHash)
 	{
 		LOG_ERROR("Chain state invalid. Unrecoverable error.");
 		throw BLOCK_CHAIN_EXCEPTION("Chain state invalid.");
 	}
 
 	// Rewind chain if necessary.
-	if (pSyncChain->GetTip()->GetHash() != previousHash)
+	if (pSyncChain->GetTip().GetHash() != previousHash)
 	{
 		pSyncChain->Rewind(firstHeaderHeight - 1);
 	}
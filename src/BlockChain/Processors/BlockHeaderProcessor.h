@@ -5,6 +5,7 @@
 #include <Config/Config.h>
 #include <BlockChain/BlockChainStatus.h>
 #include <Core/Models/BlockHeader.h>
+#include <Common/ThreadPool.h>
 
 class BlockHeaderProcessor
 {
@@ -22,11 +23,12 @@ public:
 	//
 	// Validates and adds multiple headers to the sync chain.
 	// The headers are also added to the candidate chain if total difficulty increases.
+	// The context-free checks (including proof of work) of headers not already in the sync chain run on validationPool.
 	//
 	// Throws BadDataException if any of the headers are invalid.
 	// Throws BlockChainException if any other errors occur.
 	//
-	EBlockChainStatus ProcessSyncHeaders(const std::vector<BlockHeaderPtr>& headers);
+	EBlockChainStatus ProcessSyncHeaders(const std::vector<BlockHeaderPtr>& headers, ThreadPool& validationPool);
 
 private:
 	EBlockChainStatus ProcessOrphan(
@@ -36,7 +38,8 @@ private:
 
 	EBlockChainStatus ProcessChunkedSyncHeaders(
 		Writer<ChainState> pLockedState,
-		const std::vector<BlockHeaderPtr>& headers
+		const std::vector<BlockHeaderPtr>& headers,
+		const bool contextFreeValidated
 	);
 
 	void PrepareSyncChain(
@@ -49,9 +52,21 @@ private:
 		const std::vector<BlockHeaderPtr>& headers
 	);
 
+	//
+	// Returns the headers that aren't already in the sync chain, and so still need to be validated.
+	//
+	std::vector<BlockHeaderPtr> FilterKnownHeaders(const std::vector<BlockHeaderPtr>& headers) const;
+
+	//
+	// Runs BlockHeaderValidator::IsValidContextFree on all of the headers in parallel.
+	// Throws BadDataException if any of them are invalid.
+	//
+	void ValidateContextFree(const std::vector<BlockHeaderPtr>& headers, ThreadPool& validationPool) const;
+
 	void ValidateHeaders(
 		Writer<ChainState> pLockedState,
-		const std::vector<BlockHeaderPtr>& headers
+		const std::vector<BlockHeaderPtr>& headers,
+		const bool contextFreeValidated
 	);
 
 	void AddSyncHeaders(
@@ -57,8 +57,8 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 	auto pConfirmedChain = pChainStore->GetConfirmedChain();
 
 	// 1. Check if already part of confirmed chain
-	std::shared_ptr<const BlockIndex> pConfirmedIndex = pConfirmedChain->GetByHeight(block.GetHeight());
-	if (pConfirmedIndex != nullptr && pConfirmedIndex->GetHash() == block.GetHash())
+	auto confirmedIndexOpt = pConfirmedChain->GetByHeight(block.GetHeight());
+	if (confirmedIndexOpt.has_value() && confirmedIndexOpt->GetHash() == block.GetHash())
 	{
 		LOG_TRACE_F("Block {} already part of confirmed chain.", block);
 		return EBlockChainStatus::ALREADY_EXISTS;
@@ -113,32 +113,32 @@ EBlockStatus BlockProcessor::DetermineBlockStatus(const FullBlock& block, Writer
 	auto pConfirmedChain = pChainStore->GetConfirmedChain();
 
 	// Orphan if block not a part of candidate chain.
-	auto pCandidateIndex = pCandidateChain->GetByHeight(block.GetHeight());
-	if (nullptr == pCandidateIndex || pCandidateIndex->GetHash() != block.GetHash())
+	auto candidateIndexOpt = pCandidateChain->GetByHeight(block.GetHeight());
+	if (!candidateIndexOpt.has_value() || candidateIndexOpt->GetHash() != block.GetHash())
 	{
 		LOG_DEBUG_F("Candidate block mismatch. Treating {} as orphan.", block);
 		return EBlockStatus::ORPHAN;
 	}
 
 	// Orphan if previous block is missing.
-	auto pPreviousConfirmedIndex = pConfirmedChain->GetByHeight(block.GetHeight() - 1);
-	if (pPreviousConfirmedIndex == nullptr)
+	auto previousConfirmedIndexOpt = pConfirmedChain->GetByHeight(block.GetHeight() - 1);
+	if (!previousConfirmedIndexOpt.has_value())
 	{
 		LOG_TRACE_F("Previous confirmed block missing. Treating {} as orphan.", block);
 		return EBlockStatus::ORPHAN;
 	}
 	
-	if (pPreviousConfirmedIndex->GetHash() != block.GetPreviousHash())
+	if (previousConfirmedIndexOpt->GetHash() != block.GetPreviousHash())
 	{
-		const uint64_t forkPoint = pChainStore->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED)->GetHeight() + 1;
+		const uint64_t forkPoint = pChainStore->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED).GetHeight() + 1;
 
 		LOG_WARNING_F("Fork detected at height {}.", forkPoint);
 
 		// If all previous blocks exist (in orphan pool or in block store), return reorg. Otherwise, orphan until they exist.
 		for (uint64_t i = forkPoint; i < block.GetHeight(); i++)
 		{
-			std::shared_ptr<const BlockIndex> pIndex = pCandidateChain->GetByHeight(i);
-			if (!pOrphanPool->IsOrphan(i, pIndex->GetHash()) && pBlockDB->GetBlock(pIndex->GetHash()) == nullptr)
+			const Hash hash = pCandidateChain->GetHash(i);
+			if (!pOrphanPool->IsOrphan(i, hash) && pBlockDB->GetBlock(hash) == nullptr)
 			{
 				return EBlockStatus::ORPHAN;
 			}
@@ -148,8 +148,8 @@ EBlockStatus BlockProcessor::DetermineBlockStatus(const FullBlock& block, Writer
 	}
 
 	// Orphan if different block a part of confirmed chain.
-	std::shared_ptr<const BlockIndex> pConfirmedIndex = pConfirmedChain->GetByHeight(block.GetHeight());
-	if (nullptr != pConfirmedIndex && pConfirmedIndex->GetHash() != block.GetHash())
+	auto confirmedIndexOpt = pConfirmedChain->GetByHeight(block.GetHeight());
+	if (confirmedIndexOpt.has_value() && confirmedIndexOpt->GetHash() != block.GetHash())
 	{
 		LOG_DEBUG_F("Confirmed block mismatch. Treating {} as orphan.", block);
 
@@ -168,9 +168,9 @@ void BlockProcessor::HandleReorg(const FullBlock& block, Writer<ChainState> pBat
 	auto pConfirmedChain = pChainStore->GetConfirmedChain();
 	auto pTxHashSet = pBatch->GetTxHashSet();
 
-	const uint64_t commonHeight = pChainStore->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED)->GetHeight();
+	const uint64_t commonHeight = pChainStore->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED).GetHeight();
 
-	const Hash& commonHash = pCandidateChain->GetByHeight(commonHeight)->GetHash();
+	const Hash commonHash = pCandidateChain->GetHash(commonHeight);
 	auto pCommonHeader = pBlockDB->GetBlockHeader(commonHash);
 	if (pCommonHeader == nullptr)
 	{
@@ -187,18 +187,20 @@ void BlockProcessor::HandleReorg(const FullBlock& block, Writer<ChainState> pBat
 		throw BLOCK_CHAIN_EXCEPTION("Failed to rewind TxHashSet");
 	}
 
+	pBatch->GetTxHashSetManager()->OnRewind(*pCommonHeader);
+
 	for (uint64_t i = commonHeight + 1; i < block.GetHeight(); i++)
 	{
-		auto pIndex = pCandidateChain->GetByHeight(i);
-		auto pBlock = pOrphanPool->GetOrphanBlock(i, pIndex->GetHash());
+		const Hash hash = pCandidateChain->GetHash(i);
+		auto pBlock = pOrphanPool->GetOrphanBlock(i, hash);
 		if (pBlock == nullptr)
 		{
-			pBlock = pBlockDB->GetBlock(pIndex->GetHash());
+			pBlock = pBlockDB->GetBlock(hash);
 		}
 
 		if (pBlock == nullptr)
 		{
-			LOG_ERROR_F("Failed to find block {}", pIndex->GetHash());
+			LOG_ERROR_F("Failed to find block {}", hash);
 			throw BAD_DATA_EXCEPTION("Missing block");
 		}
 
@@ -28,11 +28,7 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 	}
 
 	// 1. Close Existing TxHashSet
-	{
-		auto pChainState = m_pChainState->BatchWrite();
-		pChainState->GetTxHashSetManager()->Close();
-		pChainState->Commit();
-	}
+	CloseTxHashSet();
 
 	// 2. Load and Extract TxHashSet Zip
 	ITxHashSetPtr pTxHashSet = TxHashSetManager::LoadFromZip(m_config, path, pHeader);
@@ -42,11 +38,59 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 		return false;
 	}
 
+	return ApplyTxHashSet(pTxHashSet, pHeader, false, syncStatus);
+}
+
+ITxHashSetDownloadPtr TxHashSetProcessor::BeginDownload(const Hash& blockHash)
+{
+	auto pHeader = m_pChainState->Read()->GetBlockHeaderByHash(blockHash);
+	if (pHeader == nullptr)
+	{
+		LOG_ERROR_F("Header not found for hash {}.", blockHash);
+		return nullptr;
+	}
+
+	return TxHashSetManager::BeginDownload(m_config, pHeader, m_blockChainServer);
+}
+
+bool TxHashSetProcessor::ProcessDownload(ITxHashSetDownloadPtr pDownload, SyncStatus& syncStatus)
+{
+	BlockHeaderPtr pHeader = pDownload->GetHeader();
+
+	if (!pDownload->Finish())
+	{
+		LOG_ERROR_F("TxHashSet download for {} is incomplete or invalid", *pHeader);
+		return false;
+	}
+
+	// The existing TxHashSet must be closed before its files are replaced.
+	CloseTxHashSet();
+
+	ITxHashSetPtr pTxHashSet = pDownload->Install();
+	if (pTxHashSet == nullptr)
+	{
+		LOG_ERROR_F("Failed to load TxHashSet for {}", *pHeader);
+		return false;
+	}
+
+	// The kernel MMR was validated while the rest of the TxHashSet was downloading.
+	return ApplyTxHashSet(pTxHashSet, pHeader, true, syncStatus);
+}
+
+void TxHashSetProcessor::CloseTxHashSet()
+{
+	auto pChainState = m_pChainState->BatchWrite();
+	pChainState->GetTxHashSetManager()->Close();
+	pChainState->Commit();
+}
+
+bool TxHashSetProcessor::ApplyTxHashSet(ITxHashSetPtr pTxHashSet, BlockHeaderPtr pHeader, const bool kernelsValidated, SyncStatus& syncStatus)
+{
 	// 3. Validate entire TxHashSet
-	auto pBlockSums = pTxHashSet->ValidateTxHashSet(*pHeader, m_blockChainServer, syncStatus);
+	auto pBlockSums = pTxHashSet->ValidateTxHashSet(*pHeader, m_blockChainServer, kernelsValidated, syncStatus);
 	if (pBlockSums == nullptr)
 	{
-		LOG_ERROR_F("Validation of {} failed.", path);
+		LOG_ERROR_F("Validation of TxHashSet for {} failed.", *pHeader);
 		return false;
 	}
 
@@ -79,7 +123,7 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 	LOG_DEBUG("Updating confirmed chain.");
 	if (!UpdateConfirmedChain(pChainStateBatch, *pHeader))
 	{
-		LOG_ERROR_F("Failed to update confirmed chain for {}.", path);
+		LOG_ERROR_F("Failed to update confirmed chain for {}.", *pHeader);
 		pChainStateBatch->GetTxHashSetManager()->Close();
 		return false;
 	}
@@ -94,17 +138,17 @@ bool TxHashSetProcessor::UpdateConfirmedChain(Writer<ChainState> pLockedState, c
 	std::shared_ptr<Chain> pCandidateChain = pLockedState->GetChainStore()->GetCandidateChain();
 	std::shared_ptr<Chain> pConfirmedChain = pLockedState->GetChainStore()->GetConfirmedChain();
 	
-	std::shared_ptr<const BlockIndex> pBlockIndex = pCandidateChain->GetByHeight(blockHeader.GetHeight());
-	if (pBlockIndex->GetHash() != blockHeader.GetHash())
+	auto blockIndexOpt = pCandidateChain->GetByHeight(blockHeader.GetHeight());
+	if (!blockIndexOpt.has_value() || blockIndexOpt->GetHash() != blockHeader.GetHash())
 	{
 		return false;
 	}
 
-	std::shared_ptr<const BlockIndex> pCommonIndex = pLockedState->GetChainStore()->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED);
-	pConfirmedChain->Rewind(pCommonIndex->GetHeight());
+	const BlockIndex commonIndex = pLockedState->GetChainStore()->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED);
+	pConfirmedChain->Rewind(commonIndex.GetHeight());
 
-	uint64_t height = pCommonIndex->GetHeight() + 1;
-	while (height <= pBlockIndex->GetHeight())
+	uint64_t height = commonIndex.GetHeight() + 1;
+	while (height <= blockIndexOpt->GetHeight())
 	{
 		pConfirmedChain->AddBlock(pCandidateChain->GetHash(height));
 		height++;
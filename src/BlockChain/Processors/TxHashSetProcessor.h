@@ -3,6 +3,7 @@
 #include "../ChainState.h"
 
 #include <PMMR/TxHashSet.h>
+#include <PMMR/TxHashSetDownload.h>
 #include <Config/Config.h>
 #include <Crypto/Hash.h>
 #include <P2P/SyncStatus.h>
@@ -21,7 +22,12 @@ public:
 
 	bool ProcessTxHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus);
 
+	ITxHashSetDownloadPtr BeginDownload(const Hash& blockHash);
+	bool ProcessDownload(ITxHashSetDownloadPtr pDownload, SyncStatus& syncStatus);
+
 private:
+	void CloseTxHashSet();
+	bool ApplyTxHashSet(ITxHashSetPtr pTxHashSet, BlockHeaderPtr pHeader, const bool kernelsValidated, SyncStatus& syncStatus);
 	bool UpdateConfirmedChain(Writer<ChainState> pLockedState, const BlockHeader& blockHeader);
 
 	const Config& m_config;
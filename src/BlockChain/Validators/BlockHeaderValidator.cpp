@@ -20,13 +20,11 @@ BlockHeaderValidator::BlockHeaderValidator(
 
 bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
-	// Validate Height
-	if (header.GetHeight() != (previousHeader.GetHeight() + 1))
-	{
-		LOG_WARNING_F("Invalid height for header {}", header);
-		return false;
-	}
+	return IsValidContextFree(m_config, header) && IsValidInContext(header, previousHeader);
+}
 
+bool BlockHeaderValidator::IsValidContextFree(const Config& config, const BlockHeader& header)
+{
 	// Validate Timestamp - Ensure timestamp not too far in the future
 	if (header.GetTimestamp() > Consensus::GetMaxBlockTime(std::chrono::system_clock::now()))
 	{
@@ -35,13 +33,32 @@ bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockH
 	}
 
 	// Validate Version
-	const uint64_t validHeaderVersion = Consensus::GetHeaderVersion(m_config.GetEnvironment().GetEnvironmentType(), header.GetHeight());
+	const uint64_t validHeaderVersion = Consensus::GetHeaderVersion(config.GetEnvironment().GetEnvironmentType(), header.GetHeight());
 	if (header.GetVersion() != validHeaderVersion)
 	{
 		LOG_WARNING_F("Invalid version for header {}", header);
 		return false;
 	}
 
+	// Validate Proof Of Work Cycle
+	if (!PoWManager(config, nullptr).IsCycleValid(header))
+	{
+		LOG_WARNING_F("Invalid Proof of Work for header {}", header);
+		return false;
+	}
+
+	return true;
+}
+
+bool BlockHeaderValidator::IsValidInContext(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	// Validate Height
+	if (header.GetHeight() != (previousHeader.GetHeight() + 1))
+	{
+		LOG_WARNING_F("Invalid height for header {}", header);
+		return false;
+	}
+
 	// Validate Timestamp
 	if (header.GetTimestamp() <= previousHeader.GetTimestamp())
 	{
@@ -49,9 +66,8 @@ bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockH
 		return false;
 	}
 
-	// Validate Proof Of Work
-	const bool validPoW = PoWManager(m_config, m_pBlockDB).IsPoWValid(header, previousHeader);
-	if (!validPoW)
+	// Validate Proof Of Work Difficulty
+	if (!PoWManager(m_config, m_pBlockDB).IsDifficultyValid(header, previousHeader))
 	{
 		LOG_WARNING_F("Invalid Proof of Work for header {}", header);
 		return false;
@@ -14,6 +14,18 @@ public:
 
 	bool IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const;
 
+	//
+	// The checks that only need the header itself: timestamp not too far in the future, version, and the proof of work's cycle.
+	// These are the expensive ones, and can be run on many headers in parallel without holding the chain lock.
+	//
+	static bool IsValidContextFree(const Config& config, const BlockHeader& header);
+
+	//
+	// The checks that need the previous header, the difficulty window, and the header MMR.
+	// IsValidContextFree must already have passed for the header.
+	//
+	bool IsValidInContext(const BlockHeader& header, const BlockHeader& previousHeader) const;
+
 	const Config& m_config;
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
 	std::shared_ptr<const IHeaderMMR> m_pHeaderMMR;
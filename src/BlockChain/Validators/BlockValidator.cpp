@@ -24,16 +24,21 @@ BlockSums BlockValidator::ValidateBlock(const FullBlock& block) const
 
 	// Verify coinbase maturity
 	const uint64_t maximumBlockHeight = Consensus::GetMaxCoinbaseHeight(block.GetHeight());
+	std::vector<Commitment> coinbaseCommitments;
 	for (const TransactionInput& input : block.GetTransactionBody().GetInputs())
 	{
 		if (input.IsCoinbase())
 		{
-			const std::unique_ptr<OutputLocation> pOutputLocation = m_pBlockDB->GetOutputPosition(input.GetCommitment());
-			if (pOutputLocation == nullptr || pOutputLocation->GetBlockHeight() > maximumBlockHeight)
-			{
-				LOG_INFO_F("Coinbase not mature for block {}", block);
-				throw BAD_DATA_EXCEPTION("Failed to validate coinbase maturity.");
-			}
+			coinbaseCommitments.push_back(input.GetCommitment());
+		}
+	}
+
+	for (const std::unique_ptr<OutputLocation>& pOutputLocation : m_pBlockDB->GetOutputPositions(coinbaseCommitments))
+	{
+		if (pOutputLocation == nullptr || pOutputLocation->GetBlockHeight() > maximumBlockHeight)
+		{
+			LOG_INFO_F("Coinbase not mature for block {}", block);
+			throw BAD_DATA_EXCEPTION("Failed to validate coinbase maturity.");
 		}
 	}
 
@@ -16,7 +16,7 @@ ShortId ShortId::Create(const CBigInteger<32>& hash, const CBigInteger<32>& bloc
 	const CBigInteger<32> hashWithNonce = Crypto::Blake2b(serializer.GetBytes());
 
 	// extract k0/k1 from the block_hash
-	ByteBuffer byteBuffer(hashWithNonce.GetData());
+	ByteBuffer byteBuffer(hashWithNonce.data(), hashWithNonce.size());
 	const uint64_t k0 = byteBuffer.ReadU64_LE();
 	const uint64_t k1 = byteBuffer.ReadU64_LE();
 
@@ -1,6 +1,7 @@
 #include <Core/Validation/TransactionBodyValidator.h>
 
 #include <Core/Validation/KernelSignatureValidator.h>
+#include <Core/Validation/VerificationCache.h>
 #include <Core/Exceptions/BadDataException.h>
 #include <Consensus/BlockWeight.h>
 #include <Consensus/Sorting.h>
@@ -79,16 +80,29 @@ void TransactionBodyValidator::VerifyCutThrough(const TransactionBody& transacti
 
 void TransactionBodyValidator::VerifyRangeProofs(const std::vector<TransactionOutput>& outputs)
 {
+	VerificationCache& cache = VerificationCache::GetInstance();
+
 	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
-	std::transform(
-		outputs.cbegin(),
-		outputs.cend(),
-		std::back_inserter(rangeProofs),
-		[](const TransactionOutput& output) { return std::make_pair(output.GetCommitment(), output.GetRangeProof()); }
-	);
+	for (const TransactionOutput& output : outputs)
+	{
+		if (!cache.IsRangeProofVerified(output.GetCommitment(), output.GetRangeProof()))
+		{
+			rangeProofs.emplace_back(std::make_pair(output.GetCommitment(), output.GetRangeProof()));
+		}
+	}
+
+	if (rangeProofs.empty())
+	{
+		return;
+	}
 
 	if (!Crypto::VerifyRangeProofs(rangeProofs))
 	{
 		throw BAD_DATA_EXCEPTION("Range proofs invalid.");
 	}
+
+	for (const std::pair<Commitment, RangeProof>& rangeProof : rangeProofs)
+	{
+		cache.MarkRangeProofVerified(rangeProof.first, rangeProof.second);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include <Core/Validation/VerificationCache.h>
+
+#include <Crypto/Crypto.h>
+
+static const size_t DEFAULT_RANGEPROOF_CAPACITY = 20000;
+static const size_t DEFAULT_KERNEL_CAPACITY = 20000;
+
+VerificationCache& VerificationCache::GetInstance()
+{
+	static VerificationCache instance;
+	return instance;
+}
+
+VerificationCache::VerificationCache()
+	: m_rangeProofs(DEFAULT_RANGEPROOF_CAPACITY), m_kernels(DEFAULT_KERNEL_CAPACITY)
+{
+
+}
+
+void VerificationCache::SetCapacity(const size_t rangeProofCapacity, const size_t kernelCapacity)
+{
+	m_rangeProofs.SetCapacity(rangeProofCapacity);
+	m_kernels.SetCapacity(kernelCapacity);
+}
+
+bool VerificationCache::IsRangeProofVerified(const Commitment& commitment, const RangeProof& rangeProof)
+{
+	return m_rangeProofs.Contains(GetKey(commitment, rangeProof));
+}
+
+void VerificationCache::MarkRangeProofVerified(const Commitment& commitment, const RangeProof& rangeProof)
+{
+	m_rangeProofs.Put(GetKey(commitment, rangeProof), true);
+}
+
+bool VerificationCache::IsKernelVerified(const TransactionKernel& kernel)
+{
+	return m_kernels.Contains(kernel.GetHash());
+}
+
+void VerificationCache::MarkKernelVerified(const TransactionKernel& kernel)
+{
+	m_kernels.Put(kernel.GetHash(), true);
+}
+
+VerificationCache::RangeProofKey VerificationCache::GetKey(const Commitment& commitment, const RangeProof& rangeProof)
+{
+	return RangeProofKey(commitment, Crypto::Blake2b(rangeProof.GetProofBytes()));
+}
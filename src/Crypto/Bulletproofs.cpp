@@ -1,5 +1,6 @@
 #include "Bulletproofs.h"
 #include "Pedersen.h"
+#include "secp256k1-zkp/include/secp256k1.h"
 #include "secp256k1-zkp/include/secp256k1_bulletproofs.h"
 
 #include <Common/Util/FunctionalUtil.h>
@@ -17,20 +18,22 @@ Bulletproofs& Bulletproofs::GetInstance()
 }
 
 Bulletproofs::Bulletproofs()
+	: m_contextPool(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY, SCRATCH_SPACE_SIZE)
 {
-	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-	m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, MAX_GENERATORS);
+	// The generators are read-only once created, so they can be shared by all of the pooled contexts.
+	auto pLease = m_contextPool.Acquire();
+	m_pGenerators = secp256k1_bulletproof_generators_create(pLease->GetContext(), &secp256k1_generator_const_g, MAX_GENERATORS);
 }
 
 Bulletproofs::~Bulletproofs()
 {
-	secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
-	secp256k1_context_destroy(m_pContext);
+	auto pLease = m_contextPool.Acquire();
+	secp256k1_bulletproof_generators_destroy(pLease->GetContext(), m_pGenerators);
 }
 
 bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	auto pLease = m_contextPool.Acquire();
 
 	const size_t numBits = 64;
 	const size_t proofLength = rangeProofs.front().second.GetProofBytes().size();
@@ -42,16 +45,8 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 	bulletproofPointers.reserve(rangeProofs.size());
 	for (const std::pair<Commitment, RangeProof>& rangeProof : rangeProofs)
 	{
-		if (!m_cache.WasAlreadyVerified(rangeProof.first))
-		{
-			commitments.push_back(rangeProof.first);
-			bulletproofPointers.emplace_back(rangeProof.second.GetProofBytes().data());
-		}
-	}
-
-	if (commitments.empty())
-	{
-		return true;
+		commitments.push_back(rangeProof.first);
+		bulletproofPointers.emplace_back(rangeProof.second.GetProofBytes().data());
 	}
 
 	// array of generator multiplied by value in pedersen commitments (cannot be NULL)
@@ -61,31 +56,21 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 		valueGenerators.push_back(secp256k1_generator_const_h);
 	}
 
-	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, commitments);
+	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*pLease->GetContext(), commitments);
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-	const int result = secp256k1_bulletproof_rangeproof_verify_multi(m_pContext, pScratchSpace, m_pGenerators, bulletproofPointers.data(), commitments.size(), proofLength, NULL, commitmentPointers.data(), 1, numBits, valueGenerators.data(), NULL, NULL);
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	const int result = secp256k1_bulletproof_rangeproof_verify_multi(pLease->GetContext(), pLease->GetScratchSpace(), m_pGenerators, bulletproofPointers.data(), commitments.size(), proofLength, NULL, commitmentPointers.data(), 1, numBits, valueGenerators.data(), NULL, NULL);
 
 	Pedersen::CleanupCommitments(commitmentPointers);
 
-	if (result == 1)
-	{
-		for (const Commitment& commitment : commitments)
-		{
-			m_cache.AddToCache(commitment);
-		}
-	}
-
 	return result == 1;
 }
 
 RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretKey& key, const SecretKey& privateNonce, const SecretKey& rewindNonce, const ProofMessage& proofMessage) const
 {
-	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+	auto pLease = m_contextPool.Acquire();
 
 	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
+	const int randomizeResult = secp256k1_context_randomize(pLease->GetContext(), randomSeed.data());
 	if (randomizeResult != 1)
 	{
 		throw CryptoException("secp256k1_context_randomize failed with error: " + std::to_string(randomizeResult));
@@ -94,12 +79,10 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 	std::vector<unsigned char> proofBytes(MAX_PROOF_SIZE, 0);
 	size_t proofLen = MAX_PROOF_SIZE;
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-
 	std::vector<const unsigned char*> blindingFactors({ key.data() });
 	int result = secp256k1_bulletproof_rangeproof_prove(
-		m_pContext,
-		pScratchSpace,
+		pLease->GetContext(),
+		pLease->GetScratchSpace(),
 		m_pGenerators,
 		&proofBytes[0],
 		&proofLen,
@@ -119,7 +102,6 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 		0,
 		proofMessage.data()
 	);
-	secp256k1_scratch_space_destroy(pScratchSpace);
 
 	if (result == 1)
 	{
@@ -132,9 +114,9 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 
 std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(const Commitment& commitment, const RangeProof& rangeProof, const SecretKey& nonce) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	auto pLease = m_contextPool.Acquire();
 
-	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, std::vector<Commitment>({ commitment }));
+	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*pLease->GetContext(), std::vector<Commitment>({ commitment }));
 
 	if (!commitmentPointers.empty())
 	{
@@ -143,7 +125,7 @@ std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(const Commitment& commit
 		std::vector<unsigned char> message(20, 0);
 
 		int result = secp256k1_bulletproof_rangeproof_rewind(
-			m_pContext,
+			pLease->GetContext(),
 			&value,
 			blindingFactorBytes.data(),
 			rangeProof.GetProofBytes().data(),
@@ -1,16 +1,14 @@
 #pragma once
 
-#include "BulletProofsCache.h"
+#include "ContextPool.h"
 
 #include <Crypto/Commitment.h>
 #include <Crypto/RangeProof.h>
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/ProofMessage.h>
 #include <Crypto/RewoundProof.h>
-#include <shared_mutex>
 
 // Forward Declarations
-typedef struct secp256k1_context_struct secp256k1_context;
 struct secp256k1_bulletproof_generators;
 
 class Bulletproofs
@@ -38,8 +36,6 @@ private:
 	Bulletproofs();
 	~Bulletproofs();
 
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
+	mutable ContextPool m_contextPool;
 	secp256k1_bulletproof_generators* m_pGenerators;
-	mutable BulletProofsCache m_cache;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "ContextPool.h"
+#include "secp256k1-zkp/include/secp256k1.h"
+
+#include <Crypto/CryptoException.h>
+
+ContextPool::Entry::Entry(const unsigned int flags, const size_t scratchSpaceSize)
+{
+	pContext = secp256k1_context_create(flags);
+	if (pContext == nullptr)
+	{
+		throw CryptoException("secp256k1_context_create failed");
+	}
+
+	pScratchSpace = secp256k1_scratch_space_create(pContext, scratchSpaceSize);
+	if (pScratchSpace == nullptr)
+	{
+		secp256k1_context_destroy(pContext);
+		throw CryptoException("secp256k1_scratch_space_create failed");
+	}
+}
+
+ContextPool::Entry::~Entry()
+{
+	secp256k1_scratch_space_destroy(pScratchSpace);
+	secp256k1_context_destroy(pContext);
+}
+
+ContextPool::ContextPool(const unsigned int flags, const size_t scratchSpaceSize)
+	: m_flags(flags), m_scratchSpaceSize(scratchSpaceSize), m_numContexts(0)
+{
+
+}
+
+std::unique_ptr<ContextPool::Lease> ContextPool::Acquire()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_idle.empty())
+		{
+			std::unique_ptr<Entry> pEntry = std::move(m_idle.back());
+			m_idle.pop_back();
+			return std::make_unique<Lease>(*this, std::move(pEntry));
+		}
+
+		++m_numContexts;
+	}
+
+	// Context creation is slow (it builds the precomputed tables), so don't hold the lock while doing it.
+	try
+	{
+		return std::make_unique<Lease>(*this, std::make_unique<Entry>(m_flags, m_scratchSpaceSize));
+	}
+	catch (...)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		--m_numContexts;
+		throw;
+	}
+}
+
+size_t ContextPool::GetNumContexts() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_numContexts;
+}
+
+void ContextPool::Release(std::unique_ptr<Entry>&& pEntry)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.push_back(std::move(pEntry));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Forward Declarations
+typedef struct secp256k1_context_struct secp256k1_context;
+typedef struct secp256k1_scratch_space_struct secp256k1_scratch_space;
+
+//
+// A pool of secp256k1 contexts, each paired with its own scratch space.
+// A context is leased to one thread at a time, so callers can randomize it or use its scratch space without locking,
+// and concurrent proving/verifying never serializes on a shared context.
+// Contexts are created on demand and returned to the pool when the lease is destroyed,
+// so the pool only grows to the maximum number of threads using it at once.
+//
+class ContextPool
+{
+	struct Entry
+	{
+		Entry(const unsigned int flags, const size_t scratchSpaceSize);
+		~Entry();
+
+		secp256k1_context* pContext;
+		secp256k1_scratch_space* pScratchSpace;
+	};
+
+public:
+	class Lease
+	{
+	public:
+		Lease(ContextPool& pool, std::unique_ptr<Entry>&& pEntry)
+			: m_pool(pool), m_pEntry(std::move(pEntry)) { }
+		~Lease() { m_pool.Release(std::move(m_pEntry)); }
+
+		Lease(const Lease&) = delete;
+		Lease& operator=(const Lease&) = delete;
+
+		secp256k1_context* GetContext() const { return m_pEntry->pContext; }
+		secp256k1_scratch_space* GetScratchSpace() const { return m_pEntry->pScratchSpace; }
+
+	private:
+		ContextPool& m_pool;
+		std::unique_ptr<Entry> m_pEntry;
+	};
+
+	ContextPool(const unsigned int flags, const size_t scratchSpaceSize);
+
+	ContextPool(const ContextPool&) = delete;
+	ContextPool& operator=(const ContextPool&) = delete;
+
+	std::unique_ptr<Lease> Acquire();
+
+	// Number of contexts created so far.
+	size_t GetNumContexts() const;
+
+private:
+	void Release(std::unique_ptr<Entry>&& pEntry);
+
+	const unsigned int m_flags;
+	const size_t m_scratchSpaceSize;
+
+	mutable std::mutex m_mutex;
+	std::vector<std::unique_ptr<Entry>> m_idle;
+	size_t m_numContexts;
+};
@@ -138,10 +138,8 @@ std::vector<secp256k1_pedersen_commitment*> Pedersen::ConvertCommitments(const s
 	std::vector<secp256k1_pedersen_commitment*> convertedCommitments(commitments.size(), NULL);
 	for (int i = 0; i < commitments.size(); i++)
 	{
-		const std::vector<unsigned char>& commitmentBytes = commitments[i].GetVec();
-
 		secp256k1_pedersen_commitment* pCommitment = new secp256k1_pedersen_commitment();
-		const int parsed = secp256k1_pedersen_commitment_parse(&context, pCommitment, &commitmentBytes[0]);
+		const int parsed = secp256k1_pedersen_commitment_parse(&context, pCommitment, commitments[i].data());
 		convertedCommitments[i] = pCommitment;
 
 		if (parsed != 1)
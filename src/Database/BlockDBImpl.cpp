@@ -3,12 +3,18 @@
 #include <Database/DatabaseException.h>
 #include <Infrastructure/Logger.h>
 #include <Common/Util/StringUtil.h>
-#include <caches/Cache.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/convenience.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
+#include <algorithm>
 #include <utility>
 #include <string>
 #include <filesystem.h>
 
-FIFOCache<Hash, BlockHeaderPtr> BLOCK_HEADERS_CACHE(128);
+// The header cache's hit rate is logged after every this many lookups.
+static const uint64_t HEADER_CACHE_STATS_INTERVAL = 100000;
 
 BlockDB::BlockDB(
 	const Config& config,
@@ -29,7 +35,8 @@ BlockDB::BlockDB(
 	m_pHeaderHandle(pHeaderHandle),
 	m_pBlockSumsHandle(pBlockSumsHandle),
 	m_pOutputPosHandle(pOutputPosHandle),
-	m_pInputBitmapHandle(pInputBitmapHandle)
+	m_pInputBitmapHandle(pInputBitmapHandle),
+	m_headerCache(config.GetNodeConfig().GetDatabase().GetHeaderCacheSize())
 {
 
 }
@@ -44,6 +51,100 @@ BlockDB::~BlockDB()
 	delete m_pDatabase;
 }
 
+static CompressionType ParseCompression(const std::string& columnName, const std::string& compression)
+{
+	CompressionType type = kNoCompression;
+	if (compression == "SNAPPY")
+	{
+		type = kSnappyCompression;
+	}
+	else if (compression == "ZLIB")
+	{
+		type = kZlibCompression;
+	}
+	else if (compression == "LZ4")
+	{
+		type = kLZ4Compression;
+	}
+	else if (compression == "ZSTD")
+	{
+		type = kZSTD;
+	}
+	else if (compression != "NONE")
+	{
+		LOG_WARNING_F("Unknown compression {} for column {}. Compression disabled.", compression, columnName);
+		return kNoCompression;
+	}
+
+	// RocksDB refuses to open a column family whose compression library wasn't linked in.
+	const std::vector<CompressionType> supported = GetSupportedCompressions();
+	if (type != kNoCompression && std::find(supported.cbegin(), supported.cend(), type) == supported.cend())
+	{
+		LOG_WARNING_F("Compression {} is not supported by this build. Column {} will not be compressed.", compression, columnName);
+		return kNoCompression;
+	}
+
+	return type;
+}
+
+static ColumnFamilyDescriptor CreateColumnDescriptor(
+	const std::string& name,
+	const ColumnFamilyConfig& columnConfig,
+	const std::shared_ptr<Cache>& pSharedCache)
+{
+	// Every column is read by key, so keep the hash index and memtable bloom that OptimizeForPointLookup used.
+	BlockBasedTableOptions tableOptions;
+	tableOptions.data_block_index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+	tableOptions.data_block_hash_table_util_ratio = 0.75;
+
+	if (columnConfig.GetBlockCacheMB() > 0)
+	{
+		tableOptions.block_cache = NewLRUCache((size_t)columnConfig.GetBlockCacheMB() * 1024 * 1024);
+	}
+	else
+	{
+		tableOptions.block_cache = pSharedCache;
+	}
+
+	if (columnConfig.GetBloomBitsPerKey() > 0)
+	{
+		tableOptions.filter_policy.reset(NewBloomFilterPolicy((int)columnConfig.GetBloomBitsPerKey(), false));
+		tableOptions.whole_key_filtering = columnConfig.IsWholeKeyFiltering();
+	}
+
+	// Index and filter blocks are charged to the cache, so the cache size bounds the DB's memory.
+	// The L0 ones are pinned, since every lookup checks every L0 file.
+	tableOptions.cache_index_and_filter_blocks = true;
+	tableOptions.cache_index_and_filter_blocks_with_high_priority = true;
+	tableOptions.pin_l0_filter_and_index_blocks_in_cache = columnConfig.IsPinL0FilterAndIndex();
+
+	ColumnFamilyOptions options;
+	options.table_factory.reset(NewBlockBasedTableFactory(tableOptions));
+	options.compression = ParseCompression(name, columnConfig.GetCompression());
+	options.write_buffer_size = (size_t)columnConfig.GetWriteBufferMB() * 1024 * 1024;
+	options.memtable_prefix_bloom_size_ratio = 0.02;
+	options.memtable_whole_key_filtering = columnConfig.IsWholeKeyFiltering();
+
+	if (columnConfig.GetBloomPrefixLength() > 0)
+	{
+		options.prefix_extractor.reset(NewFixedPrefixTransform(columnConfig.GetBloomPrefixLength()));
+	}
+
+	LOG_INFO_F(
+		"Column {}: cache={}, compression={}, bloom_bits={}, bloom_prefix={}, whole_key={}, pin_l0={}, write_buffer={}MB",
+		name,
+		columnConfig.GetBlockCacheMB() > 0 ? std::to_string(columnConfig.GetBlockCacheMB()) + "MB" : "shared",
+		options.compression == kNoCompression ? "NONE" : columnConfig.GetCompression(),
+		columnConfig.GetBloomBitsPerKey(),
+		columnConfig.GetBloomPrefixLength(),
+		columnConfig.IsWholeKeyFiltering(),
+		columnConfig.IsPinL0FilterAndIndex(),
+		columnConfig.GetWriteBufferMB()
+	);
+
+	return ColumnFamilyDescriptor(name, options);
+}
+
 std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 {
 	Options options;
@@ -57,11 +158,15 @@ std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 	std::string dbPath = config.GetNodeConfig().GetDatabasePath().u8string() + "CHAIN/";
 	fs::create_directories(FileUtil::ToPath(dbPath));
 
-	ColumnFamilyDescriptor BLOCK_COLUMN = ColumnFamilyDescriptor("BLOCK", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor HEADER_COLUMN = ColumnFamilyDescriptor("HEADER", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor BLOCK_SUMS_COLUMN = ColumnFamilyDescriptor("BLOCK_SUMS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
+	const DatabaseConfig& databaseConfig = config.GetNodeConfig().GetDatabase();
+	LOG_INFO_F("Opening BlockDB with a {}MB shared block cache", databaseConfig.GetSharedCacheMB());
+	std::shared_ptr<Cache> pSharedCache = NewLRUCache((size_t)databaseConfig.GetSharedCacheMB() * 1024 * 1024);
+
+	ColumnFamilyDescriptor BLOCK_COLUMN = CreateColumnDescriptor("BLOCK", databaseConfig.GetBlock(), pSharedCache);
+	ColumnFamilyDescriptor HEADER_COLUMN = CreateColumnDescriptor("HEADER", databaseConfig.GetHeader(), pSharedCache);
+	ColumnFamilyDescriptor BLOCK_SUMS_COLUMN = CreateColumnDescriptor("BLOCK_SUMS", databaseConfig.GetBlockSums(), pSharedCache);
+	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = CreateColumnDescriptor("OUTPUT_POS", databaseConfig.GetOutputPos(), pSharedCache);
+	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = CreateColumnDescriptor("INPUT_BITMAP", databaseConfig.GetInputBitmap(), pSharedCache);
 
 	std::vector<std::string> columnFamilies;
 	Status status = OptimisticTransactionDB::ListColumnFamilies(options, dbPath, &columnFamilies);
@@ -139,9 +244,10 @@ void BlockDB::Commit()
 		throw DATABASE_EXCEPTION("Transaction::Commit Failed with error: " + std::string(status.getState()));
 	}
 
-	for (auto pHeader : m_uncommitted)
+	std::unique_lock<std::mutex> lock(m_uncommittedMutex);
+	for (auto& entry : m_uncommitted)
 	{
-		BLOCK_HEADERS_CACHE.Put(pHeader->GetHash(), pHeader);
+		m_headerCache.Put(entry.first, entry.second);
 	}
 
 	m_uncommitted.clear();
@@ -149,7 +255,11 @@ void BlockDB::Commit()
 
 void BlockDB::Rollback()
 {
-	m_uncommitted.clear();
+	{
+		std::unique_lock<std::mutex> lock(m_uncommittedMutex);
+		m_uncommitted.clear();
+	}
+
 	const Status status = m_pTransaction->Rollback();
 	if (!status.ok())
 	{
@@ -197,9 +307,35 @@ BlockHeaderPtr BlockDB::GetBlockHeader(const Hash& hash) const
 {
 	try
 	{
-		if (BLOCK_HEADERS_CACHE.Cached(hash))
+		if (m_pTransaction != nullptr)
 		{
-			return BLOCK_HEADERS_CACHE.Get(hash);
+			std::unique_lock<std::mutex> lock(m_uncommittedMutex);
+			auto iter = m_uncommitted.find(hash);
+			if (iter != m_uncommitted.end())
+			{
+				return iter->second;
+			}
+		}
+
+		BlockHeaderPtr pHeader = nullptr;
+		const bool cached = m_headerCache.Get(hash, pHeader);
+
+		const uint64_t lookups = m_headerCache.GetHits() + m_headerCache.GetMisses();
+		if (lookups % HEADER_CACHE_STATS_INTERVAL == 0)
+		{
+			LOG_DEBUG_F(
+				"Header cache: {} of {} lookups hit ({}%), {}/{} headers cached",
+				m_headerCache.GetHits(),
+				lookups,
+				m_headerCache.GetHits() * 100 / lookups,
+				m_headerCache.GetSize(),
+				m_headerCache.GetCapacity()
+			);
+		}
+
+		if (cached)
+		{
+			return pHeader;
 		}
 
 		Slice key((const char*)hash.data(), hash.size());
@@ -210,7 +346,9 @@ BlockHeaderPtr BlockDB::GetBlockHeader(const Hash& hash) const
 		{
 			std::vector<unsigned char> data(value.data(), value.data() + value.size());
 			ByteBuffer byteBuffer(std::move(data));
-			return std::make_unique<const BlockHeader>(BlockHeader::Deserialize(byteBuffer));
+			pHeader = std::make_shared<const BlockHeader>(BlockHeader::Deserialize(byteBuffer));
+			CacheHeader(pHeader);
+			return pHeader;
 		}
 		else if (status.IsNotFound())
 		{
@@ -253,15 +391,8 @@ void BlockDB::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 			LOG_ERROR_F("DB::Put failed for header ({}) with error ({})", hash, status.getState());
 			throw DATABASE_EXCEPTION("DB::Put Failed with error: " + std::string(status.getState()));
 		}
-		
-		if (m_pTransaction != nullptr)
-		{
-			m_uncommitted.push_back(pBlockHeader);
-		}
-		else
-		{
-			BLOCK_HEADERS_CACHE.Put(pBlockHeader->GetHash(), pBlockHeader);
-		}
+
+		CacheHeader(pBlockHeader);
 	}
 	catch (DatabaseException&)
 	{
@@ -297,6 +428,8 @@ void BlockDB::AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders)
 				LOG_ERROR_F("WriteBatch::put failed for header ({}) with error ({})", *pBlockHeader, status.getState());
 				throw DATABASE_EXCEPTION("WriteBatch::put failed with error: " + std::string(status.getState()));
 			}
+
+			CacheHeader(pBlockHeader);
 		}
 	}
 	catch (DatabaseException&)
@@ -312,10 +445,24 @@ void BlockDB::AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders)
 	LOG_TRACE("Finished adding headers.");
 }
 
+void BlockDB::CacheHeader(BlockHeaderPtr pHeader) const
+{
+	// A header read or written in a transaction might not exist once the transaction is rolled back.
+	if (m_pTransaction != nullptr)
+	{
+		std::unique_lock<std::mutex> lock(m_uncommittedMutex);
+		m_uncommitted[pHeader->GetHash()] = pHeader;
+	}
+	else
+	{
+		m_headerCache.Put(pHeader->GetHash(), pHeader);
+	}
+}
+
 void BlockDB::AddBlock(const FullBlock& block)
 {
 	LOG_TRACE("Adding block");
-	const std::vector<unsigned char>& hash = block.GetHash().GetData();
+	const Hash hash = block.GetHash();
 
 	Serializer serializer;
 	block.Serialize(serializer);
@@ -424,6 +571,84 @@ std::unique_ptr<OutputLocation> BlockDB::GetOutputPosition(const Commitment& out
 	return pOutputPosition;
 }
 
+void BlockDB::AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>& outputPositions)
+{
+	if (outputPositions.empty())
+	{
+		return;
+	}
+
+	// Output positions are only ever written while holding the chain's write lock, so there are no conflicts for the transaction to track.
+	WriteBatch batch;
+	Serializer serializer;
+	for (const auto& outputPosition : outputPositions)
+	{
+		Slice key((const char*)outputPosition.first.data(), 32);
+
+		serializer.Clear();
+		outputPosition.second.Serialize(serializer);
+		Slice value((const char*)serializer.data(), serializer.size());
+
+		const Status status = m_pTransaction != nullptr ? m_pTransaction->PutUntracked(m_pOutputPosHandle, key, value) : batch.Put(m_pOutputPosHandle, key, value);
+		if (!status.ok())
+		{
+			LOG_ERROR_F("Failed to save location for output {}", outputPosition.first);
+			throw DATABASE_EXCEPTION("Failed to save output location.");
+		}
+	}
+
+	if (m_pTransaction == nullptr)
+	{
+		const Status status = m_pDatabase->Write(WriteOptions(), &batch);
+		if (!status.ok())
+		{
+			LOG_ERROR_F("Failed to save {} output locations with error ({})", outputPositions.size(), status.getState());
+			throw DATABASE_EXCEPTION("Failed to save output locations.");
+		}
+	}
+}
+
+std::vector<std::unique_ptr<OutputLocation>> BlockDB::GetOutputPositions(const std::vector<Commitment>& outputCommitments) const
+{
+	std::vector<std::unique_ptr<OutputLocation>> outputPositions(outputCommitments.size());
+	if (outputCommitments.empty())
+	{
+		return outputPositions;
+	}
+
+	std::vector<Slice> keys;
+	keys.reserve(outputCommitments.size());
+	for (const Commitment& outputCommitment : outputCommitments)
+	{
+		keys.emplace_back(Slice((const char*)outputCommitment.data(), 32));
+	}
+
+	// Read from DB
+	const std::vector<ColumnFamilyHandle*> handles(keys.size(), m_pOutputPosHandle);
+	std::vector<std::string> values;
+	const std::vector<Status> statuses = m_pTransaction != nullptr ?
+		m_pTransaction->MultiGet(ReadOptions(), handles, keys, &values) :
+		m_pDatabase->MultiGet(ReadOptions(), handles, keys, &values);
+
+	for (size_t i = 0; i < statuses.size(); i++)
+	{
+		if (statuses[i].ok())
+		{
+			// Deserialize result
+			std::vector<unsigned char> data(values[i].data(), values[i].data() + values[i].size());
+			ByteBuffer byteBuffer(std::move(data));
+			outputPositions[i] = std::make_unique<OutputLocation>(OutputLocation::Deserialize(byteBuffer));
+		}
+		else if (!statuses[i].IsNotFound())
+		{
+			LOG_ERROR_F("DB::MultiGet failed for output ({}) with error ({})", outputCommitments[i], statuses[i].getState());
+			throw DATABASE_EXCEPTION("DB::MultiGet Failed with error: " + std::string(statuses[i].getState()));
+		}
+	}
+
+	return outputPositions;
+}
+
 void BlockDB::AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap)
 {
 	try
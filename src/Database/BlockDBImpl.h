@@ -8,8 +8,10 @@
 
 #include <Database/BlockDb.h>
 #include <Config/Config.h>
+#include <Common/ShardedLRUCache.h>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 
 using namespace rocksdb;
 
@@ -41,6 +43,8 @@ public:
 
 	virtual void AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location) override final;
 	virtual std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment& outputCommitment) const override final;
+	virtual void AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>& outputPositions) override final;
+	virtual std::vector<std::unique_ptr<OutputLocation>> GetOutputPositions(const std::vector<Commitment>& outputCommitments) const override final;
 
 	virtual void AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap) override final;
 	virtual std::unique_ptr<Roaring> GetBlockInputBitmap(const Hash& blockHash) const override final;
@@ -72,5 +76,11 @@ private:
 	ColumnFamilyHandle* m_pOutputPosHandle;
 	ColumnFamilyHandle* m_pInputBitmapHandle;
 
-	std::vector<BlockHeaderPtr> m_uncommitted;
+	void CacheHeader(BlockHeaderPtr pHeader) const;
+
+	// Headers written or read in the open transaction. They're only moved into the cache once the transaction is committed.
+	mutable std::mutex m_uncommittedMutex;
+	mutable std::unordered_map<Hash, BlockHeaderPtr> m_uncommitted;
+
+	mutable ShardedLRUCache<Hash, BlockHeaderPtr> m_headerCache;
 };
\ No newline at end of file
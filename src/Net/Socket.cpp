@@ -2,6 +2,7 @@
 #include <Net/SocketException.h>
 #include <Common/Util/ThreadUtil.h>
 #include <Infrastructure/Logger.h>
+#include <future>
 
 static unsigned long DEFAULT_TIMEOUT = 5 * 1000; // 5s
 
@@ -10,12 +11,15 @@ static unsigned long DEFAULT_TIMEOUT = 5 * 1000; // 5s
 #endif
 
 Socket::Socket(const SocketAddress& address)
-	: m_address(address),
-	m_socketOpen(false),
+	: m_socketOpen(false),
+	m_address(address),
 	m_blocking(true),
-	m_receiveBufferSize(0),
 	m_receiveTimeout(DEFAULT_TIMEOUT),
-	m_sendTimeout(DEFAULT_TIMEOUT)
+	m_sendTimeout(DEFAULT_TIMEOUT),
+	m_receiveBufferSize(0),
+	m_bytesQueued(0),
+	m_messagesQueued(0),
+	m_writing(false)
 {
 
 }
@@ -23,103 +27,113 @@ Socket::Socket(const SocketAddress& address)
 Socket::~Socket()
 {
 	m_pSocket.reset();
+	m_pStrand.reset();
 	m_pContext.reset();
 }
 
 bool Socket::Connect(std::shared_ptr<asio::io_context> pContext)
 {
 	m_pContext = pContext;
+	m_pStrand = std::make_unique<asio::io_context::strand>(*pContext);
 	asio::ip::tcp::endpoint endpoint(asio::ip::address(asio::ip::address_v4::from_string(m_address.GetIPAddress().Format())), m_address.GetPortNumber());
 
 	m_pSocket = std::make_shared<asio::ip::tcp::socket>(*pContext);
-	m_pSocket->async_connect(endpoint, [this](const asio::error_code & ec)
-		{
-			m_errorCode = ec;
-			if (!ec)
-            {
-                asio::socket_base::receive_buffer_size option(32768);
-                m_pSocket->set_option(option);
-                
-				#ifdef _WIN32
-				if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_RCVTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
-				{
-					return false;
-				}
+	std::future<void> connected = m_pSocket->async_connect(endpoint, asio::use_future);
+	if (connected.wait_for(std::chrono::milliseconds(DEFAULT_TIMEOUT)) != std::future_status::ready)
+	{
+		// Cancel the attempt, and give the handler a chance to complete before the socket can be destroyed.
+		std::shared_ptr<asio::ip::tcp::socket> pSocket = m_pSocket;
+		asio::post(*m_pStrand, [pSocket]() { asio::error_code ignoreError; pSocket->close(ignoreError); });
+		connected.wait_for(std::chrono::milliseconds(DEFAULT_TIMEOUT));
+		return false;
+	}
 
-				if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_SNDTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
-				{
-					return false;
-				}
-				#endif
+	try
+	{
+		connected.get();
+	}
+	catch (const std::system_error& e)
+	{
+		SetError(e.code());
+		asio::error_code ignoreError;
+		m_pSocket->close(ignoreError);
+		return false;
+	}
 
-				m_address = SocketAddress(m_address.GetIPAddress(), m_pSocket->remote_endpoint().port());
-				m_socketOpen = true;
-				return true;
-			}
-			else
-			{
-				asio::error_code ignoreError;
-				m_pSocket->close(ignoreError);
-				return false;
-			}
-		}
-	);
+	asio::error_code error;
+	asio::socket_base::receive_buffer_size option(32768);
+	m_pSocket->set_option(option, error);
+	SetError(error);
 
-	pContext->run();
+	#ifdef _WIN32
+	if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_RCVTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
+	{
+		return false;
+	}
 
-	auto timeout = std::chrono::system_clock::now() + std::chrono::seconds(1);
-	while (!m_errorCode && !m_socketOpen && std::chrono::system_clock::now() < timeout)
+	if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_SNDTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
 	{
-		ThreadUtil::SleepFor(std::chrono::milliseconds(10), false);
+		return false;
 	}
+	#endif
 
-	return m_socketOpen;
+	m_address = SocketAddress(m_address.GetIPAddress(), m_pSocket->remote_endpoint(error).port());
+	SetError(error);
+	m_socketOpen = true;
+	return true;
 }
 
 bool Socket::Accept(std::shared_ptr<asio::io_context> pContext, asio::ip::tcp::acceptor& acceptor, const std::atomic_bool& terminate)
 {
 	m_pContext = pContext;
+	m_pStrand = std::make_unique<asio::io_context::strand>(*pContext);
 	m_pSocket = std::make_shared<asio::ip::tcp::socket>(*pContext);
-	acceptor.async_accept(*m_pSocket, [this, pContext](const asio::error_code & ec)
+
+	// If terminated before a connection arrives, the accept is still outstanding, so the handler must keep the socket alive.
+	std::shared_ptr<Socket> pSocket = shared_from_this();
+	acceptor.async_accept(*m_pSocket, [pSocket](const asio::error_code & ec)
 		{
-			m_errorCode = ec;
+			pSocket->SetError(ec);
 			if (!ec)
 			{
-				if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_RCVTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
+				#ifdef _WIN32
+				if (setsockopt(pSocket->m_pSocket->native_handle(), SOL_SOCKET, SO_RCVTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
 				{
 					return false;
 				}
 
-				if (setsockopt(m_pSocket->native_handle(), SOL_SOCKET, SO_SNDTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
+				if (setsockopt(pSocket->m_pSocket->native_handle(), SOL_SOCKET, SO_SNDTIMEO, (char*)& DEFAULT_TIMEOUT, sizeof(DEFAULT_TIMEOUT)) == SOCKET_ERROR)
 				{
 					return false;
 				}
+				#endif
 
-				const std::string address = m_pSocket->remote_endpoint().address().to_string();
-				m_address = SocketAddress(address, m_pSocket->remote_endpoint().port());
-				m_socketOpen = true;
+				const std::string address = pSocket->m_pSocket->remote_endpoint().address().to_string();
+				pSocket->m_address = SocketAddress(address, pSocket->m_pSocket->remote_endpoint().port());
+				pSocket->m_socketOpen = true;
 				return true;
 			}
 			else
 			{
 				asio::error_code ignoreError;
-				m_pSocket->close(ignoreError);
+				pSocket->m_pSocket->close(ignoreError);
 				return false;
 			}
 		}
 	);
 
-	while (!m_errorCode && !m_socketOpen)
+	asio::io_context& acceptorContext = static_cast<asio::io_context&>(acceptor.get_executor().context());
+	while (!GetError() && !m_socketOpen)
 	{
 		if (terminate)
 		{
 			break;
 		}
 
-		pContext->run_one_for(std::chrono::milliseconds(100));
+		acceptorContext.run_one_for(std::chrono::milliseconds(100));
 	}
 
-	pContext->reset();
+	acceptorContext.restart();
 
 	return m_socketOpen;
 }
@@ -128,13 +142,24 @@ bool Socket::CloseSocket()
 {
 	m_socketOpen = false;
 
-	asio::error_code error;
-	m_pSocket->shutdown(asio::socket_base::shutdown_both, error);
-	if (!error)
 	{
-		m_pSocket->close(error);
+		std::unique_lock<std::mutex> lock(m_sendMutex);
+		m_sendCondition.notify_all();
 	}
 
+	if (m_pSocket == nullptr)
+	{
+		return true;
+	}
+
+	// Shutting down completes any outstanding reads and writes.
+	// The close itself is done on the strand, since other operations on the socket may be in progress.
+	asio::error_code error;
+	m_pSocket->shutdown(asio::socket_base::shutdown_both, error);
+
+	std::shared_ptr<asio::ip::tcp::socket> pSocket = m_pSocket;
+	asio::post(*m_pStrand, [pSocket]() { asio::error_code ignoreError; pSocket->close(ignoreError); });
+
 	return !error;
 }
 
@@ -145,19 +170,20 @@ bool Socket::IsSocketOpen() const
 
 bool Socket::IsActive() const
 {
-	if (m_socketOpen && !m_errorCode)
+	const asio::error_code error = GetError();
+	if (m_socketOpen && !error)
 	{
 		return true;
 	}
 
-	if (m_errorCode.value() == EAGAIN)
+	if (error.value() == EAGAIN)
 	{
 		return true;
 	}
 
-	if (m_errorCode)
+	if (error)
 	{
-		LOG_INFO_F("Connection with ({}) not active. Error: {}", m_address, m_errorCode.message());
+		LOG_INFO_F("Connection with ({}) not active. Error: {}", m_address, error.message());
 	}
 	
 	return false;
@@ -257,13 +283,152 @@ bool Socket::Send(const std::vector<unsigned char>& message, const bool incremen
 		m_rateCounter.AddMessageSent();
 	}
 
-	const size_t bytesWritten = asio::write(*m_pSocket, asio::buffer(message.data(), message.size()), m_errorCode);
-	if (m_errorCode && m_errorCode.value() != EAGAIN)
+	return SendBatch(std::vector<unsigned char>(message), 1);
+}
+
+bool Socket::SendBatch(std::vector<unsigned char>&& bytes, const size_t numMessages)
+{
+	std::unique_lock<std::mutex> lock(m_sendMutex);
+	const bool ready = m_sendCondition.wait_for(
+		lock,
+		std::chrono::milliseconds(m_sendTimeout),
+		[this] { return m_writeError || !m_socketOpen || m_bytesQueued < MAX_BYTES_QUEUED; }
+	);
+
+	if (m_writeError || !m_socketOpen)
 	{
 		throw SocketException();
 	}
 
-	return bytesWritten == message.size();
+	if (!ready)
+	{
+		return false;
+	}
+
+	m_bytesQueued += bytes.size();
+	m_messagesQueued += numMessages;
+	m_sendQueue.push_back(QueuedWrite{ std::move(bytes), numMessages });
+
+	if (!m_writing)
+	{
+		m_writing = true;
+
+		std::shared_ptr<Socket> pSocket = shared_from_this();
+		asio::post(*m_pStrand, [pSocket]() { pSocket->WriteNext(); });
+	}
+
+	return true;
+}
+
+std::vector<unsigned char> Socket::TakeSpareBuffer()
+{
+	std::unique_lock<std::mutex> lock(m_sendMutex);
+
+	std::vector<unsigned char> buffer;
+	buffer.swap(m_spareBuffer);
+	return buffer;
+}
+
+void Socket::SetError(const asio::error_code& error)
+{
+	if (error)
+	{
+		std::unique_lock<std::mutex> lock(m_sendMutex);
+		if (!m_errorCode || m_errorCode.value() == EAGAIN)
+		{
+			m_errorCode = error;
+		}
+	}
+}
+
+asio::error_code Socket::GetError() const
+{
+	std::unique_lock<std::mutex> lock(m_sendMutex);
+	return m_errorCode;
+}
+
+size_t Socket::GetMessagesQueued() const
+{
+	std::unique_lock<std::mutex> lock(m_sendMutex);
+	return m_messagesQueued;
+}
+
+size_t Socket::GetBytesQueued() const
+{
+	std::unique_lock<std::mutex> lock(m_sendMutex);
+	return m_bytesQueued;
+}
+
+//
+// Writes everything in the send queue (up to MAX_BUFFERS_PER_WRITE buffers) with a single gathering write,
+// and continues with whatever was queued in the meantime when it completes.
+// Runs on the strand, so only one write is ever in progress.
+//
+void Socket::WriteNext()
+{
+	std::vector<asio::const_buffer> buffers;
+	{
+		std::unique_lock<std::mutex> lock(m_sendMutex);
+		if (m_sendQueue.empty())
+		{
+			m_writing = false;
+			return;
+		}
+
+		// Elements of a deque aren't moved by push_back, so the buffers stay valid while Send queues more messages.
+		const size_t numBuffers = (std::min)(m_sendQueue.size(), (size_t)MAX_BUFFERS_PER_WRITE);
+		buffers.reserve(numBuffers);
+		for (size_t i = 0; i < numBuffers; i++)
+		{
+			buffers.push_back(asio::buffer(m_sendQueue[i].bytes));
+		}
+	}
+
+	std::shared_ptr<Socket> pSocket = shared_from_this();
+	const size_t numBuffers = buffers.size();
+	asio::async_write(*m_pSocket, buffers, asio::bind_executor(*m_pStrand,
+		[pSocket, numBuffers](const asio::error_code& ec, const size_t)
+		{
+			{
+				std::unique_lock<std::mutex> lock(pSocket->m_sendMutex);
+				if (ec)
+				{
+					pSocket->m_writeError = ec;
+					pSocket->m_errorCode = ec;
+					pSocket->m_sendQueue.clear();
+					pSocket->m_bytesQueued = 0;
+					pSocket->m_messagesQueued = 0;
+					pSocket->m_writing = false;
+				}
+				else
+				{
+					for (size_t i = 0; i < numBuffers; i++)
+					{
+						QueuedWrite& written = pSocket->m_sendQueue.front();
+						pSocket->m_bytesQueued -= written.bytes.size();
+						pSocket->m_messagesQueued -= written.numMessages;
+
+						// Keep the largest written buffer (within reason) for TakeSpareBuffer to hand out again.
+						const size_t capacity = written.bytes.capacity();
+						if (capacity > pSocket->m_spareBuffer.capacity() && capacity <= MAX_SPARE_BUFFER_CAPACITY)
+						{
+							written.bytes.clear();
+							pSocket->m_spareBuffer.swap(written.bytes);
+						}
+
+						pSocket->m_sendQueue.pop_front();
+					}
+				}
+			}
+
+			pSocket->m_sendCondition.notify_all();
+
+			if (!ec)
+			{
+				pSocket->WriteNext();
+			}
+		}
+	));
 }
 
 bool Socket::Receive(const size_t numBytes, const bool incrementCount, std::vector<unsigned char>& data)
@@ -277,8 +442,10 @@ bool Socket::Receive(const size_t numBytes, const bool incrementCount, std::vect
 	size_t bytesRead = 0;
 	while (numTries++ < 3)
 	{
-		bytesRead += asio::read(*m_pSocket, asio::buffer(data.data() + bytesRead, numBytes - bytesRead), m_errorCode);
-		if (m_errorCode && m_errorCode.value() != EAGAIN)
+		asio::error_code error;
+		bytesRead += asio::read(*m_pSocket, asio::buffer(data.data() + bytesRead, numBytes - bytesRead), error);
+		SetError(error);
+		if (error && error.value() != EAGAIN)
 		{
 			throw SocketException();
 		}
@@ -292,7 +459,7 @@ bool Socket::Receive(const size_t numBytes, const bool incrementCount, std::vect
 
 			return true;
 		}
-		else if (m_errorCode.value() == EAGAIN)
+		else if (error.value() == EAGAIN)
 		{
 			LOG_DEBUG("EAGAIN error returned. Pausing briefly, and then trying again.");
 			std::this_thread::sleep_for(std::chrono::milliseconds(2));
@@ -304,11 +471,38 @@ bool Socket::Receive(const size_t numBytes, const bool incrementCount, std::vect
 
 bool Socket::HasReceivedData()
 {
-	const size_t available = m_pSocket->available(m_errorCode);
-	if (m_errorCode && m_errorCode.value() != EAGAIN)
+	asio::error_code error;
+	const size_t available = m_pSocket->available(error);
+	SetError(error);
+	if (error && error.value() != EAGAIN)
 	{
 		throw SocketException();
 	}
 	
 	return available >= 11;
-}
\ No newline at end of file
+}
+
+void Socket::AsyncReceive(const size_t numBytes, const bool incrementCount, ReceiveCallback callback)
+{
+	std::shared_ptr<Socket> pSocket = shared_from_this();
+	auto pBuffer = std::make_shared<std::vector<unsigned char>>(numBytes);
+
+	asio::post(*m_pStrand, [pSocket, pBuffer, incrementCount, callback]()
+	{
+		asio::async_read(*pSocket->m_pSocket, asio::buffer(*pBuffer), asio::bind_executor(*pSocket->m_pStrand,
+			[pSocket, pBuffer, incrementCount, callback](const asio::error_code& ec, const size_t)
+			{
+				if (ec)
+				{
+					pSocket->SetError(ec);
+				}
+				else if (incrementCount)
+				{
+					pSocket->m_rateCounter.AddMessageReceived();
+				}
+
+				callback(ec, std::move(*pBuffer));
+			}
+		));
+	});
+}
@@ -8,10 +8,9 @@
 #include "Seed/HandShake.h"
 
 #include <Net/SocketException.h>
-#include <Common/Util/ThreadUtil.h>
-#include <Infrastructure/ThreadManager.h>
+#include <Core/Exceptions/DeserializationException.h>
+#include <Infrastructure/ShutdownManager.h>
 #include <Infrastructure/Logger.h>
-#include <thread>
 #include <chrono>
 #include <memory>
 
@@ -25,7 +24,8 @@ Connection::Connection(
 	std::shared_ptr<HandShake> pHandShake,
 	std::shared_ptr<MessageProcessor> pMessageProcessor,
 	std::shared_ptr<MessageRetriever> pMessageRetriever,
-	std::shared_ptr<MessageSender> pMessageSender)
+	std::shared_ptr<MessageSender> pMessageSender,
+	ReactorPtr pReactor)
 	: m_pSocket(pSocket),
 	m_connectionId(connectionId),
 	m_connectionManager(connectionManager),
@@ -36,7 +36,11 @@ Connection::Connection(
 	m_pMessageProcessor(pMessageProcessor),
 	m_pMessageRetriever(pMessageRetriever),
 	m_pMessageSender(pMessageSender),
-	m_terminate(false)
+	m_pReactor(pReactor),
+	m_strand(pReactor->GetWorkerContext()),
+	m_timer(*pReactor->GetIOContext()),
+	m_terminate(false),
+	m_flushPending(false)
 {
 
 }
@@ -49,9 +53,8 @@ Connection::~Connection()
 void Connection::Disconnect()
 {
 	m_terminate = true;
-	ThreadUtil::Join(m_connectionThread);
 	m_connectedPeer.GetPeer()->SetConnected(false);
-	m_pSocket.reset();
+	m_pSocket->CloseSocket();
 }
 
 std::shared_ptr<Connection> Connection::Create(
@@ -87,10 +90,10 @@ std::shared_ptr<Connection> Connection::Create(
 		pHandShake,
 		pMessageProcessor,
 		pMessageRetriever,
-		pMessageSender
+		pMessageSender,
+		connectionManager.GetReactor()
 	));
-	pConnection->m_connectionThread = std::thread(Thread_ProcessConnection, pConnection);
-	ThreadManagerAPI::SetThreadName(pConnection->m_connectionThread.get_id(), "PEER");
+	pConnection->m_pReactor->GetHandshakePool().Submit([pConnection]() { pConnection->Connect(); });
 	return pConnection;
 }
 
@@ -107,6 +110,23 @@ bool Connection::IsConnectionActive() const
 void Connection::Send(const IMessage& message)
 {
 	m_sendQueue.push_back(message.Clone());
+
+	// Only one flush needs to be pending, since it sends everything queued by the time it runs.
+	if (!m_flushPending.exchange(true))
+	{
+		std::shared_ptr<Connection> pConnection = shared_from_this();
+		asio::post(m_strand, [pConnection]() { pConnection->FlushSendQueue(); });
+	}
+}
+
+size_t Connection::GetSendQueueDepth() const
+{
+	return m_sendQueue.size() + m_pSocket->GetMessagesQueued();
+}
+
+size_t Connection::GetBytesInFlight() const
+{
+	return m_pSocket->GetBytesQueued();
 }
 
 bool Connection::ExceedsRateLimit() const
@@ -116,169 +136,261 @@ bool Connection::ExceedsRateLimit() const
 }
 
 //
-// Continuously checks for messages to send and/or receive until the connection is terminated.
-// This function runs in its own thread.
+// Connects to the peer (if outbound) and performs the handshake, then starts reading messages.
+// This function runs on the reactor's handshake pool, since the handshake blocks on the socket.
 //
-void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnection)
+void Connection::Connect()
 {
+	if (ShutdownManagerAPI::WasShutdownRequested())
+	{
+		m_terminate = true;
+		return;
+	}
+
 	try
 	{
 		EDirection direction = EDirection::INBOUND;
-		bool connected = pConnection->GetSocket()->IsSocketOpen();
+		bool connected = m_pSocket->IsSocketOpen();
 		if (!connected)
 		{
-			pConnection->m_pContext = std::make_shared<asio::io_context>();
 			direction = EDirection::OUTBOUND;
-			connected = pConnection->m_pSocket->Connect(pConnection->m_pContext);
+			connected = m_pSocket->Connect(m_pReactor->GetIOContext());
 		}
 
 		bool handshakeSuccess = false;
-		if (connected)
+		if (connected && !m_terminate)
 		{
-			handshakeSuccess = pConnection->m_pHandShake->PerformHandshake(
-				*pConnection->m_pSocket,
-				pConnection->m_connectedPeer,
-				direction
-			);
+			handshakeSuccess = m_pHandShake->PerformHandshake(*m_pSocket, m_connectedPeer, direction);
 		}
 
 		if (handshakeSuccess)
 		{
 			LOG_DEBUG("Successful Handshake");
-			pConnection->m_connectionManager.AddConnection(pConnection);
-			if (pConnection->m_peerManager.Read()->ArePeersNeeded(Capabilities::ECapability::FAST_SYNC_NODE))
+			m_connectionManager.AddConnection(shared_from_this());
+			if (m_peerManager.Read()->ArePeersNeeded(Capabilities::ECapability::FAST_SYNC_NODE))
 			{
-				pConnection->Send(GetPeerAddressesMessage(Capabilities::ECapability::FAST_SYNC_NODE));
+				Send(GetPeerAddressesMessage(Capabilities::ECapability::FAST_SYNC_NODE));
 			}
 		}
 		else
 		{
-			pConnection->m_pSocket->CloseSocket();
-			pConnection->m_terminate = true;
-			ThreadUtil::Detach(pConnection->m_connectionThread);
+			m_pSocket->CloseSocket();
+			m_terminate = true;
 			return;
 		}
 	}
 	catch (...)
 	{
-        LOG_ERROR("Exception caught");
-        pConnection->m_terminate = true;
-		ThreadUtil::Detach(pConnection->m_connectionThread);
+		LOG_ERROR("Exception caught");
+		m_terminate = true;
 		return;
 	}
 
-	pConnection->m_connectedPeer.GetPeer()->SetConnected(true);
+	m_connectedPeer.GetPeer()->SetConnected(true);
 
-	SyncStatusConstPtr pSyncStatus = pConnection->m_pSyncStatus;
+	m_lastPingTime = std::chrono::system_clock::now();
+	m_lastReceivedMessageTime = std::chrono::system_clock::now();
 
-	std::chrono::system_clock::time_point lastPingTime = std::chrono::system_clock::now();
-	std::chrono::system_clock::time_point lastReceivedMessageTime = std::chrono::system_clock::now();
+	ReadHeader();
+	ScheduleTick();
+}
 
-	while (!pConnection->m_terminate && !pConnection->GetPeer()->IsBanned())
+void Connection::ReadHeader()
+{
+	std::shared_ptr<Connection> pConnection = shared_from_this();
+	m_pSocket->AsyncReceive(MessageRetriever::HEADER_SIZE, true, [pConnection](const asio::error_code& ec, std::vector<unsigned char>&& headerBytes)
 	{
-		if (pConnection->ExceedsRateLimit())
+		if (ec || pConnection->m_terminate)
 		{
-			LOG_WARNING_F("Banning peer ({}) for exceeding rate limit.", pConnection->GetIPAddress());
-			pConnection->GetPeer()->Ban(EBanReason::Abusive);
-			break;
+			pConnection->Close();
+			return;
 		}
 
-		auto now = std::chrono::system_clock::now();
-		if (lastPingTime + std::chrono::seconds(10) < now)
+		try
 		{
-			const PingMessage pingMessage(pSyncStatus->GetBlockDifficulty(), pSyncStatus->GetBlockHeight());
-			pConnection->Send(pingMessage);
-
-			lastPingTime = now;
+			const MessageHeader messageHeader = pConnection->m_pMessageRetriever->ParseHeader(std::move(headerBytes), pConnection->m_connectedPeer);
+			pConnection->ReadPayload(messageHeader);
 		}
-
-		try
+		catch (const DeserializationException&)
 		{
-			bool messageSentOrReceived = false;
-
-			// Check for received messages and if there is a new message, process it.
-			std::unique_ptr<RawMessage> pRawMessage = pConnection->m_pMessageRetriever->RetrieveMessage(
-				*pConnection->m_pSocket,
-				pConnection->m_connectedPeer,
-				MessageRetriever::NON_BLOCKING
-			);
+			LOG_ERROR("Deserialization exception occurred");
+			pConnection->Close();
+		}
+	});
+}
 
-			if (pRawMessage != nullptr)
-			{
-				const MessageProcessor::EStatus status = pConnection->m_pMessageProcessor->ProcessMessage(
-					pConnection->m_connectionId,
-					*pConnection->m_pSocket,
-					pConnection->m_connectedPeer,
-					*pRawMessage
-				);
-
-                if (status == MessageProcessor::EStatus::BAN_PEER)
-                {
-					EBanReason banReason = EBanReason::Abusive; // TODO: Determine real reason.
-					LOG_WARNING_F("Banning peer ({}) for ({}).", pConnection->GetIPAddress(), BanReason::Format(banReason));
-					pConnection->GetPeer()->Ban(banReason);
-					break;
-                }
-                
-                lastReceivedMessageTime = std::chrono::system_clock::now();
-				messageSentOrReceived = true;
-			}
+void Connection::ReadPayload(const MessageHeader& messageHeader)
+{
+	std::shared_ptr<Connection> pConnection = shared_from_this();
+	m_pSocket->AsyncReceive(messageHeader.GetMessageLength(), false, [pConnection, messageHeader](const asio::error_code& ec, std::vector<unsigned char>&& payload)
+	{
+		if (ec || pConnection->m_terminate)
+		{
+			pConnection->Close();
+			return;
+		}
 
-			// Send the next message in the queue, if one exists.
-			auto pMessageToSend = pConnection->m_sendQueue.copy_front();
-			if (pMessageToSend != nullptr)
-			{
-				IMessagePtr pMessage = *pMessageToSend;
-				pConnection->m_sendQueue.pop_front(1);
+		pConnection->m_connectedPeer.GetPeer()->UpdateLastContactTime();
 
-				pConnection->m_pMessageSender->Send(*pConnection->m_pSocket, *pMessage);
+		auto pRawMessage = std::make_shared<RawMessage>(MessageHeader(messageHeader), std::move(payload));
+		asio::post(pConnection->m_strand, [pConnection, pRawMessage]() { pConnection->ProcessMessage(pRawMessage); });
+	});
+}
 
-				messageSentOrReceived = true;
-			}
-			
-			if (!messageSentOrReceived)
-			{
-				if ((lastReceivedMessageTime + std::chrono::seconds(30)) < std::chrono::system_clock::now())
-				{
-					break;
-				}
+//
+// Processes the received message, then starts reading the next one.
+// This function runs on the connection's strand.
+//
+void Connection::ProcessMessage(const std::shared_ptr<RawMessage>& pRawMessage)
+{
+	if (m_terminate)
+	{
+		return;
+	}
 
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5), pConnection->m_terminate);
-			}
-		}
-		catch (const DeserializationException&)
+	try
+	{
+		const MessageProcessor::EStatus status = m_pMessageProcessor->ProcessMessage(
+			m_connectionId,
+			*m_pSocket,
+			m_connectedPeer,
+			*pRawMessage
+		);
+
+		if (status == MessageProcessor::EStatus::BAN_PEER)
 		{
-			LOG_ERROR("Deserialization exception occurred");
-			break;
+			EBanReason banReason = EBanReason::Abusive; // TODO: Determine real reason.
+			LOG_WARNING_F("Banning peer ({}) for ({}).", GetIPAddress(), BanReason::Format(banReason));
+			GetPeer()->Ban(banReason);
+			Close();
+			return;
 		}
-		catch (const SocketException&)
-		{
-			#ifdef _WIN32
-			const int lastError = WSAGetLastError();
 
-			TCHAR* s = NULL;
-			FormatMessage(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
-				NULL, lastError, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPTSTR)&s, 0, NULL);
+		m_lastReceivedMessageTime = std::chrono::system_clock::now();
+	}
+	catch (const DeserializationException&)
+	{
+		LOG_ERROR("Deserialization exception occurred");
+		Close();
+		return;
+	}
+	catch (const SocketException&)
+	{
+		#ifdef _WIN32
+		const int lastError = WSAGetLastError();
 
-			const std::string errorMessage = StringUtil::ToUTF8(s);
-			LOG_DEBUG("Socket exception occurred: " + errorMessage);
+		TCHAR* s = NULL;
+		FormatMessage(FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+			NULL, lastError, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPTSTR)&s, 0, NULL);
 
-			LocalFree(s);
-			#endif
-			break;
-		}
-		catch (const std::exception& e)
+		const std::string errorMessage = StringUtil::ToUTF8(s);
+		LOG_DEBUG("Socket exception occurred: " + errorMessage);
+
+		LocalFree(s);
+		#endif
+		Close();
+		return;
+	}
+	catch (const std::exception& e)
+	{
+		LOG_ERROR("Unknown exception occurred: " + std::string(e.what()));
+		Close();
+		return;
+	}
+	catch (...)
+	{
+		LOG_ERROR("Unknown error occurred.");
+		Close();
+		return;
+	}
+
+	ReadHeader();
+}
+
+//
+// Sends every queued message, serialized together into the MessageSender's buffer and queued on the socket as one write.
+// This function runs on the connection's strand, so it's never interleaved with the MessageProcessor's sends.
+//
+void Connection::FlushSendQueue()
+{
+	m_flushPending = false;
+
+	try
+	{
+		const std::vector<IMessagePtr> messages = m_sendQueue.pop_all();
+		if (!m_terminate && !m_pMessageSender->SendBatch(*m_pSocket, messages))
 		{
-			LOG_ERROR("Unknown exception occurred: " + std::string(e.what()));
-			break;
+			// The popped messages can't be put back in order, so the connection is dropped rather than silently losing them.
+			LOG_DEBUG_F("Timed out queueing {} messages for ({})", messages.size(), GetIPAddress());
+			Close();
 		}
-		catch (...)
+	}
+	catch (const std::exception& e)
+	{
+		LOG_DEBUG_F("Failed to send to ({}): {}", GetIPAddress(), e.what());
+		Close();
+	}
+}
+
+void Connection::ScheduleTick()
+{
+	std::shared_ptr<Connection> pConnection = shared_from_this();
+	m_timer.expires_after(std::chrono::seconds(1));
+	m_timer.async_wait([pConnection](const asio::error_code& ec)
+	{
+		if (!ec && !pConnection->m_terminate)
 		{
-			LOG_ERROR("Unknown error occurred.");
-			break;
+			asio::post(pConnection->m_strand, [pConnection]() { pConnection->Tick(); });
 		}
+	});
+}
+
+//
+// Pings the peer every 10 seconds, and closes the connection if the peer is banned, abusive, or hasn't responded in 30 seconds.
+// This function runs on the connection's strand.
+//
+void Connection::Tick()
+{
+	if (m_terminate)
+	{
+		return;
 	}
 
-	pConnection->GetSocket()->CloseSocket();
-	pConnection->m_connectedPeer.GetPeer()->SetConnected(false);
+	if (GetPeer()->IsBanned())
+	{
+		Close();
+		return;
+	}
+
+	if (ExceedsRateLimit())
+	{
+		LOG_WARNING_F("Banning peer ({}) for exceeding rate limit.", GetIPAddress());
+		GetPeer()->Ban(EBanReason::Abusive);
+		Close();
+		return;
+	}
+
+	auto now = std::chrono::system_clock::now();
+	if ((m_lastReceivedMessageTime + std::chrono::seconds(30)) < now)
+	{
+		Close();
+		return;
+	}
+
+	if (m_lastPingTime + std::chrono::seconds(10) < now)
+	{
+		const PingMessage pingMessage(m_pSyncStatus->GetBlockDifficulty(), m_pSyncStatus->GetBlockHeight());
+		Send(pingMessage);
+
+		m_lastPingTime = now;
+	}
+
+	ScheduleTick();
 }
+
+void Connection::Close()
+{
+	m_terminate = true;
+	m_pSocket->CloseSocket();
+	m_connectedPeer.GetPeer()->SetConnected(false);
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Seed/PeerManager.h"
 #include "Messages/Message.h"
+#include "Messages/MessageHeader.h"
+#include "Reactor.h"
 
 #include <Common/ConcurrentQueue.h>
 #include <BlockChain/BlockChainServer.h>
@@ -9,6 +11,7 @@
 #include <P2P/ConnectedPeer.h>
 #include <Config/Config.h>
 #include <atomic>
+#include <chrono>
 #include <queue>
 
 // Forward Declarations
@@ -20,13 +23,17 @@ class HandShake;
 class MessageProcessor;
 class MessageRetriever;
 class MessageSender;
+class RawMessage;
 
 //
 // A Connection will be created for each ConnectedPeer.
-// Each Connection will run on its own thread, and will watch the socket for messages,
-// and will ping the peer when it hasn't been heard from in a while.
+// The connection is established and the handshake performed on the reactor's handshake pool.
+// After that, the socket is read asynchronously on the reactor's IO threads, and each message is processed on the worker threads.
+// A connection's messages are processed one at a time and in order (on its strand), and the next read isn't started until
+// the previous message has been processed, so the MessageProcessor may still use the socket directly (e.g. for TxHashSet archives).
+// Once per second, the connection pings the peer if it hasn't been heard from in a while, and checks for idle or abusive peers.
 //
-class Connection
+class Connection : public std::enable_shared_from_this<Connection>
 {
 public:
 	Connection(const Connection&) = delete;
@@ -64,6 +71,12 @@ public:
 
 	bool ExceedsRateLimit() const;
 
+	// The number of messages waiting to be written, whether or not they've been serialized yet.
+	size_t GetSendQueueDepth() const;
+
+	// The number of serialized bytes queued on the socket that haven't been written yet.
+	size_t GetBytesInFlight() const;
+
 private:
 	Connection(
 		SocketPtr pSocket,
@@ -75,10 +88,22 @@ private:
 		std::shared_ptr<HandShake> pHandShake,
 		std::shared_ptr<MessageProcessor> pMessageProcessor,
 		std::shared_ptr<MessageRetriever> pMessageRetriever,
-		std::shared_ptr<MessageSender> pMessageSender
+		std::shared_ptr<MessageSender> pMessageSender,
+		ReactorPtr pReactor
 	);
 
-	static void Thread_ProcessConnection(std::shared_ptr<Connection> pConnection);
+	void Connect();
+
+	void ReadHeader();
+	void ReadPayload(const MessageHeader& messageHeader);
+	void ProcessMessage(const std::shared_ptr<RawMessage>& pRawMessage);
+	void FlushSendQueue();
+
+	void ScheduleTick();
+	void Tick();
+
+	// Closes the socket after an error, ban, or timeout. The ConnectionManager will prune the connection.
+	void Close();
 
 	ConnectionManager& m_connectionManager;
 	Locked<PeerManager> m_peerManager;
@@ -90,15 +115,20 @@ private:
 	std::shared_ptr<MessageSender> m_pMessageSender;
 
 	std::atomic<bool> m_terminate = true;
-	std::thread m_connectionThread;
 	const uint64_t m_connectionId;
 
 	ConnectedPeer m_connectedPeer;
 
-	std::shared_ptr<asio::io_context> m_pContext;
 	mutable SocketPtr m_pSocket;
 
+	ReactorPtr m_pReactor;
+	asio::io_context::strand m_strand;
+	asio::steady_timer m_timer;
+	std::chrono::system_clock::time_point m_lastPingTime;
+	std::chrono::system_clock::time_point m_lastReceivedMessageTime;
+
 	ConcurrentQueue<IMessagePtr> m_sendQueue;
+	std::atomic<bool> m_flushPending;
 };
 
 typedef std::shared_ptr<Connection> ConnectionPtr;
\ No newline at end of file
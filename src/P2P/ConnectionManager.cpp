@@ -15,8 +15,11 @@
 #include <Common/Util/ThreadUtil.h>
 #include <Crypto/RandomNumberGenerator.h>
 
-ConnectionManager::ConnectionManager()
-	: m_connections(std::make_shared<std::vector<ConnectionPtr>>()),
+static const size_t NUM_IO_THREADS = 2;
+
+ConnectionManager::ConnectionManager(ReactorPtr pReactor)
+	: m_pReactor(pReactor),
+	m_connections(std::make_shared<std::vector<ConnectionPtr>>()),
 	m_numOutbound(0),
 	m_numInbound(0)
 {
@@ -35,6 +38,7 @@ void ConnectionManager::Shutdown()
 		ThreadUtil::Join(m_broadcastThread);
 
 		PruneConnections(false);
+		m_pReactor->Shutdown();
 	}
 	catch (const std::exception& e)
 	{
@@ -48,7 +52,10 @@ void ConnectionManager::Shutdown()
 
 std::shared_ptr<ConnectionManager> ConnectionManager::Create()
 {
-	auto pConnectionManager = std::shared_ptr<ConnectionManager>(new ConnectionManager());
+	const size_t numWorkerThreads = (std::max)((size_t)4, (size_t)std::thread::hardware_concurrency());
+	ReactorPtr pReactor = Reactor::Create(NUM_IO_THREADS, numWorkerThreads);
+
+	auto pConnectionManager = std::shared_ptr<ConnectionManager>(new ConnectionManager(pReactor));
 	pConnectionManager->m_broadcastThread = std::thread(Thread_Broadcast, std::ref(*pConnectionManager));
 	return pConnectionManager;
 }
@@ -112,7 +119,11 @@ std::vector<ConnectedPeer> ConnectionManager::GetConnectedPeers() const
 		connections->cbegin(),
 		connections->cend(),
 		std::back_inserter(connectedPeers),
-		[](ConnectionPtr pConnection) { return pConnection->GetConnectedPeer(); }
+		[](ConnectionPtr pConnection) {
+			ConnectedPeer connectedPeer = pConnection->GetConnectedPeer();
+			connectedPeer.UpdateSendStats(pConnection->GetSendQueueDepth(), pConnection->GetBytesInFlight());
+			return connectedPeer;
+		}
 	);
 
 	return connectedPeers;
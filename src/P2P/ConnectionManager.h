@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Connection.h"
+#include "Reactor.h"
 
 #include <Common/ConcurrentQueue.h>
 #include <Core/Traits/Lockable.h>
@@ -37,12 +38,15 @@ public:
 	void PruneConnections(const bool bInactiveOnly);
 	void AddConnection(ConnectionPtr pConnection);
 
+	const ReactorPtr& GetReactor() const { return m_pReactor; }
+
 private:
-	ConnectionManager();
+	ConnectionManager(ReactorPtr pReactor);
 
 	ConnectionPtr GetMostWorkPeer(const std::vector<ConnectionPtr>& connections, const bool preferGrinPP) const;
 	static void Thread_Broadcast(ConnectionManager& connectionManager);
 	
+	ReactorPtr m_pReactor;
 	Locked<std::vector<ConnectionPtr>> m_connections;
 
 	struct MessageToBroadcast
@@ -251,6 +251,7 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 
 				if (m_pSyncStatus->GetStatus() == ESyncStatus::SYNCING_BLOCKS)
 				{
+					m_pipeline.GetBlockScheduler()->OnBlockReceived(connectedPeer.GetPeer(), block.GetHeight(), block.GetHash());
 					m_pipeline.GetBlockPipe()->AddBlockToProcess(connectedPeer.GetPeer(), block);
 				}
 				else
@@ -423,12 +424,14 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(
 		return EStatus::UNKNOWN_ERROR;
 	}
 
-	const std::string zipFilePath = m_pBlockChainServer->SnapshotTxHashSet(pHeader);
-	if (zipFilePath.empty())
+	// Holding the snapshot keeps its zip from being removed while it's being sent, even if a newer snapshot replaces it.
+	TxHashSetZipFilePtr pSnapshot = m_pBlockChainServer->SnapshotTxHashSet(pHeader);
+	if (pSnapshot == nullptr)
 	{
 		return EStatus::UNKNOWN_ERROR;
 	}
 
+	const std::string& zipFilePath = pSnapshot->GetPath();
 	std::ifstream file(zipFilePath, std::ios::in | std::ios::ate | std::ios::binary);
 	if (!file.is_open())
 	{
@@ -456,7 +459,6 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(
 		{
 			LOG_ERROR("Transmission ended abruptly");
 			file.close();
-			FileUtil::RemoveFile(zipFilePath);
 
 			return EStatus::BAN_PEER;
 		}
@@ -466,8 +468,8 @@ MessageProcessor::EStatus MessageProcessor::SendTxHashSet(
 
 	socket.SetBlocking(true);
 
+	// The zip is cached by the TxHashSetManager for other peers, and removed once it's replaced and no longer held.
 	file.close();
-	FileUtil::RemoveFile(zipFilePath);
 
 	return EStatus::SUCCESS;
 }
\ No newline at end of file
@@ -41,35 +41,22 @@ std::unique_ptr<RawMessage> MessageRetriever::RetrieveMessage(Socket& socket, co
 	{
 		socket.SetReceiveTimeout(5 * 1000);
 
-		std::vector<unsigned char> headerBuffer(11, 0);
-		const bool received = socket.Receive(11, true, headerBuffer);
+		std::vector<unsigned char> headerBuffer(HEADER_SIZE, 0);
+		const bool received = socket.Receive(HEADER_SIZE, true, headerBuffer);
 		if (received)
 		{
-			ByteBuffer byteBuffer(std::move(headerBuffer));
-			MessageHeader messageHeader = MessageHeader::Deserialize(byteBuffer);
+			MessageHeader messageHeader = ParseHeader(std::move(headerBuffer), connectedPeer);
 
-			if (!messageHeader.IsValid(m_config))
+			std::vector<unsigned char> payload(messageHeader.GetMessageLength());
+			const bool bPayloadRetrieved = socket.Receive(messageHeader.GetMessageLength(), false, payload);
+			if (bPayloadRetrieved)
 			{
-				throw DESERIALIZATION_EXCEPTION();
+				connectedPeer.GetPeer()->UpdateLastContactTime();
+				return std::make_unique<RawMessage>(RawMessage(std::move(messageHeader), std::move(payload)));
 			}
 			else
 			{
-				if (messageHeader.GetMessageType() != MessageTypes::Ping && messageHeader.GetMessageType() != MessageTypes::Pong)
-				{
-					LOG_TRACE_F("Retrieved message ({}) from ({})", MessageTypes::ToString(messageHeader.GetMessageType()), connectedPeer);
-				}
-
-				std::vector<unsigned char> payload(messageHeader.GetMessageLength());
-				const bool bPayloadRetrieved = socket.Receive(messageHeader.GetMessageLength(), false, payload);
-				if (bPayloadRetrieved)
-				{
-					connectedPeer.GetPeer()->UpdateLastContactTime();
-					return std::make_unique<RawMessage>(RawMessage(std::move(messageHeader), std::move(payload)));
-				}
-				else
-				{
-					throw DESERIALIZATION_EXCEPTION();
-				}
+				throw DESERIALIZATION_EXCEPTION();
 			}
 		}
 		else
@@ -79,4 +66,22 @@ std::unique_ptr<RawMessage> MessageRetriever::RetrieveMessage(Socket& socket, co
 	}
 
 	return std::unique_ptr<RawMessage>(nullptr);
-}
\ No newline at end of file
+}
+
+MessageHeader MessageRetriever::ParseHeader(std::vector<unsigned char>&& headerBytes, const ConnectedPeer& connectedPeer) const
+{
+	ByteBuffer byteBuffer(std::move(headerBytes));
+	MessageHeader messageHeader = MessageHeader::Deserialize(byteBuffer);
+
+	if (!messageHeader.IsValid(m_config))
+	{
+		throw DESERIALIZATION_EXCEPTION();
+	}
+
+	if (messageHeader.GetMessageType() != MessageTypes::Ping && messageHeader.GetMessageType() != MessageTypes::Pong)
+	{
+		LOG_TRACE_F("Retrieved message ({}) from ({})", MessageTypes::ToString(messageHeader.GetMessageType()), connectedPeer);
+	}
+
+	return messageHeader;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Messages/RawMessage.h"
+#include "Messages/MessageHeader.h"
 
 #include <Config/Config.h>
 #include <memory>
@@ -25,6 +26,14 @@ public:
 
 	std::unique_ptr<RawMessage> RetrieveMessage(Socket& socket, const ConnectedPeer& connectedPeer, const ERetrievalMode retrievalMode) const;
 
+	//
+	// Deserializes and validates the 11 byte message header received from the peer.
+	// Throws a DeserializationException if the header is invalid.
+	//
+	MessageHeader ParseHeader(std::vector<unsigned char>&& headerBytes, const ConnectedPeer& connectedPeer) const;
+
+	static const size_t HEADER_SIZE = 11;
+
 private:
 	const Config& m_config;
 	const ConnectionManager& m_connectionManager;
@@ -11,18 +11,41 @@ MessageSender::MessageSender(const Config& config)
 bool MessageSender::Send(Socket& socket, const IMessage& message) const
 {
 	Serializer serializer;
+	Serialize(socket, message, serializer);
+
+	return socket.Send(serializer.GetBytes(), true);
+}
+
+bool MessageSender::SendBatch(Socket& socket, const std::vector<IMessagePtr>& messages) const
+{
+	if (messages.empty())
+	{
+		return true;
+	}
+
+	Serializer serializer(socket.TakeSpareBuffer());
+	for (const IMessagePtr& pMessage : messages)
+	{
+		Serialize(socket, *pMessage, serializer);
+		socket.GetRateCounter().AddMessageSent();
+	}
+
+	return socket.SendBatch(serializer.TakeBytes(), messages.size());
+}
+
+void MessageSender::Serialize(const Socket& socket, const IMessage& message, Serializer& serializer) const
+{
 	serializer.AppendByteVector(m_config.GetEnvironment().GetMagicBytes());
 	serializer.Append<uint8_t>((uint8_t)message.GetMessageType());
 
-	Serializer bodySerializer;
-	message.SerializeBody(bodySerializer);
-	serializer.Append<uint64_t>(bodySerializer.size());
-	serializer.AppendByteVector(bodySerializer.GetBytes());
+	// The body is serialized in place, and its length is filled in afterwards.
+	const size_t lengthOffset = serializer.size();
+	serializer.Append<uint64_t>(0);
+	message.SerializeBody(serializer);
+	serializer.Overwrite<uint64_t>(lengthOffset, serializer.size() - lengthOffset - sizeof(uint64_t));
 
 	if (message.GetMessageType() != MessageTypes::Ping && message.GetMessageType() != MessageTypes::Pong)
 	{
 		LOG_TRACE_F("Sending message ({}) to ({})", MessageTypes::ToString(message.GetMessageType()), socket);
 	}
-
-	return socket.Send(serializer.GetBytes(), true);
-}
\ No newline at end of file
+}
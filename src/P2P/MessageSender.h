@@ -4,6 +4,7 @@
 
 #include <Net/Socket.h>
 #include <Config/Config.h>
+#include <Core/Serialization/Serializer.h>
 
 class MessageSender
 {
@@ -12,6 +13,13 @@ public:
 
 	bool Send(Socket& socket, const IMessage& message) const;
 
+	//
+	// Serializes the messages back-to-back into one of the socket's spare buffers, and moves it onto the socket's queue as a single write.
+	//
+	bool SendBatch(Socket& socket, const std::vector<IMessagePtr>& messages) const;
+
 private:
+	void Serialize(const Socket& socket, const IMessage& message, Serializer& serializer) const;
+
 	const Config& m_config;
-};
\ No newline at end of file
+};
@@ -119,6 +119,11 @@ std::vector<ConnectedPeer> P2PServer::GetConnectedPeers() const
 	return m_pConnectionManager->GetConnectedPeers();
 }
 
+BlockDownloadStats P2PServer::GetBlockDownloadStats() const
+{
+	return m_pPipeline->GetBlockScheduler()->GetStats();
+}
+
 std::optional<PeerConstPtr> P2PServer::GetPeer(const IPAddress& address) const
 {
 	std::optional<std::pair<uint64_t, ConnectedPeer>> connectedPeerOpt = m_pConnectionManager->GetConnectedPeer(address);
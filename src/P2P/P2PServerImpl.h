@@ -29,6 +29,7 @@ public:
 	virtual std::pair<size_t, size_t> GetNumberOfConnectedPeers() const override final;
 	virtual std::vector<PeerConstPtr> GetAllPeers() const override final;
 	virtual std::vector<ConnectedPeer> GetConnectedPeers() const override final;
+	virtual BlockDownloadStats GetBlockDownloadStats() const override final;
 
 	virtual std::optional<PeerConstPtr> GetPeer(
 		const IPAddress& address
@@ -8,7 +8,10 @@
 #include <BlockChain/BlockChainServer.h>
 
 BlockPipe::BlockPipe(const Config& config, IBlockChainServerPtr pBlockChainServer)
-	: m_config(config), m_pBlockChainServer(pBlockChainServer), m_terminate(false)
+	: m_config(config),
+	m_pBlockChainServer(pBlockChainServer),
+	m_pVerifyPool(std::make_unique<ThreadPool>("BLOCK_VERIFY", ThreadPool::GetDefaultNumThreads())),
+	m_terminate(false)
 {
 }
 
@@ -18,6 +21,9 @@ BlockPipe::~BlockPipe()
 
 	ThreadUtil::Join(m_blockThread);
 	ThreadUtil::Join(m_processThread);
+
+	// Queued verifications check m_terminate, so they'll finish quickly.
+	m_pVerifyPool.reset();
 }
 
 std::shared_ptr<BlockPipe> BlockPipe::Create(const Config& config, IBlockChainServerPtr pBlockChainServer)
@@ -36,25 +42,22 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 
 	while (!pipeline.m_terminate)
 	{
-		std::vector<BlockEntry> blocksToProcess = pipeline.m_blocksToProcess.copy_front(8); // TODO: Use number of CPU threads.
-		if (!blocksToProcess.empty())
+		std::unique_ptr<BlockEntry> pBlockEntry = pipeline.m_blocksToProcess.copy_front();
+		if (pBlockEntry != nullptr)
 		{
-			if (blocksToProcess.size() == 1)
+			// Blocks are added in the order they were received, so wait for this one even if later ones are already verified.
+			while (!pipeline.m_terminate && pBlockEntry->m_verified.wait_for(std::chrono::milliseconds(5)) != std::future_status::ready)
 			{
-				ProcessNewBlock(pipeline, blocksToProcess.front());
 			}
-			else
-			{
-				std::vector<std::thread> tasks;
-				for (const BlockEntry& blockEntry : blocksToProcess)
-				{
-					tasks.push_back(std::thread([&pipeline, blockEntry] { ProcessNewBlock(pipeline, blockEntry); }));
-				}
 
-				ThreadUtil::JoinAll(tasks);
+			// Verifications are abandoned during shutdown, so their results can't be trusted.
+			if (pipeline.m_terminate)
+			{
+				break;
 			}
 
-			pipeline.m_blocksToProcess.pop_front(blocksToProcess.size());
+			ProcessNewBlock(pipeline, *pBlockEntry);
+			pipeline.m_blocksToProcess.pop_front(1);
 		}
 		else
 		{
@@ -69,7 +72,13 @@ void BlockPipe::ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntr
 {
 	try
 	{
-		const EBlockChainStatus status = pipeline.m_pBlockChainServer->AddBlock(blockEntry.m_block);
+		if (!blockEntry.m_verified.get())
+		{
+			blockEntry.m_peer->Ban(EBanReason::BadBlock);
+			return;
+		}
+
+		const EBlockChainStatus status = pipeline.m_pBlockChainServer->AddBlock(*blockEntry.m_pBlock);
 		if (status == EBlockChainStatus::INVALID)
 		{
 			blockEntry.m_peer->Ban(EBanReason::BadBlock);
@@ -77,7 +86,7 @@ void BlockPipe::ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntr
 	}
 	catch (std::exception& e)
 	{
-		LOG_ERROR_F("Exception ({}) caught while attempting to add block {}.", e.what(), blockEntry.m_block);
+		LOG_ERROR_F("Exception ({}) caught while attempting to add block {}.", e.what(), *blockEntry.m_pBlock);
 		blockEntry.m_peer->Ban(EBanReason::BadBlock);
 	}
 }
@@ -100,19 +109,33 @@ void BlockPipe::Thread_PostProcessBlocks(BlockPipe& pipeline)
 
 bool BlockPipe::AddBlockToProcess(PeerPtr pPeer, const FullBlock& block)
 {
+	if (IsProcessingBlock(block.GetHash()))
+	{
+		return false;
+	}
+
+	std::shared_ptr<const FullBlock> pBlock = std::make_shared<const FullBlock>(block);
+
+	IBlockChainServerPtr pBlockChainServer = m_pBlockChainServer;
+	const std::atomic_bool& terminate = m_terminate;
+	std::shared_future<bool> verified = m_pVerifyPool->Submit([pBlockChainServer, pBlock, &terminate]
+	{
+		return !terminate && pBlockChainServer->VerifyBlockSelfConsistent(*pBlock);
+	}).share();
+
 	std::function<bool(const BlockEntry&, const BlockEntry&)> comparator = [](const BlockEntry& blockEntry1, const BlockEntry& blockEntry2)
 	{
-		return blockEntry1.m_block.GetHash() == blockEntry2.m_block.GetHash();
+		return blockEntry1.m_pBlock->GetHash() == blockEntry2.m_pBlock->GetHash();
 	};
 
-	return m_blocksToProcess.push_back_unique(BlockEntry(pPeer, block), comparator);
+	return m_blocksToProcess.push_back_unique(BlockEntry(pPeer, pBlock, verified), comparator);
 }
 
 bool BlockPipe::IsProcessingBlock(const Hash& hash) const
 {
 	std::function<bool(const BlockEntry&, const Hash&)> comparator = [](const BlockEntry& blockEntry, const Hash& hash)
 	{
-		return blockEntry.m_block.GetHash() == hash;
+		return blockEntry.m_pBlock->GetHash() == hash;
 	};
 
 	return m_blocksToProcess.contains<Hash>(hash, comparator);
@@ -5,16 +5,25 @@
 #include <Core/Models/FullBlock.h>
 #include <BlockChain/BlockChainServer.h>
 #include <Common/ConcurrentQueue.h>
+#include <Common/ThreadPool.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
 #include <thread>
+#include <future>
 
 // Forward Declarations
 class Config;
 class TxHashSetArchiveMessage;
 class Transaction;
 
+//
+// Processes downloaded blocks in two stages:
+// 1. As soon as a block is added, its self-consistency checks (rangeproofs, kernel signatures, sums) are queued on a
+//    persistent pool with one thread per core. These don't need the chain lock, so any number of blocks can be verified at once.
+// 2. A single thread then adds the blocks to the chain in the order they were received, waiting for each block's verification first.
+//    Only this stage takes the chain lock, and blocks already verified in stage 1 aren't verified again.
+//
 class BlockPipe
 {
 public:
@@ -35,17 +44,21 @@ private:
 
 	struct BlockEntry
 	{
-		BlockEntry(PeerPtr pPeer, const FullBlock& fullBlock)
-			: m_peer(pPeer), m_block(fullBlock)
+		BlockEntry(PeerPtr pPeer, std::shared_ptr<const FullBlock> pBlock, std::shared_future<bool> verified)
+			: m_peer(pPeer), m_pBlock(pBlock), m_verified(verified)
 		{
 
 		}
 
 		PeerPtr m_peer;
-		FullBlock m_block;
+		std::shared_ptr<const FullBlock> m_pBlock;
+		std::shared_future<bool> m_verified;
 	};
 
-	// Pre-Process New Blocks
+	// Verify New Blocks
+	std::unique_ptr<ThreadPool> m_pVerifyPool;
+
+	// Add Verified Blocks
 	static void Thread_ProcessNewBlocks(BlockPipe& pipeline);
 	static void ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntry);
 	std::thread m_blockThread;
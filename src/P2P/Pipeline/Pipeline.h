@@ -4,6 +4,7 @@
 #include "BlockPipe.h"
 #include "TransactionPipe.h"
 #include "TxHashSetPipe.h"
+#include "../Sync/BlockScheduler.h"
 
 #include <P2P/SyncStatus.h>
 #include <BlockChain/BlockChainServer.h>
@@ -22,21 +23,29 @@ public:
 		std::shared_ptr<TransactionPipe> pTransactionPipe = TransactionPipe::Create(config, pConnectionManager, pBlockChainServer);
 		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe = TxHashSetPipe::Create(config, pBlockChainServer, pSyncStatus);
 
-		return std::shared_ptr<Pipeline>(new Pipeline(pBlockPipe, pTransactionPipe, pTxHashSetPipe));
+		std::shared_ptr<BlockScheduler> pBlockScheduler = std::make_shared<BlockScheduler>();
+
+		return std::shared_ptr<Pipeline>(new Pipeline(pBlockPipe, pTransactionPipe, pTxHashSetPipe, pBlockScheduler));
 	}
 
 	std::shared_ptr<BlockPipe> GetBlockPipe() { return m_pBlockPipe; }
 	std::shared_ptr<TransactionPipe> GetTransactionPipe() { return m_pTransactionPipe; }
 	std::shared_ptr<TxHashSetPipe> GetTxHashSetPipe() { return m_pTxHashSetPipe; }
 
+	// Schedules the block requests while syncing blocks, and is told as they arrive.
+	std::shared_ptr<BlockScheduler> GetBlockScheduler() { return m_pBlockScheduler; }
+	std::shared_ptr<const BlockScheduler> GetBlockScheduler() const { return m_pBlockScheduler; }
+
 private:
 	Pipeline(
 		std::shared_ptr<BlockPipe> pBlockPipe,
 		std::shared_ptr<TransactionPipe> pTransactionPipe,
-		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe)
+		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe,
+		std::shared_ptr<BlockScheduler> pBlockScheduler)
 		: m_pBlockPipe(pBlockPipe),
 		m_pTransactionPipe(pTransactionPipe),
-		m_pTxHashSetPipe(pTxHashSetPipe)
+		m_pTxHashSetPipe(pTxHashSetPipe),
+		m_pBlockScheduler(pBlockScheduler)
 	{
 
 	}
@@ -44,4 +53,5 @@ private:
 	std::shared_ptr<BlockPipe> m_pBlockPipe;
 	std::shared_ptr<TransactionPipe> m_pTransactionPipe;
 	std::shared_ptr<TxHashSetPipe> m_pTxHashSetPipe;
+	std::shared_ptr<BlockScheduler> m_pBlockScheduler;
 };
\ No newline at end of file
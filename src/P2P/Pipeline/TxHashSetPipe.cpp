@@ -41,12 +41,30 @@ std::shared_ptr<TxHashSetPipe> TxHashSetPipe::Create(
 	));
 }
 
+void TxHashSetPipe::ExpectTxHashSet(const Hash& blockHash)
+{
+	std::unique_lock<std::mutex> lock(m_expectedMutex);
+	m_expectedHashOpt = blockHash;
+}
+
 bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHashSetArchiveMessage& txHashSetArchiveMessage)
 {
-	if (m_pSyncStatus->GetStatus() != ESyncStatus::SYNCING_TXHASHSET)
+	// Downloads are staged, and only replace the current TxHashSet once they're validated, but each download still replaces
+	// the staging folder, so only the archive that was requested is accepted, and only once.
+	bool expected = false;
+	{
+		std::unique_lock<std::mutex> lock(m_expectedMutex);
+		if (m_expectedHashOpt.has_value() && m_expectedHashOpt.value() == txHashSetArchiveMessage.GetBlockHash())
+		{
+			m_expectedHashOpt.reset();
+			expected = true;
+		}
+	}
+
+	if (!expected || m_pSyncStatus->GetStatus() != ESyncStatus::SYNCING_TXHASHSET)
 	{
 		LOG_WARNING_F("Received TxHashSet from Peer ({}) when not requested.", pPeer);
-		//return false;
+		return false;
 	}
 
 	const bool processing = m_processing.exchange(true);
@@ -64,17 +82,26 @@ bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHash
 	socket.SetReceiveTimeout(10 * 1000);
 	socket.SetReceiveBufferSize(BUFFER_SIZE);
 
-	const std::string fileName = StringUtil::Format(
-		"txhashset_{}.zip",
-		HexUtil::ShortHash(txHashSetArchiveMessage.GetBlockHash())
-	);
-	const fs::path txHashSetPath =  fs::temp_directory_path() / fileName;
-
+	// The zip is extracted as it arrives, so the kernel MMR can be validated while the rest of the TxHashSet is still downloading.
+	ITxHashSetDownloadPtr pDownload = nullptr;
 	try
 	{
-		std::ofstream fout;
-		fout.open(txHashSetPath, std::ios::binary | std::ios::out | std::ios::trunc);
+		pDownload = m_pBlockChainServer->BeginTxHashSetDownload(txHashSetArchiveMessage.GetBlockHash());
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to begin TxHashSet download: {}", e.what());
+	}
 
+	if (pDownload == nullptr)
+	{
+		m_processing = false;
+		m_pSyncStatus->UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
+		return false;
+	}
+
+	try
+	{
 		size_t bytesReceived = 0;
 		std::vector<unsigned char> buffer(BUFFER_SIZE, 0);
 		while (bytesReceived < txHashSetArchiveMessage.GetZippedSize())
@@ -85,25 +112,23 @@ bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHash
 			if (!received || ShutdownManagerAPI::WasShutdownRequested())
 			{
 				LOG_ERROR("Transmission ended abruptly");
-				fout.close();
-				FileUtil::RemoveFile(txHashSetPath.u8string());
+				pDownload.reset();
 				m_processing = false;
 				m_pSyncStatus->UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
 
 				return false;
 			}
 
-			fout.write((char*)&buffer[0], bytesToRead);
+			pDownload->Write(buffer.data(), bytesToRead);
 			bytesReceived += bytesToRead;
 
 			m_pSyncStatus->UpdateDownloaded(bytesReceived);
 		}
-
-		fout.close();
 	}
 	catch (...)
 	{
 		LOG_ERROR_F("Exception thrown while downloading TxHashSet from {}", *pPeer);
+		pDownload.reset();
 		m_processing = false;
 		m_pSyncStatus->UpdateStatus(ESyncStatus::TXHASHSET_SYNC_FAILED);
 		throw;
@@ -113,12 +138,12 @@ bool TxHashSetPipe::ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHash
 
 	ThreadUtil::Join(m_txHashSetThread);
 
-	m_txHashSetThread = std::thread(Thread_ProcessTxHashSet, std::ref(*this), pPeer, txHashSetArchiveMessage.GetBlockHash(), txHashSetPath.u8string());
+	m_txHashSetThread = std::thread(Thread_ProcessTxHashSet, std::ref(*this), pPeer, pDownload);
 
 	return true;
 }
 
-void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, const Hash blockHash, const std::string path)
+void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, ITxHashSetDownloadPtr pDownload)
 {
 	try
 	{
@@ -130,7 +155,7 @@ void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPe
 		pSyncStatus->UpdateProcessingStatus(0);
 		pSyncStatus->UpdateStatus(ESyncStatus::PROCESSING_TXHASHSET);
 
-		const EBlockChainStatus processStatus = pipeline.m_pBlockChainServer->ProcessTransactionHashSet(blockHash, path, *pSyncStatus);
+		const EBlockChainStatus processStatus = pipeline.m_pBlockChainServer->ProcessTxHashSetDownload(pDownload, *pSyncStatus);
 		if (processStatus == EBlockChainStatus::INVALID)
 		{
 			LOG_ERROR("Invalid TxHashSet received.");
@@ -150,5 +175,7 @@ void TxHashSetPipe::Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPe
 		LOG_ERROR("Exception thrown in thread.");
 	}
 
+	// The download removes its staging directory when it's destroyed, so it must be gone before another download can begin.
+	pDownload.reset();
 	pipeline.m_processing = false;
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include <string>
 #include <cstdint>
 #include <atomic>
+#include <mutex>
+#include <optional>
 #include <thread>
 
 // Forward Declarations
@@ -25,7 +27,12 @@ public:
 	~TxHashSetPipe();
 
 	//
-	// Downloads a TxHashSet and kicks off a new thread to process it.
+	// Must be called before the TxHashSet for the given block is requested. Only one archive is accepted per request.
+	//
+	void ExpectTxHashSet(const Hash& blockHash);
+
+	//
+	// Downloads a TxHashSet, extracting it as it arrives, and kicks off a new thread to process it.
 	// Caller should ban peer if false is returned.
 	//
 	bool ReceiveTxHashSet(PeerPtr pPeer, Socket& socket, const TxHashSetArchiveMessage& txHashSetArchiveMessage);
@@ -41,8 +48,11 @@ private:
 	IBlockChainServerPtr m_pBlockChainServer;
 	SyncStatusPtr m_pSyncStatus;
 
-	static void Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, const Hash blockHash, const std::string path);
+	static void Thread_ProcessTxHashSet(TxHashSetPipe& pipeline, PeerPtr pPeer, ITxHashSetDownloadPtr pDownload);
 	std::thread m_txHashSetThread;
 
 	std::atomic_bool m_processing;
+
+	mutable std::mutex m_expectedMutex;
+	std::optional<Hash> m_expectedHashOpt;
 };
\ No newline at end of file
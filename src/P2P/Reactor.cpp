@@ -0,0 +1,70 @@
+#include "Reactor.h"
+
+#include <Common/Util/ThreadUtil.h>
+#include <Infrastructure/ThreadManager.h>
+#include <Infrastructure/Logger.h>
+
+static const size_t NUM_HANDSHAKE_THREADS = 8;
+
+Reactor::Reactor()
+	: m_pIOContext(std::make_shared<asio::io_context>()),
+	m_pWorkerContext(std::make_shared<asio::io_context>()),
+	m_pIOWork(std::make_unique<asio::executor_work_guard<asio::io_context::executor_type>>(m_pIOContext->get_executor())),
+	m_pWorkerWork(std::make_unique<asio::executor_work_guard<asio::io_context::executor_type>>(m_pWorkerContext->get_executor())),
+	m_pHandshakePool(std::make_unique<ThreadPool>("HANDSHAKE", NUM_HANDSHAKE_THREADS))
+{
+
+}
+
+Reactor::~Reactor()
+{
+	Shutdown();
+}
+
+std::shared_ptr<Reactor> Reactor::Create(const size_t numIOThreads, const size_t numWorkerThreads)
+{
+	auto pReactor = std::shared_ptr<Reactor>(new Reactor());
+	for (size_t i = 0; i < (std::max)((size_t)1, numIOThreads); i++)
+	{
+		pReactor->m_threads.emplace_back(std::thread(Thread_Run, pReactor->m_pIOContext, "P2P_IO"));
+	}
+
+	for (size_t i = 0; i < (std::max)((size_t)1, numWorkerThreads); i++)
+	{
+		pReactor->m_threads.emplace_back(std::thread(Thread_Run, pReactor->m_pWorkerContext, "P2P_WORKER"));
+	}
+
+	return pReactor;
+}
+
+void Reactor::Shutdown()
+{
+	// Handshakes may still need the IO threads to connect, so they must finish first.
+	m_pHandshakePool.reset();
+
+	m_pWorkerWork.reset();
+	m_pIOWork.reset();
+	ThreadUtil::JoinAll(m_threads);
+	m_threads.clear();
+}
+
+void Reactor::Thread_Run(std::shared_ptr<asio::io_context> pContext, const std::string name)
+{
+	ThreadManagerAPI::SetCurrentThreadName(name);
+	LOG_TRACE("BEGIN");
+
+	while (true)
+	{
+		try
+		{
+			pContext->run();
+			break;
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR_F("Exception thrown: {}", e.what());
+		}
+	}
+
+	LOG_TRACE("END");
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Common/ThreadPool.h>
+#include <asio.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//
+// Runs the I/O for every peer connection on a small, shared set of threads.
+//
+// The IO context handles the socket reads and writes, and should only ever run short handlers.
+// Received messages are dispatched to the worker context, where each connection processes them in order on its own strand.
+// Handshakes block on the socket, so they are performed on a separate pool to keep them from holding up message processing.
+//
+class Reactor
+{
+public:
+	static std::shared_ptr<Reactor> Create(const size_t numIOThreads, const size_t numWorkerThreads);
+	~Reactor();
+
+	Reactor(const Reactor&) = delete;
+	Reactor& operator=(const Reactor&) = delete;
+
+	//
+	// Finishes any queued handshakes, then lets the threads exit once all outstanding handlers have completed, and joins them.
+	// All connections should be closed first, so their pending reads and writes are cancelled.
+	//
+	void Shutdown();
+
+	const std::shared_ptr<asio::io_context>& GetIOContext() const { return m_pIOContext; }
+	asio::io_context& GetWorkerContext() { return *m_pWorkerContext; }
+	ThreadPool& GetHandshakePool() { return *m_pHandshakePool; }
+
+private:
+	Reactor();
+
+	static void Thread_Run(std::shared_ptr<asio::io_context> pContext, const std::string name);
+
+	std::shared_ptr<asio::io_context> m_pIOContext;
+	std::shared_ptr<asio::io_context> m_pWorkerContext;
+	std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> m_pIOWork;
+	std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> m_pWorkerWork;
+	std::vector<std::thread> m_threads;
+	std::unique_ptr<ThreadPool> m_pHandshakePool;
+};
+
+typedef std::shared_ptr<Reactor> ReactorPtr;
@@ -118,7 +118,7 @@ void Seeder::Thread_Listener(Seeder& seeder)
 			// FUTURE: Always accept, but then send peers and immediately drop
 			if (seeder.m_connectionManager.GetNumberOfActiveConnections() < maximumConnections)
 			{
-				const bool connectionAdded = pSocket->Accept(seeder.m_pContext, acceptor, seeder.m_terminate);
+				const bool connectionAdded = pSocket->Accept(seeder.m_connectionManager.GetReactor()->GetIOContext(), acceptor, seeder.m_terminate);
 				if (connectionAdded)
 				{
 					ConnectionPtr pConnection = Connection::Create(
@@ -0,0 +1,385 @@
+#include "BlockScheduler.h"
+
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+static const size_t INITIAL_WINDOW = 8;
+static const size_t MIN_WINDOW = 1;
+static const size_t MAX_WINDOW = 64;
+static const size_t MAX_LOOKAHEAD = 1024;
+static const size_t STRAGGLER_SLOTS = 4;
+static const size_t MAX_CONSECUTIVE_TIMEOUTS = 3;
+static const double TARGET_LATENCY_MS = 4000.0;
+static const double INITIAL_LATENCY_MS = 2000.0;
+static const double MIN_STRAGGLER_AGE_MS = 1000.0;
+static const auto MIN_TIMEOUT = std::chrono::seconds(5);
+static const auto MAX_TIMEOUT = std::chrono::seconds(20);
+
+static double GetMillisecondsSince(const std::chrono::steady_clock::time_point& time, const std::chrono::steady_clock::time_point& now)
+{
+	return (double)std::chrono::duration_cast<std::chrono::microseconds>(now - time).count() / 1000.0;
+}
+
+std::chrono::milliseconds BlockScheduler::PeerState::GetTimeout() const
+{
+	const auto timeout = std::chrono::milliseconds((int64_t)(latencyMs + (4 * latencyVarianceMs)));
+	return std::clamp<std::chrono::milliseconds>(timeout, MIN_TIMEOUT, MAX_TIMEOUT);
+}
+
+double BlockScheduler::PeerState::GetExpectedDeliveryMs() const
+{
+	// Until it has been measured, assume the peer serves a full window in its latency.
+	const double blocksPerSecondEstimate = blocksPerSecond > 0.0 ? blocksPerSecond : (1000.0 * window / latencyMs);
+	return (std::max)(latencyMs, (1000.0 * (numInFlight + 1)) / blocksPerSecondEstimate);
+}
+
+size_t BlockScheduler::GetLookahead(const size_t numPeers) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	size_t lookahead = m_requests.size();
+	for (const auto& peer : m_peers)
+	{
+		lookahead += peer.second.window - (std::min)(peer.second.window, peer.second.numInFlight);
+	}
+
+	// Peers that haven't been scheduled yet start with the initial window.
+	if (numPeers > m_peers.size())
+	{
+		lookahead += (numPeers - m_peers.size()) * INITIAL_WINDOW;
+	}
+
+	return (std::min)(lookahead, MAX_LOOKAHEAD);
+}
+
+std::vector<BlockScheduler::Assignment> BlockScheduler::Schedule(
+	const std::vector<PeerPtr>& peers,
+	const std::vector<std::pair<uint64_t, Hash>>& blocksNeeded,
+	const std::function<bool(const Hash&)>& isProcessing)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	const TimePoint now = m_clock();
+
+	UpdatePeers(peers);
+
+	// Forget requests for blocks that are no longer needed, either because they were received, or because the candidate chain changed.
+	std::unordered_map<uint64_t, const Hash*> neededHashes;
+	for (const auto& blockNeeded : blocksNeeded)
+	{
+		neededHashes[blockNeeded.first] = &blockNeeded.second;
+	}
+
+	const uint64_t lowestNeeded = blocksNeeded.empty() ? UINT64_MAX : blocksNeeded.front().first;
+	for (auto iter = m_requests.begin(); iter != m_requests.end();)
+	{
+		auto neededIter = neededHashes.find(iter->first);
+		const bool noLongerNeeded = iter->first < lowestNeeded
+			|| (neededIter != neededHashes.end() && *neededIter->second != iter->second.hash)
+			|| isProcessing(iter->second.hash);
+
+		auto next = std::next(iter);
+		if (noLongerNeeded)
+		{
+			RemoveRequest(iter);
+		}
+
+		iter = next;
+	}
+
+	ExpireRequests(now);
+
+	// Re-request stragglers from faster peers.
+	std::vector<Assignment> assignments;
+	for (const uint64_t height : FindStragglers(now))
+	{
+		auto requestIter = m_requests.find(height);
+		PeerState& slowPeer = m_peers.at(requestIter->second.peer);
+
+		PeerState* pFastPeer = FindFastestAvailablePeer();
+		if (pFastPeer == nullptr || pFastPeer == &slowPeer || pFastPeer->latencyMs >= slowPeer.latencyMs)
+		{
+			continue;
+		}
+
+		LOG_DEBUG_F("Re-requesting block {} from {} instead of {}", height, pFastPeer->pPeer, slowPeer.pPeer);
+		++slowPeer.requestsReassigned;
+		slowPeer.window = (std::max)(MIN_WINDOW, slowPeer.window - 1);
+
+		const Hash hash = requestIter->second.hash;
+		RemoveRequest(requestIter);
+
+		++pFastPeer->numInFlight;
+		m_requests[height] = Request{ hash, pFastPeer->pPeer->GetIPAddress(), now, true };
+		assignments.push_back(Assignment{ pFastPeer->pPeer, height, hash });
+	}
+
+	// Assign the remaining blocks, nearest the tip first.
+	for (const auto& blockNeeded : blocksNeeded)
+	{
+		if (m_requests.find(blockNeeded.first) != m_requests.end() || isProcessing(blockNeeded.second))
+		{
+			continue;
+		}
+
+		PeerState* pPeer = FindFastestAvailablePeer();
+		if (pPeer == nullptr)
+		{
+			break;
+		}
+
+		++pPeer->numInFlight;
+		m_requests[blockNeeded.first] = Request{ blockNeeded.second, pPeer->pPeer->GetIPAddress(), now, false };
+		assignments.push_back(Assignment{ pPeer->pPeer, blockNeeded.first, blockNeeded.second });
+	}
+
+	return assignments;
+}
+
+void BlockScheduler::OnRequestFailed(const Assignment& assignment)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = m_requests.find(assignment.height);
+	if (iter != m_requests.end() && iter->second.hash == assignment.hash)
+	{
+		RemoveRequest(iter);
+	}
+}
+
+void BlockScheduler::OnBlockReceived(const PeerConstPtr& pPeer, const uint64_t height, const Hash& hash)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto requestIter = m_requests.find(height);
+	if (requestIter == m_requests.end() || requestIter->second.hash != hash)
+	{
+		return;
+	}
+
+	// A straggler may still be delivered by the peer it was first requested from, but only the current peer's stats are updated.
+	auto peerIter = m_peers.find(requestIter->second.peer);
+	if (peerIter != m_peers.end() && requestIter->second.peer == pPeer->GetIPAddress())
+	{
+		PeerState& peer = peerIter->second;
+		const TimePoint now = m_clock();
+		const double latencyMs = GetMillisecondsSince(requestIter->second.sent, now);
+
+		// Smoothed the same way as TCP's RTT estimate (RFC 6298).
+		if (peer.blocksReceived == 0)
+		{
+			peer.latencyMs = latencyMs;
+			peer.latencyVarianceMs = latencyMs / 2;
+		}
+		else
+		{
+			peer.latencyVarianceMs = (0.75 * peer.latencyVarianceMs) + (0.25 * std::abs(peer.latencyMs - latencyMs));
+			peer.latencyMs = (0.875 * peer.latencyMs) + (0.125 * latencyMs);
+		}
+
+		// Only count the time the peer had this request, so idle time doesn't lower its throughput.
+		const TimePoint busySince = (std::max)(peer.lastReceived, requestIter->second.sent);
+		const double blocksPerSecond = 1000.0 / (std::max)(1.0, GetMillisecondsSince(busySince, now));
+		peer.blocksPerSecond = peer.blocksPerSecond > 0.0 ? (0.75 * peer.blocksPerSecond) + (0.25 * blocksPerSecond) : blocksPerSecond;
+		peer.lastReceived = now;
+
+		++peer.blocksReceived;
+		peer.consecutiveTimeouts = 0;
+
+		if (latencyMs <= TARGET_LATENCY_MS)
+		{
+			peer.window = (std::min)(MAX_WINDOW, peer.window + 1);
+		}
+		else
+		{
+			peer.window = (std::max)(MIN_WINDOW, peer.window - 1);
+		}
+	}
+
+	RemoveRequest(requestIter);
+}
+
+void BlockScheduler::ClearRequests()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_requests.clear();
+	for (auto& peer : m_peers)
+	{
+		peer.second.numInFlight = 0;
+	}
+}
+
+BlockDownloadStats BlockScheduler::GetStats() const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	BlockDownloadStats stats;
+	stats.numInFlight = m_requests.size();
+	stats.lowestRequested = m_requests.empty() ? 0 : m_requests.cbegin()->first;
+	stats.highestRequested = m_requests.empty() ? 0 : m_requests.crbegin()->first;
+
+	for (const auto& peer : m_peers)
+	{
+		const PeerState& state = peer.second;
+		stats.peers.push_back(BlockDownloadPeerStats{
+			peer.first,
+			state.numInFlight,
+			state.window,
+			(uint64_t)state.latencyMs,
+			state.blocksPerSecond,
+			state.blocksReceived,
+			state.requestsTimedOut,
+			state.requestsReassigned
+		});
+	}
+
+	return stats;
+}
+
+void BlockScheduler::UpdatePeers(const std::vector<PeerPtr>& peers)
+{
+	std::unordered_set<IPAddress> current;
+	for (const PeerPtr& pPeer : peers)
+	{
+		current.insert(pPeer->GetIPAddress());
+		if (m_peers.find(pPeer->GetIPAddress()) == m_peers.end())
+		{
+			PeerState state;
+			state.pPeer = pPeer;
+			state.numInFlight = 0;
+			state.window = INITIAL_WINDOW;
+			state.latencyMs = INITIAL_LATENCY_MS;
+			state.latencyVarianceMs = INITIAL_LATENCY_MS / 2;
+			state.blocksPerSecond = 0.0;
+			state.lastReceived = TimePoint();
+			state.blocksReceived = 0;
+			state.requestsTimedOut = 0;
+			state.requestsReassigned = 0;
+			state.consecutiveTimeouts = 0;
+
+			m_peers.emplace(pPeer->GetIPAddress(), std::move(state));
+		}
+	}
+
+	// Requests to peers that are gone (or no longer have the most work) are dropped, so they'll be assigned to other peers.
+	for (auto iter = m_requests.begin(); iter != m_requests.end();)
+	{
+		iter = current.count(iter->second.peer) == 0 ? m_requests.erase(iter) : std::next(iter);
+	}
+
+	for (auto iter = m_peers.begin(); iter != m_peers.end();)
+	{
+		iter = current.count(iter->first) == 0 ? m_peers.erase(iter) : std::next(iter);
+	}
+}
+
+void BlockScheduler::RemoveRequest(std::map<uint64_t, Request>::iterator iter)
+{
+	auto peerIter = m_peers.find(iter->second.peer);
+	if (peerIter != m_peers.end() && peerIter->second.numInFlight > 0)
+	{
+		--peerIter->second.numInFlight;
+	}
+
+	m_requests.erase(iter);
+}
+
+void BlockScheduler::ExpireRequests(const TimePoint& now)
+{
+	// A peer that stalls times out its whole window at once, so that only counts as one timeout.
+	std::unordered_set<IPAddress> peersTimedOut;
+	for (auto iter = m_requests.begin(); iter != m_requests.end();)
+	{
+		PeerState& peer = m_peers.at(iter->second.peer);
+		auto next = std::next(iter);
+		if (now - iter->second.sent > peer.GetTimeout())
+		{
+			LOG_DEBUG_F("Request for block {} to {} timed out", iter->first, peer.pPeer);
+			++peer.requestsTimedOut;
+			peersTimedOut.insert(iter->second.peer);
+			RemoveRequest(iter);
+		}
+
+		iter = next;
+	}
+
+	std::unordered_set<IPAddress> peersToBan;
+	for (const IPAddress& address : peersTimedOut)
+	{
+		PeerState& peer = m_peers.at(address);
+		++peer.consecutiveTimeouts;
+		peer.window = (std::max)(MIN_WINDOW, peer.window / 2);
+
+		if (peer.consecutiveTimeouts >= MAX_CONSECUTIVE_TIMEOUTS)
+		{
+			peersToBan.insert(address);
+		}
+	}
+
+	for (const IPAddress& address : peersToBan)
+	{
+		auto peerIter = m_peers.find(address);
+		if (peerIter == m_peers.end())
+		{
+			continue;
+		}
+
+		if (!peerIter->second.pPeer->IsBanned())
+		{
+			LOG_ERROR_F("Banning peer {} for fraud height.", peerIter->second.pPeer);
+			peerIter->second.pPeer->Ban(EBanReason::FraudHeight);
+		}
+
+		for (auto iter = m_requests.begin(); iter != m_requests.end();)
+		{
+			iter = iter->second.peer == address ? m_requests.erase(iter) : std::next(iter);
+		}
+
+		m_peers.erase(peerIter);
+	}
+}
+
+std::vector<uint64_t> BlockScheduler::FindStragglers(const TimePoint& now)
+{
+	std::vector<uint64_t> stragglers;
+
+	size_t slot = 0;
+	for (auto iter = m_requests.cbegin(); iter != m_requests.cend() && slot < STRAGGLER_SLOTS; iter++, slot++)
+	{
+		if (iter->second.reassigned)
+		{
+			continue;
+		}
+
+		const PeerState& peer = m_peers.at(iter->second.peer);
+		const double ageMs = GetMillisecondsSince(iter->second.sent, now);
+		if (ageMs > (std::max)(MIN_STRAGGLER_AGE_MS, 2 * peer.latencyMs))
+		{
+			stragglers.push_back(iter->first);
+		}
+	}
+
+	return stragglers;
+}
+
+BlockScheduler::PeerState* BlockScheduler::FindFastestAvailablePeer()
+{
+	PeerState* pFastest = nullptr;
+	for (auto& peer : m_peers)
+	{
+		PeerState& state = peer.second;
+		if (state.numInFlight >= state.window || state.pPeer->IsBanned())
+		{
+			continue;
+		}
+
+		if (pFastest == nullptr || state.GetExpectedDeliveryMs() < pFastest->GetExpectedDeliveryMs())
+		{
+			pFastest = &state;
+		}
+	}
+
+	return pFastest;
+}
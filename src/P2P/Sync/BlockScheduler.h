@@ -0,0 +1,110 @@
+#pragma once
+
+#include <P2P/Peer.h>
+#include <P2P/BlockDownloadStats.h>
+#include <Crypto/Hash.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//
+// Decides which peer to download each needed block from, while syncing blocks.
+//
+// The scheduler measures each peer's latency (the time from requesting a block to receiving it) and throughput,
+// and gives each peer its own window of in-flight requests. A window grows by one for every block that arrives within
+// TARGET_LATENCY, shrinks by one for every block that doesn't, and is halved whenever any of its requests time out,
+// so peers end up with a share of the requests proportional to how quickly they serve them.
+//
+// Blocks are assigned in ascending height order, each to the peer expected to deliver it soonest, so the blocks nearest
+// the confirmed tip (which hold up the chain) go to the fastest peers. Those blocks are also re-requested from a faster peer
+// early if their request is taking much longer than the peer's usual latency, rather than waiting for the full timeout.
+//
+// This class is thread-safe. Blocks are scheduled from the sync thread, but received on the connections' threads.
+//
+class BlockScheduler
+{
+public:
+	typedef std::chrono::steady_clock::time_point TimePoint;
+	typedef std::function<TimePoint()> Clock;
+
+	// The clock is only replaced in tests, to control when requests time out.
+	BlockScheduler(const Clock& clock = &std::chrono::steady_clock::now)
+		: m_clock(clock) { }
+
+	struct Assignment
+	{
+		PeerPtr pPeer;
+		uint64_t height;
+		Hash hash;
+	};
+
+	//
+	// Returns how many of the needed blocks should be passed to Schedule, which is enough to fill every peer's window.
+	//
+	size_t GetLookahead(const size_t numPeers) const;
+
+	//
+	// Expires timed out requests, reassigns stragglers, and assigns as many of the needed blocks (in ascending height order)
+	// as the peers' windows allow. The returned blocks should be requested immediately, and OnRequestFailed called for any that can't be.
+	// Peers that keep failing to deliver requested blocks are banned.
+	//
+	std::vector<Assignment> Schedule(
+		const std::vector<PeerPtr>& peers,
+		const std::vector<std::pair<uint64_t, Hash>>& blocksNeeded,
+		const std::function<bool(const Hash&)>& isProcessing
+	);
+
+	void OnRequestFailed(const Assignment& assignment);
+	void OnBlockReceived(const PeerConstPtr& pPeer, const uint64_t height, const Hash& hash);
+
+	//
+	// Forgets all outstanding requests (e.g. once blocks are no longer being synced), but keeps what was learned about the peers.
+	//
+	void ClearRequests();
+
+	BlockDownloadStats GetStats() const;
+
+private:
+	struct PeerState
+	{
+		PeerPtr pPeer;
+		size_t numInFlight;
+		size_t window;
+		double latencyMs;
+		double latencyVarianceMs;
+		double blocksPerSecond;
+		TimePoint lastReceived;
+		uint64_t blocksReceived;
+		uint64_t requestsTimedOut;
+		uint64_t requestsReassigned;
+		size_t consecutiveTimeouts;
+
+		std::chrono::milliseconds GetTimeout() const;
+
+		// The estimated time until a new request to this peer would be delivered.
+		double GetExpectedDeliveryMs() const;
+	};
+
+	struct Request
+	{
+		Hash hash;
+		IPAddress peer;
+		TimePoint sent;
+		bool reassigned;
+	};
+
+	void UpdatePeers(const std::vector<PeerPtr>& peers);
+	void RemoveRequest(std::map<uint64_t, Request>::iterator iter);
+	void ExpireRequests(const TimePoint& now);
+	std::vector<uint64_t> FindStragglers(const TimePoint& now);
+	PeerState* FindFastestAvailablePeer();
+
+	Clock m_clock;
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<IPAddress, PeerState> m_peers;
+	std::map<uint64_t, Request> m_requests;
+};
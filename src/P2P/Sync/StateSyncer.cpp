@@ -6,8 +6,11 @@
 #include <Infrastructure/Logger.h>
 #include <Infrastructure/ShutdownManager.h>
 
-StateSyncer::StateSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer)
-	: m_pConnectionManager(pConnectionManager), m_pBlockChainServer(pBlockChainServer)
+StateSyncer::StateSyncer(
+	std::weak_ptr<ConnectionManager> pConnectionManager,
+	IBlockChainServerPtr pBlockChainServer,
+	std::shared_ptr<Pipeline> pPipeline)
+	: m_pConnectionManager(pConnectionManager), m_pBlockChainServer(pBlockChainServer), m_pPipeline(pPipeline)
 {
 	m_timeRequested = std::chrono::system_clock::now();
 	m_requestedHeight = 0;
@@ -111,6 +114,9 @@ bool StateSyncer::RequestState(const SyncStatus& syncStatus)
 		const uint64_t requestedHeight = headerHeight - Consensus::STATE_SYNC_THRESHOLD;
 		Hash hash = m_pBlockChainServer->GetBlockHeaderByHeight(requestedHeight, EChainType::CANDIDATE)->GetHash();
 
+		// Expected before it's requested, since the archive can arrive before SendMessageToMostWorkPeer returns.
+		m_pPipeline->GetTxHashSetPipe()->ExpectTxHashSet(hash);
+
 		const TxHashSetRequestMessage txHashSetRequestMessage(std::move(hash), requestedHeight);
 		m_pPeer = m_pConnectionManager.lock()->SendMessageToMostWorkPeer(txHashSetRequestMessage, true);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ConnectionManager.h"
+#include "../Pipeline/Pipeline.h"
 
 #include <BlockChain/BlockChainServer.h>
 #include <chrono>
@@ -11,7 +12,11 @@ class SyncStatus;
 class StateSyncer
 {
 public:
-	StateSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer);
+	StateSyncer(
+		std::weak_ptr<ConnectionManager> pConnectionManager,
+		IBlockChainServerPtr pBlockChainServer,
+		std::shared_ptr<Pipeline> pPipeline
+	);
 
 	bool SyncState(SyncStatus& syncStatus);
 
@@ -25,4 +30,5 @@ private:
 
 	std::weak_ptr<ConnectionManager> m_pConnectionManager;
 	IBlockChainServerPtr m_pBlockChainServer;
+	std::shared_ptr<Pipeline> m_pPipeline;
 };
\ No newline at end of file
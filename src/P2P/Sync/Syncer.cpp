@@ -54,7 +54,7 @@ void Syncer::Thread_Sync(Syncer& syncer)
 	LOG_DEBUG("BEGIN");
 
 	HeaderSyncer headerSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer);
-	StateSyncer stateSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer);
+	StateSyncer stateSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer, syncer.m_pPipeline);
 	BlockSyncer blockSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer, syncer.m_pPipeline);
 	bool startup = true;
 
@@ -3,6 +3,7 @@
 #include "PruneList.h"
 #include "MMRUtil.h"
 #include "MMRHashUtil.h"
+#include "UBMT.h"
 
 #include <string>
 #include <Crypto/Hash.h>
@@ -22,13 +23,38 @@ public:
 		return std::shared_ptr<LeafSet>(new LeafSet(path, pBitmapFile));
 	}
 
-	void Add(const uint32_t position) { m_pBitmap->Set(position); }
-	void Remove(const uint32_t position) { m_pBitmap->Unset(position); }
+	void Add(const uint32_t position)
+	{
+		m_pBitmap->Set(position);
+		m_ubmt.MarkDirty(position);
+	}
+
+	void Remove(const uint32_t position)
+	{
+		m_pBitmap->Unset(position);
+		m_ubmt.MarkDirty(position);
+	}
+
 	bool Contains(const uint64_t position) const { return m_pBitmap->IsSet(position); }
 
-	void Rewind(const uint64_t size, const Roaring& positionsToAdd) { m_pBitmap->Rewind(size, positionsToAdd); }
-	void Commit() { m_pBitmap->Commit(); }
-	void Rollback() { m_pBitmap->Rollback(); }
+	void Rewind(const uint64_t size, const Roaring& positionsToAdd)
+	{
+		m_pBitmap->Rewind(size, positionsToAdd);
+		m_ubmt.MarkDirty(positionsToAdd);
+		m_ubmt.Truncate(size);
+	}
+
+	void Commit()
+	{
+		m_pBitmap->Commit();
+		m_ubmt.Commit();
+	}
+
+	void Rollback()
+	{
+		m_pBitmap->Rollback();
+		m_ubmt.Rollback();
+	}
 	void Snapshot(const Hash& blockHash)
 	{
 		std::string path = m_path + "." + HexUtil::ShortHash(blockHash);
@@ -50,38 +76,7 @@ public:
 
 	Hash Root(const uint64_t numOutputs)
 	{
-		const fs::path path = fs::temp_directory_path() / "UBMT";
-		std::shared_ptr<HashFile> pHashFile = HashFile::Load(path);
-		pHashFile->Rewind(0);
-
-		size_t index = 0;
-		//const uint64_t numLeaves = MMRUtil::GetNumLeaves(bitmap.maximum());
-		const uint64_t numChunks = (numOutputs + 1023) / 1024;
-		for (size_t i = 0; i < numChunks; i++)
-		{
-			Serializer serializer;
-			for (size_t j = 0; j < (1024 / 8); j++)
-			{
-				uint8_t power = 128;
-				uint8_t byte = 0;
-				for (size_t k = 0; k < 8; k++)
-				{
-					if (index < numOutputs && m_pBitmap->IsSet(MMRUtil::GetPMMRIndex(index)))
-					{
-						byte += power;
-					}
-
-					power /= 2;
-					++index;
-				}
-
-				serializer.Append(byte);
-			}
-
-			MMRHashUtil::AddHashes(pHashFile, serializer.GetBytes(), nullptr);
-		}
-
-		return MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr);
+		return m_ubmt.Root(*m_pBitmap, numOutputs);
 	}
 
 private:
@@ -93,4 +88,5 @@ private:
 
 	std::string m_path;
 	std::shared_ptr<BitmapFile> m_pBitmap;
+	UBMT m_ubmt;
 };
\ No newline at end of file
@@ -8,7 +8,8 @@
 void MMRHashUtil::AddHashes(
 	std::shared_ptr<HashFile> pHashFile,
 	const std::vector<unsigned char>& serializedLeaf,
-	std::shared_ptr<const PruneList> pPruneList)
+	std::shared_ptr<const PruneList> pPruneList,
+	MMRPeaks& peaks)
 {
 	// Calculate next position
 	uint64_t position = pHashFile->GetSize();
@@ -17,25 +18,29 @@ void MMRHashUtil::AddHashes(
 		position += pPruneList->GetTotalShift();
 	}
 
-	// Add in the new leaf hash
+	// Add in the new leaf hash, and the parent hashes it completes
 	const Hash leafHash = HashLeafWithIndex(serializedLeaf, position);
-	pHashFile->AddData(leafHash);
+	peaks.Append(pHashFile, pPruneList, position, leafHash);
+}
 
-	// Add parent hashes
-	uint64_t peak = 1;
-	while (MMRUtil::GetHeight(position + 1) > 0)
+Hash MMRHashUtil::Root(
+	std::shared_ptr<const HashFile> pHashFile,
+	const uint64_t size,
+	std::shared_ptr<const PruneList> pPruneList,
+	MMRPeaks& peaks)
+{
+	uint64_t currentSize = pHashFile->GetSize();
+	if (pPruneList != nullptr)
 	{
-		const uint64_t leftSiblingPosition = (position + 1) - (2 * peak);
-
-		const Hash leftHash = GetHashAt(pHashFile, leftSiblingPosition, pPruneList);
-		const Hash rightHash = GetHashAt(pHashFile, position, pPruneList);
-
-		++position;
-		peak *= 2;
+		currentSize += pPruneList->GetTotalShift();
+	}
 
-		const Hash parentHash = HashParentWithIndex(leftHash, rightHash, position);
-		pHashFile->AddData(parentHash);
+	if (size == currentSize)
+	{
+		return peaks.Root(pHashFile, pPruneList, size);
 	}
+
+	return Root(pHashFile, size, pPruneList);
 }
 
 Hash MMRHashUtil::Root(
@@ -53,7 +58,7 @@ Hash MMRHashUtil::Root(
 	for (auto iter = peakIndices.crbegin(); iter != peakIndices.crend(); iter++)
 	{
 		const uint64_t shiftedIndex = GetShiftedIndex(*iter, pPruneList);
-		Hash peakHash = pHashFile->GetDataAt(shiftedIndex);
+		const Hash peakHash(pHashFile->GetDataPtrAt(shiftedIndex));
 		if (peakHash != ZERO_HASH)
 		{
 			if (hash == ZERO_HASH)
@@ -85,11 +90,11 @@ Hash MMRHashUtil::GetHashAt(
 		const uint64_t shift = pPruneList->GetShift(mmrIndex);
 		const uint64_t shiftedIndex = (mmrIndex - shift);
 
-		return pHashFile->GetDataAt(shiftedIndex);
+		return Hash(pHashFile->GetDataPtrAt(shiftedIndex));
 	}
 	else
 	{
-		return pHashFile->GetDataAt(mmrIndex);
+		return Hash(pHashFile->GetDataPtrAt(mmrIndex));
 	}
 }
 
@@ -2,6 +2,7 @@
 
 #include "HashFile.h"
 #include "PruneList.h"
+#include "MMRPeaks.h"
 
 #include <Crypto/Hash.h>
 #include <Core/Traits/Lockable.h>
@@ -16,7 +17,19 @@ public:
 	static void AddHashes(
 		std::shared_ptr<HashFile> pHashFile,
 		const std::vector<unsigned char>& serializedLeaf,
-		std::shared_ptr<const PruneList> pPruneList
+		std::shared_ptr<const PruneList> pPruneList,
+		MMRPeaks& peaks
+	);
+
+	//
+	// Bags the root from the in-memory peaks when size is the MMR's current size,
+	// and from the peak hashes in the hash file otherwise.
+	//
+	static Hash Root(
+		std::shared_ptr<const HashFile> pHashFile,
+		const uint64_t size,
+		std::shared_ptr<const PruneList> pPruneList,
+		MMRPeaks& peaks
 	);
 
 	static Hash Root(
@@ -38,9 +51,9 @@ public:
 		const uint64_t numHashes
 	);
 
+	static Hash HashLeafWithIndex(const std::vector<unsigned char>& serializedLeaf, const uint64_t mmrIndex);
 	static Hash HashParentWithIndex(const Hash& leftChild, const Hash& rightChild, const uint64_t parentIndex);
 
 private:
-	static Hash HashLeafWithIndex(const std::vector<unsigned char>& serializedLeaf, const uint64_t mmrIndex);
 	static uint64_t GetShiftedIndex(const uint64_t mmrIndex, std::shared_ptr<const PruneList> pPruneList);
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "MMRPeaks.h"
+#include "MMRUtil.h"
+#include "MMRHashUtil.h"
+
+void MMRPeaks::Append(
+	std::shared_ptr<HashFile> pHashFile,
+	std::shared_ptr<const PruneList> pPruneList,
+	const uint64_t position,
+	const Hash& leafHash)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Sync(pHashFile, pPruneList, position);
+
+	pHashFile->AddData(leafHash);
+	m_peaks.push_back(leafHash);
+
+	// Each parent's left sibling is the peak before its right sibling, so completed pairs are always the last 2 peaks.
+	uint64_t nextPosition = position;
+	while (MMRUtil::GetHeight(nextPosition + 1) > 0)
+	{
+		const Hash rightHash = m_peaks.back();
+		m_peaks.pop_back();
+		const Hash leftHash = m_peaks.back();
+		m_peaks.pop_back();
+
+		++nextPosition;
+
+		const Hash parentHash = MMRHashUtil::HashParentWithIndex(leftHash, rightHash, nextPosition);
+		pHashFile->AddData(parentHash);
+		m_peaks.push_back(parentHash);
+	}
+
+	m_size = nextPosition + 1;
+	m_rootOpt = std::nullopt;
+}
+
+Hash MMRPeaks::Root(std::shared_ptr<const HashFile> pHashFile, std::shared_ptr<const PruneList> pPruneList, const uint64_t size)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Sync(pHashFile, pPruneList, size);
+
+	if (!m_rootOpt.has_value())
+	{
+		Hash hash = ZERO_HASH;
+		for (auto iter = m_peaks.crbegin(); iter != m_peaks.crend(); iter++)
+		{
+			if (*iter != ZERO_HASH)
+			{
+				if (hash == ZERO_HASH)
+				{
+					hash = *iter;
+				}
+				else
+				{
+					hash = MMRHashUtil::HashParentWithIndex(*iter, hash, size);
+				}
+			}
+		}
+
+		m_rootOpt = std::make_optional(hash);
+	}
+
+	return m_rootOpt.value();
+}
+
+void MMRPeaks::Invalidate()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_valid = false;
+	m_peaks.clear();
+	m_rootOpt = std::nullopt;
+}
+
+void MMRPeaks::Sync(std::shared_ptr<const HashFile> pHashFile, std::shared_ptr<const PruneList> pPruneList, const uint64_t size)
+{
+	if (m_valid && m_size == size)
+	{
+		return;
+	}
+
+	const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(size);
+
+	m_peaks.clear();
+	m_peaks.reserve(peakIndices.size());
+	for (const uint64_t peakIndex : peakIndices)
+	{
+		m_peaks.push_back(MMRHashUtil::GetHashAt(pHashFile, peakIndex, pPruneList));
+	}
+
+	m_size = size;
+	m_valid = true;
+	m_rootOpt = std::nullopt;
+}
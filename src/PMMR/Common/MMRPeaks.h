@@ -0,0 +1,57 @@
+#pragma once
+
+#include "HashFile.h"
+#include "PruneList.h"
+
+#include <Crypto/Hash.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+//
+// The peak hashes of an MMR, kept in memory alongside its hash file.
+//
+// Appending a leaf pops the peaks it completes and pushes their parent, so new parents are hashed from the peaks
+// instead of reading their left siblings from the hash file, and the root of the MMR's current size is bagged from
+// the peaks (and remembered until the next append) instead of reading every peak from the hash file.
+//
+// The peaks are reloaded from the hash file (one read per peak) the first time they're needed after Invalidate,
+// which must be called whenever the hash file is rewound or rolled back.
+//
+class MMRPeaks
+{
+public:
+	MMRPeaks() : m_size(0), m_valid(false) { }
+
+	//
+	// Adds the leaf hash at the given position, along with the parent hashes it completes, to both the hash file and the peaks.
+	//
+	void Append(
+		std::shared_ptr<HashFile> pHashFile,
+		std::shared_ptr<const PruneList> pPruneList,
+		const uint64_t position,
+		const Hash& leafHash
+	);
+
+	//
+	// Returns the root of the MMR with the given size, which must be the MMR's current size.
+	//
+	Hash Root(
+		std::shared_ptr<const HashFile> pHashFile,
+		std::shared_ptr<const PruneList> pPruneList,
+		const uint64_t size
+	);
+
+	void Invalidate();
+
+private:
+	// Caller must hold m_mutex.
+	void Sync(std::shared_ptr<const HashFile> pHashFile, std::shared_ptr<const PruneList> pPruneList, const uint64_t size);
+
+	std::mutex m_mutex;
+	uint64_t m_size;
+	bool m_valid;
+	std::vector<Hash> m_peaks;
+	std::optional<Hash> m_rootOpt;
+};
@@ -28,7 +28,8 @@ public:
 		: m_pHashFile(pHashFile),
 		m_pLeafSet(pLeafSet),
 		m_pPruneList(pPruneList),
-		m_pDataFile(pDataFile)
+		m_pDataFile(pDataFile),
+		m_pPeaks(std::make_shared<MMRPeaks>())
 	{
 
 	}
@@ -50,7 +51,7 @@ public:
 		m_pDataFile->AddData(serializer.GetBytes());
 
 		// Add hashes
-		MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), m_pPruneList);
+		MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), m_pPruneList, *m_pPeaks);
 	}
 
 	void Remove(const uint64_t mmrIndex)
@@ -78,13 +79,14 @@ public:
 		SetDirty(true);
 
 		m_pHashFile->Rewind(size - m_pPruneList->GetShift(size - 1));
+		m_pPeaks->Invalidate();
 		m_pDataFile->Rewind(MMRUtil::GetNumLeaves(size - 1) - m_pPruneList->GetLeafShift(size - 1));
 		m_pLeafSet->Rewind(size, leavesToAdd);
 	}
 
 	virtual Hash Root(const uint64_t size) const override final
 	{
-		return MMRHashUtil::Root(m_pHashFile, size, m_pPruneList);
+		return MMRHashUtil::Root(m_pHashFile, size, m_pPruneList, *m_pPeaks);
 	}
 
 	Hash UBMTRoot(const uint64_t size) const
@@ -138,12 +140,8 @@ public:
 
 			try
 			{
-				std::vector<unsigned char> data = m_pDataFile->GetDataAt(shiftedIndex);
-				if (data.size() == DATA_SIZE)
-				{
-					ByteBuffer byteBuffer(std::move(data));
-					return std::make_unique<DATA_TYPE>(DATA_TYPE::Deserialize(byteBuffer));
-				}
+				ByteBuffer byteBuffer(m_pDataFile->GetDataPtrAt(shiftedIndex), DATA_SIZE);
+				return std::make_unique<DATA_TYPE>(DATA_TYPE::Deserialize(byteBuffer));
 			}
 			catch (FileException&)
 			{
@@ -154,6 +152,74 @@ public:
 		return std::unique_ptr<DATA_TYPE>(nullptr);
 	}
 
+	//
+	// Returns the MMR indices of up to maxLeaves unspent leaves, starting at the given leaf index.
+	// Only the leaf set is read, so the data can then be read in one go with GetDataAt.
+	//
+	std::vector<uint64_t> GetUnspentLeafIndices(const uint64_t startLeafIndex, const uint64_t maxLeaves) const
+	{
+		const uint64_t size = GetSize();
+
+		std::vector<uint64_t> mmrIndices;
+		uint64_t leafIndex = startLeafIndex;
+		while (mmrIndices.size() < maxLeaves)
+		{
+			const uint64_t mmrIndex = MMRUtil::GetPMMRIndex(leafIndex++);
+			if (mmrIndex >= size)
+			{
+				break;
+			}
+
+			if (m_pLeafSet->Contains(mmrIndex))
+			{
+				mmrIndices.push_back(mmrIndex);
+			}
+		}
+
+		return mmrIndices;
+	}
+
+	//
+	// Returns the data of the given unpruned leaves, which must be in ascending order.
+	// Leaves are stored in the data file in MMR order, so they're all read with one sequential read,
+	// from the first leaf's data through the last's, rather than one read per leaf.
+	//
+	std::vector<DATA_TYPE> GetDataAt(const std::vector<uint64_t>& mmrIndices) const
+	{
+		std::vector<DATA_TYPE> data;
+		if (mmrIndices.empty())
+		{
+			return data;
+		}
+
+		std::vector<uint64_t> positions;
+		positions.reserve(mmrIndices.size());
+		for (const uint64_t mmrIndex : mmrIndices)
+		{
+			if (!IsUnpruned(mmrIndex))
+			{
+				throw TXHASHSET_EXCEPTION(StringUtil::Format("Leaf {} not found", mmrIndex));
+			}
+
+			positions.push_back((MMRUtil::GetNumLeaves(mmrIndex) - 1) - m_pPruneList->GetLeafShift(mmrIndex));
+		}
+
+		const uint64_t firstPosition = positions.front();
+		const unsigned char* pRange = m_pDataFile->GetDataPtrRange(firstPosition, (positions.back() - firstPosition) + 1);
+
+		data.reserve(positions.size());
+		for (const uint64_t position : positions)
+		{
+			// Only a range that straddles a rewound batch isn't contiguous, so it's read one leaf at a time instead.
+			const unsigned char* pData = pRange != nullptr ? pRange + ((position - firstPosition) * DATA_SIZE) : m_pDataFile->GetDataPtrAt(position);
+
+			ByteBuffer byteBuffer(pData, DATA_SIZE);
+			data.emplace_back(DATA_TYPE::Deserialize(byteBuffer));
+		}
+
+		return data;
+	}
+
 	virtual void Commit() override final
 	{
 		if (IsDirty())
@@ -172,6 +238,7 @@ public:
 		{
 			LOG_INFO("Discarding changes since last flush");
 			m_pHashFile->Rollback();
+			m_pPeaks->Invalidate();
 			m_pDataFile->Rollback();
 			m_pLeafSet->Rollback();
 			SetDirty(false);
@@ -183,4 +250,5 @@ private:
 	std::shared_ptr<LeafSet> m_pLeafSet;
 	std::shared_ptr<PruneList> m_pPruneList;
 	std::shared_ptr<DataFile<DATA_SIZE>> m_pDataFile;
+	std::shared_ptr<MMRPeaks> m_pPeaks;
 };
\ No newline at end of file
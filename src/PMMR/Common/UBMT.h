@@ -0,0 +1,250 @@
+#pragma once
+
+#include "MMRUtil.h"
+#include "MMRHashUtil.h"
+
+#include <Core/BitmapFile.h>
+#include <Crypto/Hash.h>
+#include <Roaring.h>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <vector>
+
+//
+// In-memory "unspent bitmap merkle tree" for a LeafSet.
+// The leaf set bitmap is split into chunks of 1024 leaves, each serialized as 128 bytes (1 bit per leaf, left to right),
+// and the chunks are committed to using an MMR. The MMR nodes are kept in memory, and only the chunks that were touched
+// since the last root calculation are rehashed, along with their paths up to the peaks.
+//
+class UBMT
+{
+public:
+	static const uint64_t LEAVES_PER_CHUNK = 1024;
+	static const uint64_t BYTES_PER_CHUNK = LEAVES_PER_CHUNK / 8;
+
+	UBMT() : m_numLeaves(0), m_numChunks(0) { }
+
+	//
+	// Marks the chunk containing the given (leaf) MMR position as needing to be rehashed.
+	//
+	void MarkDirty(const uint64_t mmrIndex)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		const uint64_t chunkIndex = GetChunkIndex(mmrIndex);
+		m_dirtyChunks.insert(chunkIndex);
+		m_uncommittedChunks.insert(chunkIndex);
+	}
+
+	void MarkDirty(const Roaring& positions)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (auto iter = positions.begin(); iter != positions.end(); iter++)
+		{
+			const uint64_t chunkIndex = GetChunkIndex(iter.i.current_value - 1);
+			m_dirtyChunks.insert(chunkIndex);
+			m_uncommittedChunks.insert(chunkIndex);
+		}
+	}
+
+	void Commit()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_uncommittedChunks.clear();
+	}
+
+	//
+	// The bitmap is reverted to its last committed state, so every chunk changed since then must be rehashed.
+	//
+	void Rollback()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_dirtyChunks.insert(m_uncommittedChunks.cbegin(), m_uncommittedChunks.cend());
+		m_uncommittedChunks.clear();
+	}
+
+	//
+	// Discards the cached hashes of every chunk at or after the one containing the given MMR position.
+	//
+	void Truncate(const uint64_t mmrIndex)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		TruncateChunks(GetChunkIndex(mmrIndex));
+	}
+
+	Hash Root(const BitmapFile& bitmap, const uint64_t numLeaves)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		const uint64_t numChunks = (numLeaves + LEAVES_PER_CHUNK - 1) / LEAVES_PER_CHUNK;
+		if (numLeaves != m_numLeaves)
+		{
+			// The last chunk is zero-padded past numLeaves, so it changes whenever the number of leaves does.
+			const uint64_t lastChunk = (std::min)(numLeaves, m_numLeaves) / LEAVES_PER_CHUNK;
+			m_dirtyChunks.insert(lastChunk);
+			m_numLeaves = numLeaves;
+		}
+
+		TruncateChunks(numChunks);
+
+		// Rehash the dirty chunks that are already in the MMR.
+		for (auto iter = m_dirtyChunks.begin(); iter != m_dirtyChunks.end() && *iter < m_numChunks; iter++)
+		{
+			UpdateChunk(*iter, bitmap);
+		}
+		m_dirtyChunks.clear();
+
+		// Append any new chunks.
+		while (m_numChunks < numChunks)
+		{
+			AppendChunk(bitmap);
+		}
+
+		return CalculateRoot();
+	}
+
+private:
+	// Each chunk is a perfect subtree of the output MMR with 2 * LEAVES_PER_CHUNK - 1 nodes.
+	// For chunk c, that subtree begins at GetPMMRIndex(c * LEAVES_PER_CHUNK) = (2048 * c) - popcount(c),
+	// and its leaves are at the same offsets from there as the first LEAVES_PER_CHUNK leaves of any MMR.
+	static uint64_t GetChunkStart(const uint64_t chunkIndex)
+	{
+		return MMRUtil::GetPMMRIndex(chunkIndex * LEAVES_PER_CHUNK);
+	}
+
+	static uint64_t GetChunkIndex(const uint64_t mmrIndex)
+	{
+		uint64_t chunkIndex = mmrIndex / (2 * LEAVES_PER_CHUNK);
+		while (GetChunkStart(chunkIndex + 1) <= mmrIndex)
+		{
+			++chunkIndex;
+		}
+
+		return chunkIndex;
+	}
+
+	static const std::vector<uint64_t>& GetLeafOffsets()
+	{
+		static const std::vector<uint64_t> offsets = []() {
+			std::vector<uint64_t> leafOffsets(LEAVES_PER_CHUNK);
+			for (uint64_t i = 0; i < LEAVES_PER_CHUNK; i++)
+			{
+				leafOffsets[i] = MMRUtil::GetPMMRIndex(i);
+			}
+
+			return leafOffsets;
+		}();
+
+		return offsets;
+	}
+
+	std::vector<unsigned char> SerializeChunk(const uint64_t chunkIndex, const BitmapFile& bitmap) const
+	{
+		const uint64_t chunkStart = GetChunkStart(chunkIndex);
+		const uint64_t firstByte = chunkStart / 8;
+		const uint64_t lastByte = (chunkStart + (2 * LEAVES_PER_CHUNK) - 2) / 8;
+		const std::vector<uint8_t> bitmapBytes = bitmap.GetBytes(firstByte, (lastByte - firstByte) + 1);
+
+		const std::vector<uint64_t>& leafOffsets = GetLeafOffsets();
+		const uint64_t firstLeaf = chunkIndex * LEAVES_PER_CHUNK;
+		const uint64_t numLeavesInChunk = (std::min)(LEAVES_PER_CHUNK, m_numLeaves - firstLeaf);
+
+		std::vector<unsigned char> chunk(BYTES_PER_CHUNK, 0);
+		for (uint64_t i = 0; i < numLeavesInChunk; i++)
+		{
+			const uint64_t position = chunkStart + leafOffsets[i];
+			if ((bitmapBytes[(position / 8) - firstByte] >> (7 - (position % 8))) & 1)
+			{
+				chunk[i / 8] |= (uint8_t)(0x80 >> (i % 8));
+			}
+		}
+
+		return chunk;
+	}
+
+	void AppendChunk(const BitmapFile& bitmap)
+	{
+		uint64_t position = m_nodes.size();
+		m_nodes.push_back(MMRHashUtil::HashLeafWithIndex(SerializeChunk(m_numChunks, bitmap), position));
+		++m_numChunks;
+
+		uint64_t peak = 1;
+		while (MMRUtil::GetHeight(position + 1) > 0)
+		{
+			const uint64_t leftSiblingPosition = (position + 1) - (2 * peak);
+
+			++position;
+			peak *= 2;
+
+			m_nodes.push_back(MMRHashUtil::HashParentWithIndex(m_nodes[leftSiblingPosition], m_nodes[position - 1], position));
+		}
+	}
+
+	void UpdateChunk(const uint64_t chunkIndex, const BitmapFile& bitmap)
+	{
+		uint64_t position = MMRUtil::GetPMMRIndex(chunkIndex);
+		m_nodes[position] = MMRHashUtil::HashLeafWithIndex(SerializeChunk(chunkIndex, bitmap), position);
+
+		while (true)
+		{
+			const uint64_t parentPosition = MMRUtil::GetParentIndex(position);
+			if (parentPosition >= m_nodes.size())
+			{
+				break;
+			}
+
+			const uint64_t siblingPosition = MMRUtil::GetSiblingIndex(position);
+			if (siblingPosition < position)
+			{
+				m_nodes[parentPosition] = MMRHashUtil::HashParentWithIndex(m_nodes[siblingPosition], m_nodes[position], parentPosition);
+			}
+			else
+			{
+				m_nodes[parentPosition] = MMRHashUtil::HashParentWithIndex(m_nodes[position], m_nodes[siblingPosition], parentPosition);
+			}
+
+			position = parentPosition;
+		}
+	}
+
+	void TruncateChunks(const uint64_t numChunks)
+	{
+		if (numChunks < m_numChunks)
+		{
+			// An MMR with n leaves has GetPMMRIndex(n) nodes.
+			m_nodes.resize(MMRUtil::GetPMMRIndex(numChunks));
+			m_numChunks = numChunks;
+		}
+	}
+
+	Hash CalculateRoot() const
+	{
+		if (m_nodes.empty())
+		{
+			return ZERO_HASH;
+		}
+
+		Hash hash = ZERO_HASH;
+		const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(m_nodes.size());
+		for (auto iter = peakIndices.crbegin(); iter != peakIndices.crend(); iter++)
+		{
+			if (hash == ZERO_HASH)
+			{
+				hash = m_nodes[*iter];
+			}
+			else
+			{
+				hash = MMRHashUtil::HashParentWithIndex(m_nodes[*iter], hash, m_nodes.size());
+			}
+		}
+
+		return hash;
+	}
+
+	std::mutex m_mutex;
+	uint64_t m_numLeaves;
+	uint64_t m_numChunks;
+	std::set<uint64_t> m_dirtyChunks;
+	std::set<uint64_t> m_uncommittedChunks;
+	std::vector<Hash> m_nodes;
+};
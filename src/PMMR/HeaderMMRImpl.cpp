@@ -7,7 +7,7 @@
 #include <Config/Config.h>
 
 HeaderMMR::HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile)
-	: m_pLockedHashFile(pHashFile)
+	: m_pLockedHashFile(pHashFile), m_pPeaks(std::make_shared<MMRPeaks>())
 {
 
 }
@@ -36,6 +36,7 @@ void HeaderMMR::Rollback()
 	{
 		LOG_DEBUG("Discarding changes.");
 		m_batchDataOpt.value().hashFile->Rollback();
+		m_pPeaks->Invalidate();
 		SetDirty(false);
 	}
 }
@@ -47,6 +48,7 @@ void HeaderMMR::Rewind(const uint64_t size)
 	{
 		LOG_DEBUG_F("Rewinding to height {} - {} hashes", size, mmrSize);
 		m_batchDataOpt.value().hashFile->Rewind(mmrSize);
+		m_pPeaks->Invalidate();
 		SetDirty(true);
 	}
 }
@@ -61,7 +63,7 @@ void HeaderMMR::AddHeader(const BlockHeader& header)
 	const std::vector<unsigned char> serializedHeader = serializer.GetBytes();
 
 	// Add hashes
-	MMRHashUtil::AddHashes(m_batchDataOpt.value().hashFile.GetShared(), serializedHeader, nullptr);
+	MMRHashUtil::AddHashes(m_batchDataOpt.value().hashFile.GetShared(), serializedHeader, nullptr, *m_pPeaks);
 	SetDirty(true);
 }
 
@@ -71,11 +73,11 @@ Hash HeaderMMR::Root(const uint64_t lastHeight) const
 
 	if (m_batchDataOpt.has_value())
 	{
-		return MMRHashUtil::Root(m_batchDataOpt.value().hashFile.GetShared(), position, nullptr);
+		return MMRHashUtil::Root(m_batchDataOpt.value().hashFile.GetShared(), position, nullptr, *m_pPeaks);
 	}
 	else
 	{
-		return MMRHashUtil::Root(m_pLockedHashFile->Read().GetShared(), position, nullptr);
+		return MMRHashUtil::Root(m_pLockedHashFile->Read().GetShared(), position, nullptr, *m_pPeaks);
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/HashFile.h"
+#include "Common/MMRPeaks.h"
 
 #include <PMMR/HeaderMMR.h>
 #include <Core/Models/BlockHeader.h>
@@ -23,6 +24,7 @@ private:
 	HeaderMMR(std::shared_ptr<Locked<HashFile>> pHashFile);
 
 	std::shared_ptr<Locked<HashFile>> m_pLockedHashFile;
+	std::shared_ptr<MMRPeaks> m_pPeaks;
 
 	virtual void OnInitWrite() override final
 	{
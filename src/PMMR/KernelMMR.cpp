@@ -8,7 +8,8 @@
 
 KernelMMR::KernelMMR(std::shared_ptr<HashFile> pHashFile, std::shared_ptr<DataFile<KERNEL_SIZE>> pDataFile)
 	: m_pHashFile(pHashFile),
-	m_pDataFile(pDataFile)
+	m_pDataFile(pDataFile),
+	m_pPeaks(std::make_shared<MMRPeaks>())
 {
 
 }
@@ -23,7 +24,7 @@ std::shared_ptr<KernelMMR> KernelMMR::Load(const fs::path& txHashSetPath)
 
 Hash KernelMMR::Root(const uint64_t size) const
 {
-	return MMRHashUtil::Root(m_pHashFile, size, nullptr);
+	return MMRHashUtil::Root(m_pHashFile, size, nullptr, *m_pPeaks);
 }
 
 std::unique_ptr<TransactionKernel> KernelMMR::GetKernelAt(const uint64_t mmrIndex) const
@@ -32,13 +33,8 @@ std::unique_ptr<TransactionKernel> KernelMMR::GetKernelAt(const uint64_t mmrInde
 	{
 		const uint64_t numLeaves = MMRUtil::GetNumLeaves(mmrIndex);
 
-		std::vector<unsigned char> data = m_pDataFile->GetDataAt(numLeaves - 1);
-
-		if (data.size() == KERNEL_SIZE)
-		{
-			ByteBuffer byteBuffer(std::move(data));
-			return std::make_unique<TransactionKernel>(TransactionKernel::Deserialize(byteBuffer));
-		}
+		ByteBuffer byteBuffer(m_pDataFile->GetDataPtrAt(numLeaves - 1), KERNEL_SIZE);
+		return std::make_unique<TransactionKernel>(TransactionKernel::Deserialize(byteBuffer));
 	}
 
 	return std::unique_ptr<TransactionKernel>(nullptr);
@@ -52,6 +48,7 @@ std::vector<Hash> KernelMMR::GetLastLeafHashes(const uint64_t numHashes) const
 bool KernelMMR::Rewind(const uint64_t size)
 {
 	m_pHashFile->Rewind(size);
+	m_pPeaks->Invalidate();
 	m_pDataFile->Rewind(MMRUtil::GetNumLeaves(size - 1));
 	return true;
 }
@@ -67,6 +64,7 @@ void KernelMMR::Rollback()
 {
 	//LOG_DEBUG("Discarding changes since last flush");
 	m_pHashFile->Rollback();
+	m_pPeaks->Invalidate();
 	m_pDataFile->Rollback();
 }
 
@@ -78,5 +76,5 @@ void KernelMMR::ApplyKernel(const TransactionKernel& kernel)
 	m_pDataFile->AddData(serializer.GetBytes());
 
 	// Add hashes
-	MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), nullptr);
+	MMRHashUtil::AddHashes(m_pHashFile, serializer.GetBytes(), nullptr, *m_pPeaks);
 }
\ No newline at end of file
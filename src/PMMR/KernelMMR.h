@@ -2,6 +2,7 @@
 
 #include "Common/MMR.h"
 #include "Common/HashFile.h"
+#include "Common/MMRPeaks.h"
 
 #include <Core/DataFile.h>
 #include <Core/Models/TransactionKernel.h>
@@ -23,7 +24,7 @@ public:
 
 	virtual Hash Root(const uint64_t size) const override final;
 	virtual uint64_t GetSize() const override final { return m_pHashFile->GetSize(); }
-	virtual std::unique_ptr<Hash> GetHashAt(const uint64_t mmrIndex) const override final { return std::make_unique<Hash>(m_pHashFile->GetDataAt(mmrIndex)); }
+	virtual std::unique_ptr<Hash> GetHashAt(const uint64_t mmrIndex) const override final { return std::make_unique<Hash>(m_pHashFile->GetDataPtrAt(mmrIndex)); }
 	virtual std::vector<Hash> GetLastLeafHashes(const uint64_t numHashes) const override final;
 
 	virtual void Commit() override final;
@@ -36,4 +37,5 @@ private:
 
 	mutable std::shared_ptr<HashFile> m_pHashFile;
 	mutable std::shared_ptr<DataFile<KERNEL_SIZE>> m_pDataFile;
+	std::shared_ptr<MMRPeaks> m_pPeaks;
 };
\ No newline at end of file
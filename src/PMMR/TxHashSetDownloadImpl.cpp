@@ -0,0 +1,174 @@
+#include "TxHashSetDownloadImpl.h"
+#include "TxHashSetValidator.h"
+#include "KernelMMR.h"
+
+#include <PMMR/TxHashSetManager.h>
+#include <Core/Exceptions/FileException.h>
+#include <Common/Util/FileUtil.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+
+static const std::vector<std::string> KERNEL_ENTRIES = { "kernel/pmmr_data.bin", "kernel/pmmr_hash.bin" };
+
+TxHashSetDownload::TxHashSetDownload(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer)
+	: m_config(config), m_pHeader(pHeader), m_blockChainServer(blockChainServer), m_validated(false)
+{
+
+}
+
+std::shared_ptr<TxHashSetDownload> TxHashSetDownload::Create(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer)
+{
+	auto pDownload = std::shared_ptr<TxHashSetDownload>(new TxHashSetDownload(config, pHeader, blockChainServer));
+
+	const fs::path& stagingPath = config.GetNodeConfig().GetTxHashSetDownloadPath();
+	std::error_code errorCode;
+	fs::remove_all(stagingPath, errorCode);
+	for (const char* folder : { "kernel", "output", "rangeproof" })
+	{
+		const fs::path folderPath = stagingPath / folder;
+		if (!FileUtil::CreateDirectories(folderPath))
+		{
+			throw FILE_EXCEPTION_F("Failed to create {}", folderPath.u8string());
+		}
+	}
+
+	for (const std::string& entry : KERNEL_ENTRIES)
+	{
+		pDownload->m_destinations[entry] = stagingPath / entry;
+	}
+
+	// The leaf sets are named after the block they were rewound to, like pmmr_leaf.bin.<short hash>.
+	for (const std::string folder : { "output", "rangeproof" })
+	{
+		for (const char* file : { "pmmr_data.bin", "pmmr_hash.bin", "pmmr_prun.bin" })
+		{
+			pDownload->m_destinations[folder + "/" + file] = stagingPath / folder / file;
+		}
+
+		pDownload->m_destinations[folder + "/pmmr_leaf.bin." + pHeader->ShortHash()] = stagingPath / folder / "pmmr_leaf.bin";
+	}
+
+	TxHashSetDownload* pDownloadRaw = pDownload.get();
+	pDownload->m_pZipStream = std::make_unique<ZipStream>(
+		[pDownloadRaw](const std::string& entry) { return pDownloadRaw->GetDestination(entry); },
+		[pDownloadRaw](const std::string& entry) { pDownloadRaw->OnEntryExtracted(entry); }
+	);
+
+	return pDownload;
+}
+
+TxHashSetDownload::~TxHashSetDownload()
+{
+	// Close any partially extracted entry, and let kernel validation finish, before removing the staged files.
+	m_pZipStream.reset();
+	if (m_kernelsValid.valid())
+	{
+		m_kernelsValid.wait();
+	}
+
+	std::error_code errorCode;
+	fs::remove_all(m_config.GetNodeConfig().GetTxHashSetDownloadPath(), errorCode);
+}
+
+void TxHashSetDownload::Write(const unsigned char* pData, const size_t numBytes)
+{
+	m_pZipStream->Write(pData, numBytes);
+}
+
+fs::path TxHashSetDownload::GetDestination(const std::string& entry) const
+{
+	// Repeated and unsafe entry names are already rejected by the ZipStream.
+	auto iter = m_destinations.find(entry);
+	return iter != m_destinations.end() ? iter->second : fs::path();
+}
+
+void TxHashSetDownload::OnEntryExtracted(const std::string& entry)
+{
+	LOG_DEBUG_F("Extracted {}", entry);
+	m_extracted.insert(entry);
+
+	const bool kernelsExtracted = std::all_of(
+		KERNEL_ENTRIES.cbegin(),
+		KERNEL_ENTRIES.cend(),
+		[this](const std::string& kernelEntry) { return m_extracted.count(kernelEntry) > 0; }
+	);
+
+	if (kernelsExtracted && !m_kernelsValid.valid())
+	{
+		LOG_INFO("Kernel MMR extracted. Validating it while the rest of the TxHashSet downloads.");
+		m_kernelsValid = std::async(std::launch::async, [this]() { return ValidateKernels(); });
+	}
+}
+
+bool TxHashSetDownload::ValidateKernels() const
+{
+	try
+	{
+		std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(m_config.GetNodeConfig().GetTxHashSetDownloadPath());
+		pKernelMMR->Rewind(m_pHeader->GetKernelMMRSize());
+
+		const bool valid = TxHashSetValidator(m_blockChainServer).ValidateKernels(pKernelMMR, *m_pHeader);
+		pKernelMMR->Rollback();
+
+		LOG_INFO_F("Kernel MMR validation {}", valid ? "succeeded" : "failed");
+		return valid;
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Kernel MMR validation failed with error: {}", e.what());
+	}
+
+	return false;
+}
+
+bool TxHashSetDownload::Finish()
+{
+	if (!m_pZipStream->IsFinished())
+	{
+		LOG_ERROR("TxHashSet zip ended before its central directory");
+		return false;
+	}
+
+	for (const auto& destination : m_destinations)
+	{
+		if (m_extracted.count(destination.first) == 0)
+		{
+			LOG_ERROR_F("TxHashSet zip is missing {}", destination.first);
+			return false;
+		}
+	}
+
+	if (!m_kernelsValid.get())
+	{
+		LOG_ERROR("Invalid kernel MMR");
+		return false;
+	}
+
+	m_validated = true;
+	return true;
+}
+
+ITxHashSetPtr TxHashSetDownload::Install()
+{
+	if (!m_validated)
+	{
+		LOG_ERROR("TxHashSet download hasn't been validated");
+		return nullptr;
+	}
+
+	const fs::path& txHashSetPath = m_config.GetNodeConfig().GetTxHashSetPath();
+	const fs::path& stagingPath = m_config.GetNodeConfig().GetTxHashSetDownloadPath();
+	for (const char* folder : { "kernel", "output", "rangeproof" })
+	{
+		std::error_code errorCode;
+		fs::remove_all(txHashSetPath / folder, errorCode);
+
+		fs::rename(stagingPath / folder, txHashSetPath / folder, errorCode);
+		if (errorCode)
+		{
+			throw FILE_EXCEPTION_F("Failed to move {} into {}", (stagingPath / folder).u8string(), txHashSetPath.u8string());
+		}
+	}
+
+	return TxHashSetManager::LoadExtracted(m_config, m_pHeader);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Zip/ZipStream.h"
+
+#include <PMMR/TxHashSetDownload.h>
+#include <Config/Config.h>
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+class TxHashSetDownload : public ITxHashSetDownload
+{
+public:
+	static std::shared_ptr<TxHashSetDownload> Create(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer);
+	virtual ~TxHashSetDownload();
+
+	virtual BlockHeaderPtr GetHeader() const override final { return m_pHeader; }
+	virtual void Write(const unsigned char* pData, const size_t numBytes) override final;
+	virtual bool Finish() override final;
+	virtual ITxHashSetPtr Install() override final;
+
+private:
+	TxHashSetDownload(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer);
+
+	fs::path GetDestination(const std::string& entry) const;
+	void OnEntryExtracted(const std::string& entry);
+	bool ValidateKernels() const;
+
+	const Config& m_config;
+	BlockHeaderPtr m_pHeader;
+	const IBlockChainServer& m_blockChainServer;
+
+	// Maps each zip entry that's needed to the path in the staging directory it's extracted to. Any other entries are skipped.
+	std::unordered_map<std::string, fs::path> m_destinations;
+	std::set<std::string> m_extracted;
+	std::unique_ptr<ZipStream> m_pZipStream;
+	std::future<bool> m_kernelsValid;
+	bool m_validated;
+};
@@ -34,59 +34,105 @@ bool TxHashSet::IsUnspent(const OutputLocation& location) const
 
 bool TxHashSet::IsValid(std::shared_ptr<const IBlockDB> pBlockDB, const Transaction& transaction) const
 {
+	const std::vector<TransactionInput>& inputs = transaction.GetBody().GetInputs();
+	const std::vector<TransactionOutput>& outputs = transaction.GetBody().GetOutputs();
+
+	// Look up the positions of every input and output in a single batch.
+	std::vector<Commitment> commitments;
+	commitments.reserve(inputs.size() + outputs.size());
+	for (const TransactionInput& input : inputs)
+	{
+		commitments.push_back(input.GetCommitment());
+	}
+
+	for (const TransactionOutput& output : outputs)
+	{
+		commitments.push_back(output.GetCommitment());
+	}
+
+	const std::vector<std::unique_ptr<OutputLocation>> outputPositions = pBlockDB->GetOutputPositions(commitments);
+
 	// Validate inputs
-	const uint64_t maximumBlockHeight = (std::max)(m_pBlockHeader->GetHeight() + 1, Consensus::COINBASE_MATURITY) - Consensus::COINBASE_MATURITY;
-	for (const TransactionInput& input : transaction.GetBody().GetInputs())
+	for (size_t i = 0; i < inputs.size(); i++)
 	{
-		const Commitment& commitment = input.GetCommitment();
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(commitment);
-		if (pOutputPosition == nullptr)
+		if (!IsValidInput(inputs[i], outputPositions[i].get()))
 		{
 			return false;
 		}
+	}
 
-		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
-		if (pOutput == nullptr || pOutput->GetCommitment() != commitment || pOutput->GetFeatures() != input.GetFeatures())
+	// Validate outputs
+	for (size_t i = 0; i < outputs.size(); i++)
+	{
+		if (!IsUniqueOutput(outputs[i].GetCommitment(), outputPositions[inputs.size() + i].get()))
 		{
-			LOG_DEBUG_F("Output ({}) not found at mmrIndex ({})",  commitment, pOutputPosition->GetMMRIndex());
 			return false;
 		}
+	}
+
+	return true;
+}
+
+bool TxHashSet::IsValidInput(std::shared_ptr<const IBlockDB> pBlockDB, const TransactionInput& input) const
+{
+	return IsValidInput(input, pBlockDB->GetOutputPosition(input.GetCommitment()).get());
+}
+
+bool TxHashSet::IsValidInput(const TransactionInput& input, const OutputLocation* pOutputPosition) const
+{
+	const Commitment& commitment = input.GetCommitment();
+	if (pOutputPosition == nullptr)
+	{
+		return false;
+	}
+
+	std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
+	if (pOutput == nullptr || pOutput->GetCommitment() != commitment || pOutput->GetFeatures() != input.GetFeatures())
+	{
+		LOG_DEBUG_F("Output ({}) not found at mmrIndex ({})",  commitment, pOutputPosition->GetMMRIndex());
+		return false;
+	}
 
-		if (input.GetFeatures() == EOutputFeatures::COINBASE_OUTPUT)
+	if (input.GetFeatures() == EOutputFeatures::COINBASE_OUTPUT)
+	{
+		const uint64_t maximumBlockHeight = (std::max)(m_pBlockHeader->GetHeight() + 1, Consensus::COINBASE_MATURITY) - Consensus::COINBASE_MATURITY;
+		if (pOutputPosition->GetBlockHeight() > maximumBlockHeight)
 		{
-			if (pOutputPosition->GetBlockHeight() > maximumBlockHeight)
-			{
-				LOG_INFO_F("Coinbase ({}) not mature", transaction);
-				return false;
-			}
+			LOG_INFO_F("Coinbase ({}) not mature", commitment);
+			return false;
 		}
 	}
 
-	// Validate outputs
-	for (const TransactionOutput& output : transaction.GetBody().GetOutputs())
+	return true;
+}
+
+bool TxHashSet::IsUniqueOutput(std::shared_ptr<const IBlockDB> pBlockDB, const Commitment& commitment) const
+{
+	return IsUniqueOutput(commitment, pBlockDB->GetOutputPosition(commitment).get());
+}
+
+bool TxHashSet::IsUniqueOutput(const Commitment& commitment, const OutputLocation* pOutputPosition) const
+{
+	if (pOutputPosition != nullptr)
 	{
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(output.GetCommitment());
-		if (pOutputPosition != nullptr)
+		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
+		if (pOutput != nullptr && pOutput->GetCommitment() == commitment)
 		{
-			std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
-			if (pOutput != nullptr && pOutput->GetCommitment() == output.GetCommitment())
-			{
-				return false;
-			}
+			return false;
 		}
 	}
 
 	return true;
 }
 
-std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, SyncStatus& syncStatus)
+std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, const bool kernelsValidated, SyncStatus& syncStatus)
 {
 	std::unique_ptr<BlockSums> pBlockSums = nullptr;
 
 	try
 	{
 		LOG_INFO("Validating TxHashSet for block " + header.GetHash().ToHex());
-		pBlockSums = TxHashSetValidator(blockChainServer).Validate(*this, header, syncStatus);
+		pBlockSums = TxHashSetValidator(blockChainServer).Validate(*this, header, kernelsValidated, syncStatus);
 		if (pBlockSums != nullptr)
 		{
 			LOG_INFO("Successfully validated TxHashSet");
@@ -102,16 +148,33 @@ std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& heade
 
 bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock& block)
 {
+	const std::vector<TransactionInput>& inputs = block.GetInputs();
+	const std::vector<TransactionOutput>& outputs = block.GetOutputs();
+
+	// Look up the positions of every input and output in a single batch.
+	std::vector<Commitment> commitments;
+	commitments.reserve(inputs.size() + outputs.size());
+	for (const TransactionInput& input : inputs)
+	{
+		commitments.push_back(input.GetCommitment());
+	}
+
+	for (const TransactionOutput& output : outputs)
+	{
+		commitments.push_back(output.GetCommitment());
+	}
+
+	const std::vector<std::unique_ptr<OutputLocation>> outputPositions = pBlockDB->GetOutputPositions(commitments);
+
 	Roaring blockInputBitmap;
 
 	// Prune inputs
-	for (const TransactionInput& input : block.GetInputs())
+	for (size_t i = 0; i < inputs.size(); i++)
 	{
-		const Commitment& commitment = input.GetCommitment();
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(commitment);
+		const OutputLocation* pOutputPosition = outputPositions[i].get();
 		if (pOutputPosition == nullptr)
 		{
-			LOG_WARNING_F("Output position not found for commitment ({}) in block ({})", commitment, block);
+			LOG_WARNING_F("Output position not found for commitment ({}) in block ({})", inputs[i].GetCommitment(), block);
 			return false;
 		}
 
@@ -125,9 +188,12 @@ bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock&
 	pBlockDB->AddBlockInputBitmap(block.GetHash(), blockInputBitmap);
 
 	// Append new outputs
-	for (const TransactionOutput& output : block.GetOutputs())
+	std::vector<std::pair<Commitment, OutputLocation>> newOutputPositions;
+	newOutputPositions.reserve(outputs.size());
+	for (size_t i = 0; i < outputs.size(); i++)
 	{
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(output.GetCommitment());
+		const TransactionOutput& output = outputs[i];
+		const OutputLocation* pOutputPosition = outputPositions[inputs.size() + i].get();
 		if (pOutputPosition != nullptr)
 		{
 			if (pOutputPosition->GetMMRIndex() < m_pBlockHeader->GetOutputMMRSize())
@@ -146,9 +212,11 @@ bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock&
 		m_pOutputPMMR->Append(OutputIdentifier::FromOutput(output));
 		m_pRangeProofPMMR->Append(output.GetRangeProof());
 
-		pBlockDB->AddOutputPosition(output.GetCommitment(), OutputLocation(mmrIndex, blockHeight));
+		newOutputPositions.emplace_back(std::make_pair(output.GetCommitment(), OutputLocation(mmrIndex, blockHeight)));
 	}
 
+	pBlockDB->AddOutputPositions(newOutputPositions);
+
 	// Append new kernels
 	for (const TransactionKernel& kernel : block.GetKernels())
 	{
@@ -200,14 +268,17 @@ bool TxHashSet::ValidateRoots(const BlockHeader& blockHeader) const
 void TxHashSet::SaveOutputPositions(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& blockHeader, const uint64_t firstOutputIndex)
 {
 	const uint64_t size = blockHeader.GetOutputMMRSize();
+	std::vector<std::pair<Commitment, OutputLocation>> outputPositions;
 	for (uint64_t mmrIndex = firstOutputIndex; mmrIndex < size; mmrIndex++)
 	{
 		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(mmrIndex);
 		if (pOutput != nullptr)
 		{
-			pBlockDB->AddOutputPosition(pOutput->GetCommitment(), OutputLocation(mmrIndex, blockHeader.GetHeight()));
+			outputPositions.emplace_back(std::make_pair(pOutput->GetCommitment(), OutputLocation(mmrIndex, blockHeader.GetHeight())));
 		}
 	}
+
+	pBlockDB->AddOutputPositions(outputPositions);
 }
 
 std::vector<Hash> TxHashSet::GetLastKernelHashes(const uint64_t numberOfKernels) const
@@ -228,30 +299,32 @@ std::vector<Hash> TxHashSet::GetLastRangeProofHashes(const uint64_t numberOfRang
 OutputRange TxHashSet::GetOutputsByLeafIndex(std::shared_ptr<const IBlockDB> pBlockDB, const uint64_t startIndex, const uint64_t maxNumOutputs) const
 {
 	const uint64_t outputSize = m_pOutputPMMR->GetSize();
-	
-	uint64_t leafIndex = startIndex;
+
+	// The outputs and rangeproofs are each read sequentially from their data files, and their positions are then looked up in a single batch.
+	const std::vector<uint64_t> mmrIndices = m_pOutputPMMR->GetUnspentLeafIndices(startIndex, maxNumOutputs);
+	std::vector<OutputIdentifier> identifiers = m_pOutputPMMR->GetDataAt(mmrIndices);
+	std::vector<RangeProof> rangeProofs = m_pRangeProofPMMR->GetDataAt(mmrIndices);
+
+	std::vector<Commitment> commitments;
+	commitments.reserve(identifiers.size());
+	for (const OutputIdentifier& identifier : identifiers)
+	{
+		commitments.push_back(identifier.GetCommitment());
+	}
+
+	const std::vector<std::unique_ptr<OutputLocation>> outputPositions = pBlockDB->GetOutputPositions(commitments);
+
 	std::vector<OutputDTO> outputs;
-	outputs.reserve(maxNumOutputs);
-	while (outputs.size() < maxNumOutputs)
+	outputs.reserve(identifiers.size());
+	for (size_t i = 0; i < identifiers.size(); i++)
 	{
-		const uint64_t mmrIndex = MMRUtil::GetPMMRIndex(leafIndex++);
-		if (mmrIndex >= outputSize)
+		const std::unique_ptr<OutputLocation>& pOutputPosition = outputPositions[i];
+		if (pOutputPosition == nullptr || pOutputPosition->GetMMRIndex() != mmrIndices[i])
 		{
-			break;
+			throw TXHASHSET_EXCEPTION(StringUtil::Format("Failed to build OutputDTO at index {}", mmrIndices[i]));
 		}
 
-		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(mmrIndex);
-		if (pOutput != nullptr)
-		{
-			std::unique_ptr<RangeProof> pRangeProof = m_pRangeProofPMMR->GetAt(mmrIndex);
-			std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(pOutput->GetCommitment());
-			if (pRangeProof == nullptr || pOutputPosition == nullptr || pOutputPosition->GetMMRIndex() != mmrIndex)
-			{
-				throw TXHASHSET_EXCEPTION(StringUtil::Format("Failed to build OutputDTO at index {}", mmrIndex));
-			}
-
-			outputs.emplace_back(OutputDTO(false, *pOutput, *pOutputPosition, *pRangeProof));
-		}
+		outputs.emplace_back(OutputDTO(false, identifiers[i], *pOutputPosition, rangeProofs[i]));
 	}
 
 	const uint64_t maxLeafIndex = MMRUtil::GetNumLeaves(outputSize - 1);
@@ -25,7 +25,9 @@ public:
 
 	virtual bool IsUnspent(const OutputLocation& location) const override final;
 	virtual bool IsValid(std::shared_ptr<const IBlockDB> pBlockDB, const Transaction& transaction) const override final;
-	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, SyncStatus& syncStatus) override final;
+	virtual bool IsValidInput(std::shared_ptr<const IBlockDB> pBlockDB, const TransactionInput& input) const override final;
+	virtual bool IsUniqueOutput(std::shared_ptr<const IBlockDB> pBlockDB, const Commitment& commitment) const override final;
+	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, const bool kernelsValidated, SyncStatus& syncStatus) override final;
 	virtual bool ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock& block) override final;
 	virtual bool ValidateRoots(const BlockHeader& blockHeader) const override final;
 	virtual void SaveOutputPositions(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& blockHeader, const uint64_t firstOutputIndex) override final;
@@ -46,6 +48,10 @@ public:
 	std::shared_ptr<RangeProofPMMR> GetRangeProofPMMR() { return m_pRangeProofPMMR; }
 
 private:
+	// Same as the public versions, but with the output's position already looked up (nullptr if it isn't known).
+	bool IsValidInput(const TransactionInput& input, const OutputLocation* pOutputPosition) const;
+	bool IsUniqueOutput(const Commitment& commitment, const OutputLocation* pOutputPosition) const;
+
 	std::shared_ptr<KernelMMR> m_pKernelMMR;
 	std::shared_ptr<OutputPMMR> m_pOutputPMMR;
 	std::shared_ptr<RangeProofPMMR> m_pRangeProofPMMR;
@@ -1,15 +1,22 @@
 #include <PMMR/TxHashSetManager.h>
 
 #include "TxHashSetImpl.h"
+#include "TxHashSetDownloadImpl.h"
+#include "Zip/TxHashSetSnapshot.h"
 #include "Zip/TxHashSetZip.h"
-#include "Zip/Zipper.h"
 
+#include <Core/Exceptions/FileException.h>
 #include <Common/Util/FileUtil.h>
 #include <Common/Util/StringUtil.h>
 #include <Infrastructure/Logger.h>
 
 TxHashSetManager::TxHashSetManager(const Config& config)
-	: m_config(config), m_pTxHashSet(nullptr)
+	: m_config(config), m_pTxHashSet(nullptr), m_pSnapshotHeader(nullptr), m_pSnapshot(nullptr), m_nextSnapshotId(0), m_numRewinds(0)
+{
+
+}
+
+TxHashSetManager::~TxHashSetManager()
 {
 
 }
@@ -36,42 +43,7 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config,
 		LOG_INFO_F("{} extracted successfully", zipFilePath);
 		FileUtil::RemoveFile(zipFilePath.u8string());
 
-		// Rewind Kernel MMR
-		std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(config.GetNodeConfig().GetTxHashSetPath());
-		pKernelMMR->Rewind(pHeader->GetKernelMMRSize());
-		pKernelMMR->Commit();
-
-		// Create output BitmapFile from Roaring file
-		const std::string leafPath = config.GetNodeConfig().GetTxHashSetPath().u8string() + "output/pmmr_leaf.bin";
-		Roaring outputBitmap;
-		std::vector<unsigned char> outputBytes;
-		if (FileUtil::ReadFile(leafPath, outputBytes))
-		{
-			outputBitmap = Roaring::readSafe((const char*)outputBytes.data(), outputBytes.size());
-		}
-		BitmapFile::Create(config.GetNodeConfig().GetTxHashSetPath().u8string() + "output/pmmr_leafset.bin", outputBitmap);
-
-		// Rewind Output MMR
-		std::shared_ptr<OutputPMMR> pOutputPMMR = OutputPMMR::Load(config.GetNodeConfig().GetTxHashSetPath());
-		pOutputPMMR->Rewind(pHeader->GetOutputMMRSize(), Roaring());
-		pOutputPMMR->Commit();
-
-		// Create rangeproof BitmapFile from Roaring file
-		const std::string rangeproofPath = config.GetNodeConfig().GetTxHashSetPath().u8string() + "rangeproof/pmmr_leaf.bin";
-		Roaring rangeproofBitmap;
-		std::vector<unsigned char> rangeproofBytes;
-		if (FileUtil::ReadFile(rangeproofPath, rangeproofBytes))
-		{
-			rangeproofBitmap = Roaring::readSafe((const char*)rangeproofBytes.data(), rangeproofBytes.size());
-		}
-		BitmapFile::Create(config.GetNodeConfig().GetTxHashSetPath().u8string() + "rangeproof/pmmr_leafset.bin", rangeproofBitmap);
-
-		// Rewind RangeProof MMR
-		std::shared_ptr<RangeProofPMMR> pRangeProofPMMR = RangeProofPMMR::Load(config.GetNodeConfig().GetTxHashSetPath());
-		pRangeProofPMMR->Rewind(pHeader->GetOutputMMRSize(), Roaring());
-		pRangeProofPMMR->Commit();
-
-		return std::shared_ptr<TxHashSet>(new TxHashSet(pKernelMMR, pOutputPMMR, pRangeProofPMMR, pHeader));
+		return LoadExtracted(config, pHeader);
 	}
 	else
 	{
@@ -81,69 +53,172 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config,
 	return nullptr;
 }
 
-bool TxHashSetManager::SaveSnapshot(std::shared_ptr<const IBlockDB> pBlockDB, BlockHeaderPtr pHeader, const std::string& zipFilePath)
+ITxHashSetDownloadPtr TxHashSetManager::BeginDownload(const Config& config, BlockHeaderPtr pHeader, const IBlockChainServer& blockChainServer)
+{
+	return TxHashSetDownload::Create(config, pHeader, blockChainServer);
+}
+
+std::shared_ptr<ITxHashSet> TxHashSetManager::LoadExtracted(const Config& config, BlockHeaderPtr pHeader)
 {
-	if (m_pTxHashSet == nullptr)
+	// Rewind Kernel MMR
+	std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(config.GetNodeConfig().GetTxHashSetPath());
+	pKernelMMR->Rewind(pHeader->GetKernelMMRSize());
+	pKernelMMR->Commit();
+
+	// Create output BitmapFile from Roaring file
+	const std::string leafPath = config.GetNodeConfig().GetTxHashSetPath().u8string() + "output/pmmr_leaf.bin";
+	Roaring outputBitmap;
+	std::vector<unsigned char> outputBytes;
+	if (FileUtil::ReadFile(leafPath, outputBytes))
 	{
-		return false;
+		outputBitmap = Roaring::readSafe((const char*)outputBytes.data(), outputBytes.size());
 	}
+	BitmapFile::Create(config.GetNodeConfig().GetTxHashSetPath().u8string() + "output/pmmr_leafset.bin", outputBitmap);
+
+	// Rewind Output MMR
+	std::shared_ptr<OutputPMMR> pOutputPMMR = OutputPMMR::Load(config.GetNodeConfig().GetTxHashSetPath());
+	pOutputPMMR->Rewind(pHeader->GetOutputMMRSize(), Roaring());
+	pOutputPMMR->Commit();
+
+	// Create rangeproof BitmapFile from Roaring file
+	const std::string rangeproofPath = config.GetNodeConfig().GetTxHashSetPath().u8string() + "rangeproof/pmmr_leaf.bin";
+	Roaring rangeproofBitmap;
+	std::vector<unsigned char> rangeproofBytes;
+	if (FileUtil::ReadFile(rangeproofPath, rangeproofBytes))
+	{
+		rangeproofBitmap = Roaring::readSafe((const char*)rangeproofBytes.data(), rangeproofBytes.size());
+	}
+	BitmapFile::Create(config.GetNodeConfig().GetTxHashSetPath().u8string() + "rangeproof/pmmr_leafset.bin", rangeproofBitmap);
 
-	fs::path snapshotPath = fs::temp_directory_path() / "Snapshots" / pHeader->ShortHash();
-	const std::string snapshotDir = snapshotPath.u8string();
-	BlockHeaderPtr pFlushedHeader = nullptr;
+	// Rewind RangeProof MMR
+	std::shared_ptr<RangeProofPMMR> pRangeProofPMMR = RangeProofPMMR::Load(config.GetNodeConfig().GetTxHashSetPath());
+	pRangeProofPMMR->Rewind(pHeader->GetOutputMMRSize(), Roaring());
+	pRangeProofPMMR->Commit();
+
+	return std::shared_ptr<TxHashSet>(new TxHashSet(pKernelMMR, pOutputPMMR, pRangeProofPMMR, pHeader));
+}
+
+TxHashSetZipFilePtr TxHashSetManager::SaveSnapshot(std::shared_ptr<const IBlockDB> pBlockDB, BlockHeaderPtr pHeader)
+{
+	std::shared_ptr<Locked<ITxHashSet>> pTxHashSet = m_pTxHashSet;
+	if (pTxHashSet == nullptr)
+	{
+		return nullptr;
+	}
 
+	std::promise<TxHashSetZipFilePtr> promise;
+	uint64_t numRewinds = 0;
+	uint64_t snapshotId = 0;
 	{
-		// 1. Lock TxHashSet
-		auto reader = m_pTxHashSet->Read();
+		std::unique_lock<std::mutex> snapshotLock(m_snapshotMutex);
+		if (m_pSnapshot != nullptr && m_pSnapshotHeader->GetHash() == pHeader->GetHash() && FileUtil::Exists(m_pSnapshot->GetPath()))
+		{
+			LOG_DEBUG_F("Reusing snapshot for block {}", *pHeader);
+			return m_pSnapshot;
+		}
 
-		// 2. Copy to Snapshots/Hash // TODO: If already exists, just use that.
-		if (!FileUtil::CopyDirectory(m_config.GetNodeConfig().GetTxHashSetPath().u8string(), snapshotPath.u8string()))
+		if (m_pendingSnapshot.valid() && m_pendingHash == pHeader->GetHash())
 		{
-			return false;
+			std::shared_future<TxHashSetZipFilePtr> pendingSnapshot = m_pendingSnapshot;
+			snapshotLock.unlock();
+
+			LOG_DEBUG_F("Waiting for snapshot of block {}", *pHeader);
+			return pendingSnapshot.get();
 		}
 
-		pFlushedHeader = reader->GetFlushedBlockHeader();
+		m_pendingHash = pHeader->GetHash();
+		m_pendingSnapshot = promise.get_future().share();
+		numRewinds = m_numRewinds;
+		snapshotId = m_nextSnapshotId++;
 	}
 
+	TxHashSetZipFilePtr pZipFile = nullptr;
 	try
 	{
-		// 4. Load Snapshot TxHashSet
-		std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(snapshotDir);
-		std::shared_ptr<OutputPMMR> pOutputPMMR = OutputPMMR::Load(snapshotDir);
-		std::shared_ptr<RangeProofPMMR> pRangeProofPMMR = RangeProofPMMR::Load(snapshotDir);
-		TxHashSet snapshotTxHashSet(pKernelMMR, pOutputPMMR, pRangeProofPMMR, pFlushedHeader);
-
-		// 5. Rewind Snapshot TxHashSet
-		if (!snapshotTxHashSet.Rewind(pBlockDB, *pHeader))
+		pZipFile = WriteSnapshot(pTxHashSet, *pBlockDB, *pHeader, snapshotId);
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Failed to snapshot: {}", e.what());
+	}
+
+	{
+		std::unique_lock<std::mutex> snapshotLock(m_snapshotMutex);
+
+		// A zip that was written before a rewind may be of a block that's no longer on the chain, so it's sent, but not cached.
+		if (pZipFile != nullptr && m_numRewinds == numRewinds)
+		{
+			m_pSnapshotHeader = pHeader;
+			m_pSnapshot = pZipFile;
+		}
+
+		if (m_pendingHash == pHeader->GetHash())
 		{
-			FileUtil::RemoveFile(snapshotDir);
-			return false;
+			m_pendingSnapshot = std::shared_future<TxHashSetZipFilePtr>();
 		}
+	}
 
-		// 6. Flush Snapshot TxHashSet
-		snapshotTxHashSet.Commit();
+	promise.set_value(pZipFile);
+	return pZipFile;
+}
 
-		// 7. Rename pmmr_leaf files
-		FileUtil::RenameFile(snapshotDir + "output/pmmr_leaf.bin", snapshotDir + "output/pmmr_leaf.bin." + pHeader->ShortHash());
-		FileUtil::RenameFile(snapshotDir + "rangeproof/pmmr_leaf.bin", snapshotDir + "rangeproof/pmmr_leaf.bin." + pHeader->ShortHash());
+void TxHashSetManager::OnRewind(const BlockHeader& header)
+{
+	std::unique_lock<std::mutex> snapshotLock(m_snapshotMutex);
+	++m_numRewinds;
 
-		// 8. Create Zip
-		const std::vector<std::string> pathsToZip = { snapshotDir + "kernel", snapshotDir + "output", snapshotDir + "rangeproof" };
-		if (!Zipper::CreateZipFile(zipFilePath, pathsToZip))
+	if (m_pSnapshotHeader != nullptr && m_pSnapshotHeader->GetHeight() > header.GetHeight())
+	{
+		LOG_DEBUG_F("Dropping snapshot for rewound block {}", *m_pSnapshotHeader);
+		m_pSnapshotHeader = nullptr;
+		m_pSnapshot = nullptr;
+	}
+}
+
+TxHashSetZipFilePtr TxHashSetManager::WriteSnapshot(
+	std::shared_ptr<Locked<ITxHashSet>> pTxHashSet,
+	const IBlockDB& blockDB,
+	const BlockHeader& header,
+	const uint64_t snapshotId)
+{
+	// Each zip gets its own path, since an earlier zip (even of the same block) is only removed once no peer is reading it.
+	const fs::path snapshotDir = fs::temp_directory_path() / "Snapshots";
+	const std::string zipFilePath = (snapshotDir / StringUtil::Format("TxHashSet.{}.{}.zip", header.ShortHash(), snapshotId)).u8string();
+	const std::string tempZipFilePath = zipFilePath + ".tmp";
+	FileUtil::CreateDirectories(snapshotDir.u8string());
+
+	{
+		// The zip is streamed from the live files, so the TxHashSet stays read-locked until it's written.
+		// Otherwise a reorg could rewind and overwrite the end of the file prefixes that are being zipped.
+		auto reader = pTxHashSet->Read();
+		std::unique_ptr<TxHashSetSnapshot> pSnapshot = TxHashSetSnapshot::Capture(
+			m_config.GetNodeConfig().GetTxHashSetPath(),
+			blockDB,
+			*reader->GetFlushedBlockHeader(),
+			header
+		);
+		if (pSnapshot == nullptr)
+		{
+			return nullptr;
+		}
+
+		try
 		{
-			FileUtil::RemoveFile(snapshotDir);
-			return false;
+			pSnapshot->WriteZip(tempZipFilePath);
+		}
+		catch (std::exception&)
+		{
+			FileUtil::RemoveFile(tempZipFilePath);
+			throw;
 		}
 	}
-	catch (std::exception& e)
+
+	if (!FileUtil::RenameFile(tempZipFilePath, zipFilePath))
 	{
-		LOG_ERROR_F("Failed to snapshot: {}", e.what());
-		FileUtil::RemoveFile(snapshotDir);
-		return false;
+		FileUtil::RemoveFile(tempZipFilePath);
+		throw FILE_EXCEPTION_F("Failed to rename {}", tempZipFilePath);
 	}
 
-	// 9. Delete Snapshots/Hash folder
-	FileUtil::RemoveFile(snapshotDir);
-
-	return true;
+	LOG_INFO_F("Created snapshot {} for block {}", zipFilePath, header);
+	return std::make_shared<const TxHashSetZipFile>(zipFilePath);
 }
\ No newline at end of file
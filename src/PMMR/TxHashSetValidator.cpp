@@ -11,7 +11,66 @@
 #include <Common/Util/HexUtil.h>
 #include <Infrastructure/Logger.h>
 #include <BlockChain/BlockChainServer.h>
-#include <thread>
+#include <Common/ThreadPool.h>
+#include <algorithm>
+#include <functional>
+
+// Chunk sizes are in mmr indices (roughly half of which are leaves), except for kernel history which is in block heights.
+static const uint64_t MMR_HASH_CHUNK_SIZE = 1 << 16;
+static const uint64_t KERNEL_HISTORY_CHUNK_SIZE = 1000;
+static const uint64_t RANGEPROOF_CHUNK_SIZE = 2000;
+static const uint64_t KERNEL_SIGNATURE_CHUNK_SIZE = 4000;
+
+// Each phase's share of the validation progress, in percent.
+static const uint64_t KERNEL_HISTORY_SHARE = 10;
+static const uint64_t KERNEL_SIGNATURE_SHARE = 30;
+
+//
+// Splits [0, size) into chunks, and submits a task to validate each one. valid is set to false if any chunk fails,
+// after which the remaining chunks are skipped. onChunkValidated is called after each chunk that passes.
+//
+static void SubmitChunks(
+	ThreadPool& threadPool,
+	std::vector<std::future<void>>& tasks,
+	std::atomic_bool& valid,
+	const std::string& phase,
+	const uint64_t size,
+	const uint64_t chunkSize,
+	std::function<bool(uint64_t, uint64_t)> validateRange,
+	std::function<void()> onChunkValidated)
+{
+	const uint64_t numChunks = std::max((uint64_t)1, (size + chunkSize - 1) / chunkSize);
+	for (uint64_t chunk = 0; chunk < numChunks; chunk++)
+	{
+		const uint64_t first = chunk * chunkSize;
+		const uint64_t last = std::min(size, first + chunkSize);
+		tasks.emplace_back(threadPool.Submit([&valid, phase, first, last, validateRange, onChunkValidated]()
+		{
+			if (!valid)
+			{
+				return;
+			}
+
+			try
+			{
+				if (!validateRange(first, last))
+				{
+					LOG_ERROR_F("{} failed for range [{}, {})", phase, first, last);
+					valid = false;
+					return;
+				}
+			}
+			catch (std::exception& e)
+			{
+				LOG_ERROR_F("{} failed for range [{}, {}) with error: {}", phase, first, last, e.what());
+				valid = false;
+				return;
+			}
+
+			onChunkValidated();
+		}));
+	}
+}
 
 TxHashSetValidator::TxHashSetValidator(const IBlockChainServer& blockChainServer)
 	: m_blockChainServer(blockChainServer)
@@ -19,7 +78,7 @@ TxHashSetValidator::TxHashSetValidator(const IBlockChainServer& blockChainServer
 
 }
 
-std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
+std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, const bool kernelsValidated, SyncStatus& syncStatus) const
 {
 	std::shared_ptr<const KernelMMR> pKernelMMR = txHashSet.GetKernelMMR();
 	std::shared_ptr<const OutputPMMR> pOutputPMMR = txHashSet.GetOutputPMMR();
@@ -34,29 +93,6 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 
 	syncStatus.UpdateProcessingStatus(5);
 
-	// Validate MMR hashes in parallel
-	std::vector<std::thread> threads;
-	std::atomic_bool mmrHashesValidated = true;
-	threads.emplace_back(std::thread([this, pKernelMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pKernelMMR)) { mmrHashesValidated = false; }}));
-	threads.emplace_back(std::thread([this, pOutputPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pOutputPMMR)) { mmrHashesValidated = false; }}));
-	threads.emplace_back(std::thread([this, pRangeProofPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pRangeProofPMMR)) { mmrHashesValidated = false; }}));
-
-	for (auto& thread : threads)
-	{
-		if (thread.joinable())
-		{
-			thread.join();
-		}
-	}
-
-	if (!mmrHashesValidated)
-	{
-		LOG_ERROR("Invalid MMR hashes");
-		return std::unique_ptr<BlockSums>(nullptr);
-	}
-
-	syncStatus.UpdateProcessingStatus(10);
-
 	// Validate root for each MMR matches blockHeader
 	if (!txHashSet.ValidateRoots(blockHeader))
 	{
@@ -64,52 +100,76 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 		return std::unique_ptr<BlockSums>(nullptr);
 	}
 
-	syncStatus.UpdateProcessingStatus(15);
-
-	// Validate the full kernel history (kernel MMR root for every block header).
-	LOG_DEBUG("Validating kernel history");
-	if (!ValidateKernelHistory(*txHashSet.GetKernelMMR(), blockHeader, syncStatus))
-	{
-		LOG_ERROR("Invalid kernel history");
-		return std::unique_ptr<BlockSums>(nullptr);
-	}
-
-	syncStatus.UpdateProcessingStatus(25);
-
-	// Validate kernel sums
-	LOG_DEBUG("Validating kernel sums");
-	LoggerAPI::Flush();
+	syncStatus.UpdateProcessingStatus(10);
 
+	// The remaining checks are independent of each other, so they're split into index ranges and all run concurrently.
+	// Progress is tracked in thousandths of a percent, with each phase keeping its share of the total.
+	std::atomic_bool valid = true;
+	std::atomic<uint64_t> progress = 0;
 	std::unique_ptr<BlockSums> pBlockSums = nullptr;
-	try
+	std::vector<std::future<void>> tasks;
+	ThreadPool threadPool("TXHASHSET_VALIDATE", ThreadPool::GetDefaultNumThreads());
+
+	auto submitTasks = [&](const std::string& phase, const uint64_t size, const uint64_t chunkSize, const uint64_t share, std::function<bool(uint64_t, uint64_t)> validateRange)
+	{
+		const uint64_t numChunks = std::max((uint64_t)1, (size + chunkSize - 1) / chunkSize);
+		const uint64_t progressPerChunk = (share * 1000) / numChunks;
+		SubmitChunks(threadPool, tasks, valid, phase, size, chunkSize, validateRange, [&progress, &syncStatus, progressPerChunk]()
+		{
+			const uint64_t totalProgress = progress.fetch_add(progressPerChunk) + progressPerChunk;
+			syncStatus.UpdateProcessingStatus((uint8_t)(10 + (totalProgress / 1000)));
+		});
+	};
+
+	// Validate MMR hashes
+	LOG_DEBUG("Validating MMR hashes");
+	submitTasks("Output MMR hash validation", pOutputPMMR->GetSize(), MMR_HASH_CHUNK_SIZE, 2,
+		[this, pOutputPMMR](uint64_t first, uint64_t last) { return ValidateMMRHashes(pOutputPMMR, first, last); });
+	submitTasks("RangeProof MMR hash validation", pRangeProofPMMR->GetSize(), MMR_HASH_CHUNK_SIZE, 2,
+		[this, pRangeProofPMMR](uint64_t first, uint64_t last) { return ValidateMMRHashes(pRangeProofPMMR, first, last); });
+
+	if (kernelsValidated)
 	{
-		pBlockSums = std::make_unique<BlockSums>(ValidateKernelSums(txHashSet, blockHeader));
+		LOG_DEBUG("Kernel MMR already validated");
+		progress += (1 + KERNEL_HISTORY_SHARE + KERNEL_SIGNATURE_SHARE) * 1000;
 	}
-	catch (...)
+	else
 	{
-		LOG_ERROR("Invalid kernel sums");
-		return std::unique_ptr<BlockSums>(nullptr);
+		submitTasks("Kernel MMR hash validation", pKernelMMR->GetSize(), MMR_HASH_CHUNK_SIZE, 1,
+			[this, pKernelMMR](uint64_t first, uint64_t last) { return ValidateMMRHashes(pKernelMMR, first, last); });
+
+		// Validate the full kernel history (kernel MMR root for every block header).
+		LOG_DEBUG("Validating kernel history");
+		submitTasks("Kernel history validation", blockHeader.GetHeight() + 1, KERNEL_HISTORY_CHUNK_SIZE, KERNEL_HISTORY_SHARE,
+			[this, pKernelMMR](uint64_t first, uint64_t last) { return ValidateKernelHistory(*pKernelMMR, first, last); });
+
+		// Validate kernel signatures
+		LOG_DEBUG("Validating kernel signatures");
+		submitTasks("Kernel signature validation", pKernelMMR->GetSize(), KERNEL_SIGNATURE_CHUNK_SIZE, KERNEL_SIGNATURE_SHARE,
+			[this, pKernelMMR](uint64_t first, uint64_t last) { return ValidateKernelSignatures(*pKernelMMR, first, last); });
 	}
 
-	syncStatus.UpdateProcessingStatus(40);
+	// Validate kernel sums
+	LOG_DEBUG("Validating kernel sums");
+	submitTasks("Kernel sum validation", 1, 1, 15,
+		[this, &txHashSet, &blockHeader, &pBlockSums](uint64_t, uint64_t)
+		{
+			pBlockSums = std::make_unique<BlockSums>(ValidateKernelSums(txHashSet, blockHeader));
+			return true;
+		}
+	);
 
 	// Validate the rangeproof associated with each unspent output.
 	LOG_DEBUG("Validating range proofs");
-	LoggerAPI::Flush();
-	if (!ValidateRangeProofs(txHashSet, syncStatus))
-	{
-		LOG_ERROR("Failed to verify rangeproofs");
-		return std::unique_ptr<BlockSums>(nullptr);
-	}
+	submitTasks("Rangeproof validation", pOutputPMMR->GetSize(), RANGEPROOF_CHUNK_SIZE, 30,
+		[this, &txHashSet](uint64_t first, uint64_t last) { return ValidateRangeProofs(txHashSet, first, last); });
 
-	syncStatus.UpdateProcessingStatus(70);
-
-	// Validate kernel signatures
-	LOG_DEBUG("Validating kernel signatures");
 	LoggerAPI::Flush();
-	if (!ValidateKernelSignatures(*txHashSet.GetKernelMMR(), syncStatus))
+	threadPool.Wait(tasks);
+
+	if (!valid || pBlockSums == nullptr)
 	{
-		LOG_ERROR("Failed to verify kernel signatures");
+		LOG_ERROR("TxHashSet validation failed");
 		return std::unique_ptr<BlockSums>(nullptr);
 	}
 
@@ -121,6 +181,36 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	return pBlockSums;
 }
 
+bool TxHashSetValidator::ValidateKernels(std::shared_ptr<const KernelMMR> pKernelMMR, const BlockHeader& blockHeader) const
+{
+	if (pKernelMMR->GetSize() != blockHeader.GetKernelMMRSize())
+	{
+		LOG_ERROR_F("Kernel size not matching for header ({})", blockHeader);
+		return false;
+	}
+
+	if (pKernelMMR->Root(blockHeader.GetKernelMMRSize()) != blockHeader.GetKernelRoot())
+	{
+		LOG_ERROR_F("Kernel root not matching for header ({})", blockHeader);
+		return false;
+	}
+
+	std::atomic_bool valid = true;
+	std::vector<std::future<void>> tasks;
+	ThreadPool threadPool("KERNEL_VALIDATE", ThreadPool::GetDefaultNumThreads());
+
+	SubmitChunks(threadPool, tasks, valid, "Kernel MMR hash validation", pKernelMMR->GetSize(), MMR_HASH_CHUNK_SIZE,
+		[this, pKernelMMR](uint64_t first, uint64_t last) { return ValidateMMRHashes(pKernelMMR, first, last); }, []() {});
+	SubmitChunks(threadPool, tasks, valid, "Kernel history validation", blockHeader.GetHeight() + 1, KERNEL_HISTORY_CHUNK_SIZE,
+		[this, pKernelMMR](uint64_t first, uint64_t last) { return ValidateKernelHistory(*pKernelMMR, first, last); }, []() {});
+	SubmitChunks(threadPool, tasks, valid, "Kernel signature validation", pKernelMMR->GetSize(), KERNEL_SIGNATURE_CHUNK_SIZE,
+		[this, pKernelMMR](uint64_t first, uint64_t last) { return ValidateKernelSignatures(*pKernelMMR, first, last); }, []() {});
+
+	threadPool.Wait(tasks);
+
+	return valid;
+}
+
 bool TxHashSetValidator::ValidateSizes(TxHashSet& txHashSet, const BlockHeader& blockHeader) const
 {
 	if (txHashSet.GetKernelMMR()->GetSize() != blockHeader.GetKernelMMRSize())
@@ -145,12 +235,11 @@ bool TxHashSetValidator::ValidateSizes(TxHashSet& txHashSet, const BlockHeader&
 }
 
 // TODO: This probably belongs in MMRHashUtil.
-bool TxHashSetValidator::ValidateMMRHashes(std::shared_ptr<const MMR> pMMR) const
+bool TxHashSetValidator::ValidateMMRHashes(std::shared_ptr<const MMR> pMMR, const uint64_t firstIndex, const uint64_t lastIndex) const
 {
 	try
 	{
-		const uint64_t size = pMMR->GetSize();
-		for (uint64_t i = 0; i < size; i++)
+		for (uint64_t i = firstIndex; i < lastIndex; i++)
 		{
 			const uint64_t height = MMRUtil::GetHeight(i);
 			if (height > 0)
@@ -185,10 +274,9 @@ bool TxHashSetValidator::ValidateMMRHashes(std::shared_ptr<const MMR> pMMR) cons
 	return true;
 }
 
-bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const BlockHeader& blockHeader, SyncStatus& syncStatus) const
+bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const uint64_t firstHeight, const uint64_t lastHeight) const
 {
-	const uint64_t totalHeight = blockHeader.GetHeight();
-	for (uint64_t height = 0; height <= totalHeight; height++)
+	for (uint64_t height = firstHeight; height < lastHeight; height++)
 	{
 		auto pHeader = m_blockChainServer.GetBlockHeaderByHeight(height, EChainType::CANDIDATE);
 		if (pHeader == nullptr)
@@ -202,11 +290,6 @@ bool TxHashSetValidator::ValidateKernelHistory(const KernelMMR& kernelMMR, const
 			LOG_ERROR_F("Kernel root not matching for header at height ({})", height);
 			return false;
 		}
-
-		if (height % 1000 == 0)
-		{
-			syncStatus.UpdateProcessingStatus((uint8_t)(15 + ((10.0 * height) / totalHeight)));
-		}
 	}
 
 	return true;
@@ -251,14 +334,11 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 	);
 }
 
-bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& syncStatus) const
+bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, const uint64_t firstIndex, const uint64_t lastIndex) const
 {
 	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
 
-	size_t i = 0;
-	LOG_INFO("BEGIN");
-	const uint64_t outputMMRSize = txHashSet.GetOutputPMMR()->GetSize();
-	for (uint64_t mmrIndex = 0; mmrIndex < outputMMRSize; mmrIndex++)
+	for (uint64_t mmrIndex = firstIndex; mmrIndex < lastIndex; mmrIndex++)
 	{
 		std::unique_ptr<OutputIdentifier> pOutput = txHashSet.GetOutputPMMR()->GetAt(mmrIndex);
 		if (pOutput != nullptr)
@@ -271,19 +351,6 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 			}
 
 			rangeProofs.emplace_back(std::make_pair(pOutput->GetCommitment(), *pRangeProof));
-			++i;
-
-			if (rangeProofs.size() >= 1000)
-			{
-				if (!Crypto::VerifyRangeProofs(rangeProofs))
-				{
-					return false;
-				}
-
-				rangeProofs.clear();
-
-				syncStatus.UpdateProcessingStatus((uint8_t)(40 + ((30.0 * mmrIndex) / outputMMRSize)));
-			}
 		}
 	}
 
@@ -295,39 +362,25 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 		}
 	}
 
-	LOG_INFO_F("SUCCESS ({})", i);
 	return true;
 }
 
-bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, SyncStatus& syncStatus) const
+bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, const uint64_t firstIndex, const uint64_t lastIndex) const
 {
 	std::vector<TransactionKernel> kernels;
 
-	const uint64_t mmrSize = kernelMMR.GetSize();
-	for (uint64_t i = 0; i < mmrSize; i++)
+	for (uint64_t i = firstIndex; i < lastIndex; i++)
 	{
 		std::unique_ptr<TransactionKernel> pKernel = kernelMMR.GetKernelAt(i);
 		if (pKernel != nullptr)
 		{
 			kernels.push_back(*pKernel);
-
-			if (kernels.size() >= 2000)
-			{
-				if (!KernelSignatureValidator::VerifyKernelSignatures(kernels))
-				{
-					return false;
-				}
-
-				kernels.clear();
-
-				syncStatus.UpdateProcessingStatus((uint8_t)(70 + ((30.0 * i) / mmrSize)));
-			}
 		}
 	}
 
 	if (!kernels.empty())
 	{
-		if (!KernelSignatureValidator::VerifyKernelSignatures(kernels))
+		if (!KernelSignatureValidator::VerifyKernelSignatures(kernels, false))
 		{
 			return false;
 		}
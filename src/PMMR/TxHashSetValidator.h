@@ -17,16 +17,24 @@ class TxHashSetValidator
 public:
 	TxHashSetValidator(const IBlockChainServer& blockChainServer);
 
-	std::unique_ptr<BlockSums> Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const;
+	//
+	// Validates the entire TxHashSet. If kernelsValidated is true, the kernel MMR was already checked by ValidateKernels, so it's skipped.
+	//
+	std::unique_ptr<BlockSums> Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, const bool kernelsValidated, SyncStatus& syncStatus) const;
+
+	//
+	// Validates the kernel MMR on its own (size, root, hashes, history and signatures), so it can be checked before the rest of the TxHashSet is available.
+	//
+	bool ValidateKernels(std::shared_ptr<const KernelMMR> pKernelMMR, const BlockHeader& blockHeader) const;
 
 private:
 	bool ValidateSizes(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
-	bool ValidateMMRHashes(std::shared_ptr<const MMR> pMMR) const;
+	bool ValidateMMRHashes(std::shared_ptr<const MMR> pMMR, const uint64_t firstIndex, const uint64_t lastIndex) const;
 
-	bool ValidateKernelHistory(const KernelMMR& kernelMMR, const BlockHeader& blockHeader, SyncStatus& syncStatus) const;
+	bool ValidateKernelHistory(const KernelMMR& kernelMMR, const uint64_t firstHeight, const uint64_t lastHeight) const;
 	BlockSums ValidateKernelSums(TxHashSet& txHashSet, const BlockHeader& blockHeader) const;
-	bool ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& syncStatus) const;
-	bool ValidateKernelSignatures(const KernelMMR& kernelMMR, SyncStatus& syncStatus) const;
+	bool ValidateRangeProofs(TxHashSet& txHashSet, const uint64_t firstIndex, const uint64_t lastIndex) const;
+	bool ValidateKernelSignatures(const KernelMMR& kernelMMR, const uint64_t firstIndex, const uint64_t lastIndex) const;
 
 	const IBlockChainServer& m_blockChainServer;
 };
\ No newline at end of file
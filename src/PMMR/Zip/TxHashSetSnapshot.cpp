@@ -0,0 +1,197 @@
+#include "TxHashSetSnapshot.h"
+#include "../Common/MMRUtil.h"
+#include "../Common/PruneList.h"
+#include "../KernelMMR.h"
+#include "../OutputPMMR.h"
+#include "../RangeProofPMMR.h"
+
+#include <Core/BitmapFile.h>
+#include <Core/Exceptions/FileException.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Util/StringUtil.h>
+#include <Infrastructure/Logger.h>
+#include <fstream>
+
+// Files are streamed into the zip in chunks of this size, rather than read into memory whole.
+static const size_t CHUNK_SIZE = 1024 * 1024;
+
+std::unique_ptr<TxHashSetSnapshot> TxHashSetSnapshot::Capture(
+	const fs::path& txHashSetPath,
+	const IBlockDB& blockDB,
+	const BlockHeader& flushedHeader,
+	const BlockHeader& header)
+{
+	// Collect the outputs spent since the header, the same way TxHashSet::Rewind does.
+	Roaring leavesToAdd;
+	BlockHeaderPtr pCurrent = std::make_shared<const BlockHeader>(flushedHeader);
+	while (pCurrent != nullptr && pCurrent->GetHeight() > header.GetHeight())
+	{
+		std::unique_ptr<Roaring> pBlockInputBitmap = blockDB.GetBlockInputBitmap(pCurrent->GetHash());
+		if (pBlockInputBitmap == nullptr)
+		{
+			LOG_WARNING_F("Input bitmap missing for block {}", *pCurrent);
+			return nullptr;
+		}
+
+		leavesToAdd |= *pBlockInputBitmap;
+		pCurrent = blockDB.GetBlockHeader(pCurrent->GetPreviousBlockHash());
+	}
+
+	if (pCurrent == nullptr || *pCurrent != header)
+	{
+		LOG_WARNING_F("Block {} is not an ancestor of the flushed block {}", header, flushedHeader);
+		return nullptr;
+	}
+
+	const std::string directory = txHashSetPath.u8string();
+	std::vector<Entry> entries;
+
+	const uint64_t kernelSize = header.GetKernelMMRSize();
+	const uint64_t numKernels = kernelSize == 0 ? 0 : MMRUtil::GetNumLeaves(kernelSize - 1);
+	entries.push_back(CaptureFile("kernel/pmmr_hash.bin", directory + "kernel/pmmr_hash.bin", kernelSize * HASH_SIZE));
+	entries.push_back(CaptureFile("kernel/pmmr_data.bin", directory + "kernel/pmmr_data.bin", numKernels * KERNEL_SIZE));
+
+	CapturePMMR(directory + "output/", OUTPUT_SIZE, header.GetOutputMMRSize(), leavesToAdd, header, entries);
+	CapturePMMR(directory + "rangeproof/", RANGE_PROOF_SIZE, header.GetOutputMMRSize(), leavesToAdd, header, entries);
+
+	return std::unique_ptr<TxHashSetSnapshot>(new TxHashSetSnapshot(std::move(entries)));
+}
+
+void TxHashSetSnapshot::CapturePMMR(
+	const std::string& directory,
+	const size_t dataSize,
+	const uint64_t mmrSize,
+	const Roaring& leavesToAdd,
+	const BlockHeader& header,
+	std::vector<Entry>& entries)
+{
+	const std::string zipDirectory = fs::path(directory).parent_path().filename().u8string() + "/";
+
+	// The prune list isn't rewound, so it's zipped as-is, and the file prefixes are found the same way PruneableMMR::Rewind finds them.
+	const std::string prunePath = directory + "pmmr_prun.bin";
+	std::shared_ptr<PruneList> pPruneList = PruneList::Load(prunePath);
+
+	uint64_t numHashes = 0;
+	uint64_t numData = 0;
+	if (mmrSize > 0)
+	{
+		numHashes = mmrSize - pPruneList->GetShift(mmrSize - 1);
+		numData = MMRUtil::GetNumLeaves(mmrSize - 1) - pPruneList->GetLeafShift(mmrSize - 1);
+	}
+
+	entries.push_back(CaptureFile(zipDirectory + "pmmr_hash.bin", directory + "pmmr_hash.bin", numHashes * HASH_SIZE));
+	entries.push_back(CaptureFile(zipDirectory + "pmmr_data.bin", directory + "pmmr_data.bin", numData * dataSize));
+
+	Entry pruneEntry{ zipDirectory + "pmmr_prun.bin", "", 0, {} };
+	if (FileUtil::Exists(prunePath) && !FileUtil::ReadFile(prunePath, pruneEntry.bytes))
+	{
+		throw FILE_EXCEPTION_F("Failed to read {}", prunePath);
+	}
+
+	pruneEntry.numBytes = pruneEntry.bytes.size();
+	entries.emplace_back(std::move(pruneEntry));
+
+	// Rewind the leaf set in memory: restore the spent leaves, and remove every leaf added after the header.
+	Roaring leaves = BitmapFile::Load(directory + "pmmr_leafset.bin")->ToRoaring();
+	leaves |= leavesToAdd;
+
+	Roaring positionsToKeep;
+	positionsToKeep.addRange(1, mmrSize + 1);
+	leaves &= positionsToKeep;
+
+	Entry leafEntry{ zipDirectory + "pmmr_leaf.bin." + header.ShortHash(), "", 0, {} };
+	leafEntry.bytes.resize(leaves.getSizeInBytes());
+	leafEntry.numBytes = leaves.write((char*)leafEntry.bytes.data());
+	leafEntry.bytes.resize(leafEntry.numBytes);
+	entries.emplace_back(std::move(leafEntry));
+}
+
+TxHashSetSnapshot::Entry TxHashSetSnapshot::CaptureFile(const std::string& name, const std::string& sourcePath, const uint64_t numBytes)
+{
+	// Files can be longer than their contents (preallocated extents, or data added since the header), but never shorter.
+	const uint64_t fileSize = FileUtil::Exists(sourcePath) ? FileUtil::GetFileSize(sourcePath) : 0;
+	if (fileSize < numBytes)
+	{
+		throw FILE_EXCEPTION_F("{} is {} bytes, but {} are needed", sourcePath, fileSize, numBytes);
+	}
+
+	return Entry{ name, sourcePath, numBytes, {} };
+}
+
+void TxHashSetSnapshot::WriteZip(const std::string& zipFilePath) const
+{
+	zipFile zf = zipOpen64(zipFilePath.c_str(), APPEND_STATUS_CREATE);
+	if (zf == nullptr)
+	{
+		throw FILE_EXCEPTION_F("Failed to create zip file at ({})", zipFilePath);
+	}
+
+	try
+	{
+		for (const Entry& entry : m_entries)
+		{
+			WriteEntry(zf, entry);
+		}
+	}
+	catch (std::exception&)
+	{
+		zipClose(zf, NULL);
+		FileUtil::RemoveFile(zipFilePath);
+		throw;
+	}
+
+	if (zipClose(zf, NULL))
+	{
+		FileUtil::RemoveFile(zipFilePath);
+		throw FILE_EXCEPTION_F("Failed to close zip file ({})", zipFilePath);
+	}
+}
+
+void TxHashSetSnapshot::WriteEntry(zipFile zf, const Entry& entry)
+{
+	zip_fileinfo zfi = {};
+	const int zip64 = entry.numBytes >= 0xffffffff ? 1 : 0;
+	if (ZIP_OK != zipOpenNewFileInZip64(zf, entry.name.c_str(), &zfi, nullptr, 0, nullptr, 0, nullptr, 0, Z_NO_COMPRESSION, zip64))
+	{
+		throw FILE_EXCEPTION_F("Failed to add file {}", entry.name);
+	}
+
+	if (entry.sourcePath.empty())
+	{
+		if (zipWriteInFileInZip(zf, entry.bytes.empty() ? "" : (const char*)entry.bytes.data(), (unsigned int)entry.bytes.size()))
+		{
+			throw FILE_EXCEPTION_F("Failed to write to file {}", entry.name);
+		}
+	}
+	else
+	{
+		std::ifstream file(entry.sourcePath, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+		{
+			throw FILE_EXCEPTION_F("Failed to open file {}", entry.sourcePath);
+		}
+
+		std::vector<char> buffer((size_t)(std::min)((uint64_t)CHUNK_SIZE, entry.numBytes));
+		uint64_t bytesRemaining = entry.numBytes;
+		while (bytesRemaining > 0)
+		{
+			const size_t chunkSize = (size_t)(std::min)((uint64_t)buffer.size(), bytesRemaining);
+			if (!file.read(buffer.data(), chunkSize))
+			{
+				throw FILE_EXCEPTION_F("Failed to read file {}", entry.sourcePath);
+			}
+
+			if (zipWriteInFileInZip(zf, buffer.data(), (unsigned int)chunkSize))
+			{
+				throw FILE_EXCEPTION_F("Failed to write to file {}", entry.name);
+			}
+
+			bytesRemaining -= chunkSize;
+		}
+	}
+
+	if (zipCloseFileInZip(zf))
+	{
+		throw FILE_EXCEPTION_F("Failed to close file {}", entry.name);
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "minizip/zip.h"
+
+#include <Core/Models/BlockHeader.h>
+#include <Database/BlockDb.h>
+#include <Roaring.h>
+#include <filesystem.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+//
+// A TxHashSet zip as of an earlier block, written straight from the live TxHashSet files.
+//
+// The TxHashSet at an earlier block is made up of a prefix of each hash and data file. Capture records the length of each
+// of those prefixes, and rewinds the leaf sets in memory. WriteZip then streams the prefixes into the zip, so the TxHashSet
+// doesn't need to be copied or rewound on disk.
+//
+// Any block from the horizon up can still be reorged, and flushing a reorg overwrites the end of those prefixes,
+// so the TxHashSet must stay read-locked from Capture until WriteZip returns.
+//
+class TxHashSetSnapshot
+{
+public:
+	//
+	// Must be called while holding the TxHashSet's read lock, with the TxHashSet's flushed block header.
+	// The lock must be held until WriteZip returns.
+	// Returns nullptr if the header isn't the flushed header or one of its ancestors.
+	//
+	static std::unique_ptr<TxHashSetSnapshot> Capture(
+		const fs::path& txHashSetPath,
+		const IBlockDB& blockDB,
+		const BlockHeader& flushedHeader,
+		const BlockHeader& header
+	);
+
+	void WriteZip(const std::string& zipFilePath) const;
+
+private:
+	struct Entry
+	{
+		// The entry's path within the zip.
+		std::string name;
+
+		// The file whose first numBytes are written as the entry, or empty if the entry is the contents of bytes.
+		std::string sourcePath;
+		uint64_t numBytes;
+		std::vector<unsigned char> bytes;
+	};
+
+	TxHashSetSnapshot(std::vector<Entry>&& entries) : m_entries(std::move(entries)) { }
+
+	static void CapturePMMR(
+		const std::string& directory,
+		const size_t dataSize,
+		const uint64_t mmrSize,
+		const Roaring& leavesToAdd,
+		const BlockHeader& header,
+		std::vector<Entry>& entries
+	);
+	static Entry CaptureFile(const std::string& name, const std::string& sourcePath, const uint64_t numBytes);
+	static void WriteEntry(zipFile zf, const Entry& entry);
+
+	std::vector<Entry> m_entries;
+};
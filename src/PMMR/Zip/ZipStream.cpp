@@ -0,0 +1,386 @@
+#include "ZipStream.h"
+
+#include <Core/Exceptions/FileException.h>
+#include <Common/Util/FileUtil.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+
+static const uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+static const uint32_t DESCRIPTOR_SIGNATURE = 0x08074b50;
+static const uint32_t CENTRAL_DIRECTORY_SIGNATURE = 0x02014b50;
+static const uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+static const size_t LOCAL_HEADER_SIZE = 30;
+static const uint16_t ZIP64_EXTRA_FIELD = 0x0001;
+static const uint32_t ZIP64_MARKER = 0xffffffff;
+
+static const uint16_t FLAG_ENCRYPTED = 0x0001;
+static const uint16_t FLAG_DESCRIPTOR = 0x0008;
+static const uint16_t METHOD_STORED = 0;
+static const uint16_t METHOD_DEFLATED = 8;
+
+static const size_t INFLATE_BUFFER_SIZE = 256 * 1024;
+
+ZipStream::ZipStream(
+	std::function<fs::path(const std::string&)> getDestination,
+	std::function<void(const std::string&)> onEntryExtracted)
+	: m_getDestination(getDestination),
+	m_onEntryExtracted(onEntryExtracted),
+	m_state(EState::HEADER),
+	m_entry{},
+	m_inflated(INFLATE_BUFFER_SIZE)
+{
+	m_inflate = {};
+	if (inflateInit2(&m_inflate, -MAX_WBITS) != Z_OK)
+	{
+		throw FILE_EXCEPTION("Failed to initialize inflate");
+	}
+}
+
+ZipStream::~ZipStream()
+{
+	inflateEnd(&m_inflate);
+}
+
+void ZipStream::Write(const unsigned char* pData, size_t numBytes)
+{
+	while (numBytes > 0 && m_state != EState::FINISHED)
+	{
+		switch (m_state)
+		{
+			case EState::HEADER:
+				ReadHeader(pData, numBytes);
+				break;
+			case EState::DATA:
+				ReadData(pData, numBytes);
+				break;
+			case EState::DESCRIPTOR:
+				ReadDescriptor(pData, numBytes);
+				break;
+			case EState::FINISHED:
+				break;
+		}
+	}
+}
+
+//
+// Moves bytes from pData into m_pending until it holds required bytes. Returns false if pData ran out first.
+//
+bool ZipStream::Buffer(const unsigned char*& pData, size_t& numBytes, const size_t required)
+{
+	if (m_pending.size() < required)
+	{
+		const size_t numToCopy = (std::min)(required - m_pending.size(), numBytes);
+		m_pending.insert(m_pending.end(), pData, pData + numToCopy);
+		pData += numToCopy;
+		numBytes -= numToCopy;
+	}
+
+	return m_pending.size() >= required;
+}
+
+void ZipStream::ReadHeader(const unsigned char*& pData, size_t& numBytes)
+{
+	if (!Buffer(pData, numBytes, 4))
+	{
+		return;
+	}
+
+	const uint32_t signature = ReadU32(0);
+	if (signature == CENTRAL_DIRECTORY_SIGNATURE || signature == END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+	{
+		// The entries are all extracted, and the central directory only repeats what the local headers said.
+		m_pending.clear();
+		m_state = EState::FINISHED;
+		return;
+	}
+
+	if (signature != LOCAL_HEADER_SIGNATURE)
+	{
+		throw FILE_EXCEPTION_F("Invalid zip header signature {}", signature);
+	}
+
+	if (!Buffer(pData, numBytes, LOCAL_HEADER_SIZE))
+	{
+		return;
+	}
+
+	const uint16_t nameLength = ReadU16(26);
+	const uint16_t extraLength = ReadU16(28);
+	if (!Buffer(pData, numBytes, LOCAL_HEADER_SIZE + nameLength + extraLength))
+	{
+		return;
+	}
+
+	BeginEntry();
+}
+
+//
+// False if the name is absolute or has a ".." component, so it could be extracted outside of the destination folder.
+//
+bool ZipStream::IsSafeName(const std::string& name)
+{
+	if (name.empty() || name.front() == '/' || name.front() == '\\' || name.find(':') != std::string::npos)
+	{
+		return false;
+	}
+
+	size_t start = 0;
+	while (start <= name.size())
+	{
+		const size_t end = (std::min)(name.find_first_of("/\\", start), name.size());
+		if (name.compare(start, end - start, "..") == 0)
+		{
+			return false;
+		}
+
+		start = end + 1;
+	}
+
+	return true;
+}
+
+void ZipStream::BeginEntry()
+{
+	const uint16_t flags = ReadU16(6);
+	const uint16_t nameLength = ReadU16(26);
+	const uint16_t extraLength = ReadU16(28);
+
+	m_entry = Entry{};
+	m_entry.name = std::string((const char*)m_pending.data() + LOCAL_HEADER_SIZE, nameLength);
+	m_entry.method = ReadU16(8);
+	m_entry.hasDescriptor = (flags & FLAG_DESCRIPTOR) != 0;
+	m_entry.expectedCRC = ReadU32(14);
+	m_entry.compressedSize = ReadU32(18);
+	m_entry.uncompressedSize = ReadU32(22);
+	m_entry.crc = (uint32_t)crc32(0, Z_NULL, 0);
+
+	// The zip64 extra field holds the sizes that didn't fit, uncompressed first.
+	size_t extraOffset = LOCAL_HEADER_SIZE + nameLength;
+	const size_t extraEnd = extraOffset + extraLength;
+	while (extraOffset + 4 <= extraEnd)
+	{
+		const uint16_t fieldId = ReadU16(extraOffset);
+		const uint16_t fieldLength = ReadU16(extraOffset + 2);
+		if (fieldId == ZIP64_EXTRA_FIELD)
+		{
+			m_entry.zip64 = true;
+
+			size_t fieldOffset = extraOffset + 4;
+			const size_t fieldEnd = (std::min)(fieldOffset + fieldLength, extraEnd);
+			if (m_entry.uncompressedSize == ZIP64_MARKER && fieldOffset + 8 <= fieldEnd)
+			{
+				m_entry.uncompressedSize = ReadU64(fieldOffset);
+				fieldOffset += 8;
+			}
+
+			if (m_entry.compressedSize == ZIP64_MARKER && fieldOffset + 8 <= fieldEnd)
+			{
+				m_entry.compressedSize = ReadU64(fieldOffset);
+			}
+		}
+
+		extraOffset += 4 + fieldLength;
+	}
+
+	m_pending.clear();
+
+	if ((flags & FLAG_ENCRYPTED) != 0)
+	{
+		throw FILE_EXCEPTION_F("Zip entry {} is encrypted", m_entry.name);
+	}
+
+	if (m_entry.method != METHOD_STORED && m_entry.method != METHOD_DEFLATED)
+	{
+		throw FILE_EXCEPTION_F("Zip entry {} uses unsupported compression method {}", m_entry.name, m_entry.method);
+	}
+
+	if (m_entry.method == METHOD_STORED && m_entry.hasDescriptor)
+	{
+		throw FILE_EXCEPTION_F("Zip entry {} is stored without its size", m_entry.name);
+	}
+
+	if (!IsSafeName(m_entry.name))
+	{
+		throw FILE_EXCEPTION_F("Zip entry {} is outside of the zip's folder", m_entry.name);
+	}
+
+	// A repeated entry would overwrite files that were already extracted, and possibly already validated.
+	if (!m_names.insert(m_entry.name).second)
+	{
+		throw FILE_EXCEPTION_F("Zip contains {} more than once", m_entry.name);
+	}
+
+	const fs::path destination = m_getDestination(m_entry.name);
+	if (!destination.empty())
+	{
+		FileUtil::CreateDirectories(destination.parent_path());
+		m_file.open(destination, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!m_file.is_open())
+		{
+			throw FILE_EXCEPTION_F("Failed to open {}", destination.u8string());
+		}
+	}
+	else
+	{
+		LOG_DEBUG_F("Skipping zip entry {}", m_entry.name);
+	}
+
+	if (m_entry.method == METHOD_DEFLATED)
+	{
+		inflateReset(&m_inflate);
+	}
+
+	m_state = EState::DATA;
+
+	if (m_entry.method == METHOD_STORED && m_entry.compressedSize == 0)
+	{
+		EndData();
+	}
+}
+
+void ZipStream::ReadData(const unsigned char*& pData, size_t& numBytes)
+{
+	if (m_entry.method == METHOD_STORED)
+	{
+		const size_t numToCopy = (size_t)(std::min)((uint64_t)numBytes, m_entry.compressedSize - m_entry.bytesRead);
+		Output(pData, numToCopy);
+		pData += numToCopy;
+		numBytes -= numToCopy;
+		m_entry.bytesRead += numToCopy;
+
+		if (m_entry.bytesRead == m_entry.compressedSize)
+		{
+			EndData();
+		}
+
+		return;
+	}
+
+	m_inflate.next_in = (Bytef*)pData;
+	m_inflate.avail_in = (uInt)(std::min)(numBytes, (size_t)UINT32_MAX);
+
+	int result = Z_OK;
+	do
+	{
+		m_inflate.next_out = m_inflated.data();
+		m_inflate.avail_out = (uInt)m_inflated.size();
+
+		result = inflate(&m_inflate, Z_NO_FLUSH);
+		if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+		{
+			throw FILE_EXCEPTION_F("Failed to inflate zip entry {}: {}", m_entry.name, result);
+		}
+
+		Output(m_inflated.data(), m_inflated.size() - m_inflate.avail_out);
+	} while (result != Z_STREAM_END && m_inflate.avail_out == 0);
+
+	const size_t consumed = (size_t)((const unsigned char*)m_inflate.next_in - pData);
+	pData += consumed;
+	numBytes -= consumed;
+	m_entry.bytesRead += consumed;
+
+	if (result == Z_STREAM_END)
+	{
+		EndData();
+	}
+}
+
+void ZipStream::ReadDescriptor(const unsigned char*& pData, size_t& numBytes)
+{
+	// The descriptor's signature is optional, so it's only known to be there once the first 4 bytes arrive.
+	if (!Buffer(pData, numBytes, 4))
+	{
+		return;
+	}
+
+	const size_t signatureLength = ReadU32(0) == DESCRIPTOR_SIGNATURE ? 4 : 0;
+	const size_t sizeLength = m_entry.zip64 ? 8 : 4;
+	if (!Buffer(pData, numBytes, signatureLength + 4 + (2 * sizeLength)))
+	{
+		return;
+	}
+
+	m_entry.expectedCRC = ReadU32(signatureLength);
+	m_entry.compressedSize = m_entry.zip64 ? ReadU64(signatureLength + 4) : ReadU32(signatureLength + 4);
+	m_entry.uncompressedSize = m_entry.zip64 ? ReadU64(signatureLength + 4 + sizeLength) : ReadU32(signatureLength + 4 + sizeLength);
+	m_pending.clear();
+
+	FinishEntry();
+}
+
+void ZipStream::Output(const unsigned char* pData, const size_t numBytes)
+{
+	if (numBytes == 0)
+	{
+		return;
+	}
+
+	m_entry.crc = (uint32_t)crc32(m_entry.crc, pData, (uInt)numBytes);
+	m_entry.bytesWritten += numBytes;
+
+	if (m_file.is_open())
+	{
+		m_file.write((const char*)pData, numBytes);
+		if (m_file.fail())
+		{
+			throw FILE_EXCEPTION_F("Failed to write zip entry {}", m_entry.name);
+		}
+	}
+}
+
+void ZipStream::EndData()
+{
+	if (m_entry.hasDescriptor)
+	{
+		m_state = EState::DESCRIPTOR;
+	}
+	else
+	{
+		FinishEntry();
+	}
+}
+
+void ZipStream::FinishEntry()
+{
+	if (m_entry.bytesRead != m_entry.compressedSize || m_entry.bytesWritten != m_entry.uncompressedSize)
+	{
+		throw FILE_EXCEPTION_F("Zip entry {} is {} bytes, but should be {}", m_entry.name, m_entry.bytesWritten, m_entry.uncompressedSize);
+	}
+
+	if (m_entry.crc != m_entry.expectedCRC)
+	{
+		throw FILE_EXCEPTION_F("CRC mismatch for zip entry {}", m_entry.name);
+	}
+
+	const bool extracted = m_file.is_open();
+	if (extracted)
+	{
+		m_file.close();
+		if (m_file.fail())
+		{
+			throw FILE_EXCEPTION_F("Failed to close zip entry {}", m_entry.name);
+		}
+	}
+
+	m_state = EState::HEADER;
+
+	if (extracted)
+	{
+		m_onEntryExtracted(m_entry.name);
+	}
+}
+
+uint16_t ZipStream::ReadU16(const size_t offset) const
+{
+	return (uint16_t)(m_pending[offset] | (m_pending[offset + 1] << 8));
+}
+
+uint32_t ZipStream::ReadU32(const size_t offset) const
+{
+	return (uint32_t)ReadU16(offset) | ((uint32_t)ReadU16(offset + 2) << 16);
+}
+
+uint64_t ZipStream::ReadU64(const size_t offset) const
+{
+	return (uint64_t)ReadU32(offset) | ((uint64_t)ReadU32(offset + 4) << 32);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <zlib.h>
+#include <filesystem.h>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+//
+// Extracts a zip as its bytes arrive, rather than after the whole zip has been written to disk.
+//
+// Entries are read from their local file headers in the order they're stored, so the central directory is never needed.
+// Stored and deflated entries are supported, but stored entries must have their sizes in the local header
+// (there's no way to find the end of a stored entry with a trailing data descriptor without the central directory).
+// Entries with absolute paths or ".." components, and entries that appear more than once, are rejected.
+//
+class ZipStream
+{
+public:
+	//
+	// getDestination returns the path an entry should be extracted to, or an empty path to skip the entry.
+	// onEntryExtracted is called with the entry's name once it's been fully written and its CRC checked.
+	//
+	ZipStream(
+		std::function<fs::path(const std::string&)> getDestination,
+		std::function<void(const std::string&)> onEntryExtracted
+	);
+	~ZipStream();
+
+	ZipStream(const ZipStream&) = delete;
+	ZipStream& operator=(const ZipStream&) = delete;
+
+	//
+	// Extracts the next numBytes of the zip. Throws a FileException if the zip is malformed or can't be written.
+	//
+	void Write(const unsigned char* pData, size_t numBytes);
+
+	//
+	// True once every entry has been extracted, and the central directory has been reached.
+	//
+	bool IsFinished() const { return m_state == EState::FINISHED; }
+
+private:
+	enum class EState
+	{
+		HEADER,
+		DATA,
+		DESCRIPTOR,
+		FINISHED
+	};
+
+	struct Entry
+	{
+		std::string name;
+		uint16_t method;
+		bool hasDescriptor;
+		bool zip64;
+		uint32_t expectedCRC;
+		uint64_t compressedSize;
+		uint64_t uncompressedSize;
+
+		uint32_t crc;
+		uint64_t bytesRead;
+		uint64_t bytesWritten;
+	};
+
+	bool Buffer(const unsigned char*& pData, size_t& numBytes, const size_t required);
+	void ReadHeader(const unsigned char*& pData, size_t& numBytes);
+	void ReadData(const unsigned char*& pData, size_t& numBytes);
+	void ReadDescriptor(const unsigned char*& pData, size_t& numBytes);
+
+	static bool IsSafeName(const std::string& name);
+
+	void BeginEntry();
+	void Output(const unsigned char* pData, const size_t numBytes);
+	void EndData();
+	void FinishEntry();
+
+	uint16_t ReadU16(const size_t offset) const;
+	uint32_t ReadU32(const size_t offset) const;
+	uint64_t ReadU64(const size_t offset) const;
+
+	std::function<fs::path(const std::string&)> m_getDestination;
+	std::function<void(const std::string&)> m_onEntryExtracted;
+
+	EState m_state;
+	std::vector<unsigned char> m_pending;
+	Entry m_entry;
+	std::set<std::string> m_names;
+	std::ofstream m_file;
+
+	z_stream m_inflate;
+	std::vector<unsigned char> m_inflated;
+};
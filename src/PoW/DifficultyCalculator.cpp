@@ -1,5 +1,5 @@
 #include "DifficultyCalculator.h"
-#include "DifficultyLoader.h"
+#include "DifficultyWindow.h"
 
 #include <Consensus/BlockDifficulty.h>
 
@@ -24,13 +24,13 @@ DifficultyCalculator::DifficultyCalculator(std::shared_ptr<const IBlockDB> pBloc
 //
 // The secondary proof-of-work factor is calculated along the same lines, as
 // an adjustment on the deviation against the ideal value.
-HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const BlockHeader& header) const
+HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	// Create vector of difficulty data running from earliest
 	// to latest, and pad with simulated pre-genesis data to allow earlier
 	// adjustment if there isn't enough window data length will be
 	// DIFFICULTY_ADJUST_WINDOW + 1 (for initial block time bound)
-	const std::vector<HeaderInfo> difficultyData = DifficultyLoader(m_pBlockDB).LoadDifficultyData(header);
+	const std::vector<HeaderInfo> difficultyData = DifficultyWindow::GetInstance().GetDifficultyData(*m_pBlockDB, previousHeader);
 
 	// First, get the ratio of secondary PoW vs primary, skipping initial header
 	const std::vector<HeaderInfo> difficultyDataSkipFirst(difficultyData.cbegin() + 1, difficultyData.cend());
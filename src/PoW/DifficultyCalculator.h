@@ -10,7 +10,7 @@ class DifficultyCalculator
 public:
 	DifficultyCalculator(std::shared_ptr<const IBlockDB> pBlockDB);
 
-	HeaderInfo CalculateNextDifficulty(const BlockHeader& blockHeader) const;
+	HeaderInfo CalculateNextDifficulty(const BlockHeader& blockHeader, const BlockHeader& previousHeader) const;
 
 private:
 	uint64_t ARCount(const std::vector<HeaderInfo>& difficultyData) const;
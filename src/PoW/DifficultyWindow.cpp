@@ -0,0 +1,145 @@
+#include "DifficultyWindow.h"
+
+#include <Consensus/BlockDifficulty.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+
+static const size_t NUM_BLOCKS_NEEDED = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
+
+// Headers kept beyond the ones needed, so a reorg up to this deep can be rewound without going back to the DB.
+static const size_t MAX_REWIND_DEPTH = Consensus::DIFFICULTY_ADJUST_WINDOW;
+
+DifficultyWindow& DifficultyWindow::GetInstance()
+{
+	static DifficultyWindow instance;
+	return instance;
+}
+
+std::vector<HeaderInfo> DifficultyWindow::GetDifficultyData(const IBlockDB& blockDB, const BlockHeader& previousHeader)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	const bool isTip = !m_entries.empty() && m_entries.back().hash == previousHeader.GetHash();
+	if (!isTip && !Extend(previousHeader) && !Rewind(previousHeader))
+	{
+		LOG_DEBUG_F("Rebuilding difficulty window at {}", previousHeader);
+		Rebuild(blockDB, previousHeader);
+	}
+
+	// Latest first, since that's the order the padding is added in.
+	std::vector<HeaderInfo> difficultyData;
+	difficultyData.reserve(NUM_BLOCKS_NEEDED);
+	for (auto iter = m_entries.crbegin(); iter != m_entries.crend() && difficultyData.size() < NUM_BLOCKS_NEEDED; iter++)
+	{
+		difficultyData.push_back(iter->headerInfo);
+	}
+
+	return PadDifficultyData(difficultyData);
+}
+
+// Pushes previousHeader onto the window, if it builds on the window's tip.
+bool DifficultyWindow::Extend(const BlockHeader& previousHeader)
+{
+	if (m_entries.empty() || m_entries.back().hash != previousHeader.GetPreviousBlockHash())
+	{
+		return false;
+	}
+
+	const uint64_t difficulty = previousHeader.GetTotalDifficulty() - m_entries.back().totalDifficulty;
+	m_entries.push_back(Entry{
+		previousHeader.GetHash(),
+		previousHeader.GetHeight(),
+		previousHeader.GetTotalDifficulty(),
+		HeaderInfo(previousHeader.GetTimestamp(), difficulty, previousHeader.GetScalingDifficulty(), previousHeader.GetProofOfWork().IsSecondary())
+	});
+
+	while (m_entries.size() > NUM_BLOCKS_NEEDED + MAX_REWIND_DEPTH)
+	{
+		m_entries.pop_front();
+	}
+
+	return IsComplete();
+}
+
+// Drops every entry after previousHeader, if previousHeader is in the window and enough of its ancestors are left.
+bool DifficultyWindow::Rewind(const BlockHeader& previousHeader)
+{
+	auto iter = std::find_if(
+		m_entries.begin(),
+		m_entries.end(),
+		[&previousHeader](const Entry& entry) { return entry.hash == previousHeader.GetHash(); }
+	);
+	if (iter == m_entries.end())
+	{
+		return false;
+	}
+
+	m_entries.erase(iter + 1, m_entries.end());
+
+	return IsComplete();
+}
+
+void DifficultyWindow::Rebuild(const IBlockDB& blockDB, const BlockHeader& previousHeader)
+{
+	m_entries.clear();
+
+	BlockHeaderPtr pHeader = std::make_shared<const BlockHeader>(previousHeader);
+	while (m_entries.size() < NUM_BLOCKS_NEEDED && pHeader != nullptr)
+	{
+		BlockHeaderPtr pPrevious = blockDB.GetBlockHeader(pHeader->GetPreviousBlockHash());
+
+		uint64_t difficulty = pHeader->GetTotalDifficulty();
+		if (pPrevious != nullptr)
+		{
+			difficulty -= pPrevious->GetTotalDifficulty();
+		}
+
+		m_entries.push_front(Entry{
+			pHeader->GetHash(),
+			pHeader->GetHeight(),
+			pHeader->GetTotalDifficulty(),
+			HeaderInfo(pHeader->GetTimestamp(), difficulty, pHeader->GetScalingDifficulty(), pHeader->GetProofOfWork().IsSecondary())
+		});
+
+		pHeader = pPrevious;
+	}
+}
+
+// The window is complete when it has all the headers needed, or when it runs all the way back to genesis.
+bool DifficultyWindow::IsComplete() const
+{
+	return m_entries.size() >= NUM_BLOCKS_NEEDED || (!m_entries.empty() && m_entries.front().height == 0);
+}
+
+// Converts an iterator of block difficulty data to more a more manageable
+// vector and pads if needed (which will) only be needed for the first few
+// blocks after genesis
+std::vector<HeaderInfo> DifficultyWindow::PadDifficultyData(std::vector<HeaderInfo>& difficultyData)
+{
+	// Only needed just after blockchain launch... basically ensures there's
+	// always enough data by simulating perfectly timed pre-genesis
+	// blocks at the genesis difficulty as needed.
+	const size_t size = difficultyData.size();
+	if (NUM_BLOCKS_NEEDED > size)
+	{
+		uint64_t last_ts_delta = Consensus::BLOCK_TIME_SEC;
+		if (size > 1)
+		{
+			last_ts_delta = difficultyData[0].GetTimestamp() - difficultyData[1].GetTimestamp();
+		}
+
+		const uint64_t last_diff = difficultyData[0].GetDifficulty();
+
+		// fill in simulated blocks with values from the previous real block
+		uint64_t last_ts = difficultyData.back().GetTimestamp();
+		while (difficultyData.size() < NUM_BLOCKS_NEEDED)
+		{
+			last_ts -= (std::min)(last_ts, last_ts_delta);
+			difficultyData.emplace_back(HeaderInfo::FromTimeAndDiff(last_ts, last_diff));
+		}
+	}
+
+	std::reverse(difficultyData.begin(), difficultyData.end());
+
+	return difficultyData;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "HeaderInfo.h"
+
+#include <Core/Models/BlockHeader.h>
+#include <Crypto/Hash.h>
+#include <Database/BlockDb.h>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+//
+// The difficulty data of the last DIFFICULTY_ADJUST_WINDOW + 1 headers of the chain being extended.
+//
+// Headers are almost always validated on top of the header validated just before them, so rather than reloading
+// the whole window from the DB for every header, the previous header is pushed onto the window and the oldest is dropped.
+// Up to DIFFICULTY_ADJUST_WINDOW older headers are kept too, so when a header extends some other header (a reorg, or a fork),
+// the window can be rewound to that header if it's still in the window while leaving enough headers behind it.
+// The window is only rebuilt from the DB when it can't be.
+//
+class DifficultyWindow
+{
+public:
+	static DifficultyWindow& GetInstance();
+
+	//
+	// Returns the difficulty data for the header that comes after previousHeader, running from earliest to latest,
+	// and padded with simulated pre-genesis data when there aren't enough headers (the same as grin's difficulty_data_to_vector).
+	//
+	std::vector<HeaderInfo> GetDifficultyData(const IBlockDB& blockDB, const BlockHeader& previousHeader);
+
+private:
+	DifficultyWindow() = default;
+
+	struct Entry
+	{
+		Hash hash;
+		uint64_t height;
+		uint64_t totalDifficulty;
+		HeaderInfo headerInfo;
+	};
+
+	bool Extend(const BlockHeader& previousHeader);
+	bool Rewind(const BlockHeader& previousHeader);
+	void Rebuild(const IBlockDB& blockDB, const BlockHeader& previousHeader);
+	bool IsComplete() const;
+
+	static std::vector<HeaderInfo> PadDifficultyData(std::vector<HeaderInfo>& difficultyData);
+
+	std::mutex m_mutex;
+
+	// Runs from earliest to latest.
+	std::deque<Entry> m_entries;
+};
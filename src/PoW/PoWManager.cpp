@@ -11,4 +11,14 @@ PoWManager::PoWManager(const Config& config, std::shared_ptr<const IBlockDB> pBl
 bool PoWManager::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	return PoWValidator(m_config, m_pBlockDB).IsPoWValid(header, previousHeader);
+}
+
+bool PoWManager::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	return PoWValidator(m_config, m_pBlockDB).IsDifficultyValid(header, previousHeader);
+}
+
+bool PoWManager::IsCycleValid(const BlockHeader& header) const
+{
+	return PoWValidator(m_config, m_pBlockDB).IsCycleValid(header);
 }
\ No newline at end of file
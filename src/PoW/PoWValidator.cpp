@@ -17,6 +17,11 @@ PoWValidator::PoWValidator(const Config& config, std::shared_ptr<const IBlockDB>
 }
 
 bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	return IsDifficultyValid(header, previousHeader) && IsCycleValid(header);
+}
+
+bool PoWValidator::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	// Validate Total Difficulty
 	if (header.GetTotalDifficulty() <= previousHeader.GetTotalDifficulty())
@@ -31,7 +36,7 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 	}
 
 	// Explicit check to ensure total_difficulty has increased by exactly the _network_ difficulty of the previous block.
-	const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_pBlockDB).CalculateNextDifficulty(header);
+	const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_pBlockDB).CalculateNextDifficulty(header, previousHeader);
 	if (targetDifficulty != nextHeaderInfo.GetDifficulty())
 	{
 		return false;
@@ -43,6 +48,11 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 		return false;
 	}
 
+	return true;
+}
+
+bool PoWValidator::IsCycleValid(const BlockHeader& header) const
+{
 	const ProofOfWork& proofOfWork = header.GetProofOfWork();
 	const EPoWType powType = PoWUtil(m_config).DeterminePoWType(header.GetVersion(), proofOfWork.GetEdgeBits());
 	if (powType == EPoWType::CUCKAROO)
@@ -86,7 +96,8 @@ uint64_t PoWValidator::GetMaximumDifficulty(const BlockHeader& header) const
 
 	std::vector<unsigned char> temp;
 	temp.resize(sizeof(uint64_t));
-	std::reverse_copy(proofOfWork.GetHash().GetData().cbegin(), proofOfWork.GetHash().GetData().cbegin() + sizeof(uint64_t), temp.begin());
+	const Hash& powHash = proofOfWork.GetHash();
+	std::reverse_copy(powHash.begin(), powHash.begin() + sizeof(uint64_t), temp.begin());
 
 	uint64_t hash64;
 	memcpy(&hash64, &temp[0], sizeof(uint64_t));
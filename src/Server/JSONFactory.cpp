@@ -164,6 +164,27 @@ Json::Value JSONFactory::BuildTransactionKernelJSON(const TransactionKernel& ker
 	return kernelNode;
 }
 
+Json::Value JSONFactory::BuildOutputJSON(const OutputDTO& output, const bool spent)
+{
+	Json::Value outputNode;
+
+	const EOutputFeatures features = output.GetIdentifier().GetFeatures();
+	outputNode["output_type"] = features == DEFAULT_OUTPUT ? "Transaction" : "Coinbase";
+	outputNode["commit"] = output.GetIdentifier().GetCommitment().ToHex();
+	outputNode["spent"] = spent;
+	outputNode["proof"] = output.GetRangeProof().Format();
+
+	Serializer proofSerializer;
+	output.GetRangeProof().Serialize(proofSerializer);
+	outputNode["proof_hash"] = Crypto::Blake2b(proofSerializer.GetBytes()).ToHex();
+
+	outputNode["block_height"] = output.GetLocation().GetBlockHeight();
+	outputNode["merkle_proof"] = Json::nullValue;
+	outputNode["mmr_index"] = output.GetLocation().GetMMRIndex() + 1;
+
+	return outputNode;
+}
+
 Json::Value JSONFactory::BuildPeerJSON(const Peer& peer)
 {
 	Json::Value peerNode;
@@ -198,6 +219,34 @@ Json::Value JSONFactory::BuildConnectedPeerJSON(const ConnectedPeer& connectedPe
 	peerNode["direction"] = connectedPeer.GetDirection() == EDirection::OUTBOUND ? "Outbound" : "Inbound";
 	peerNode["total_difficulty"] = connectedPeer.GetTotalDifficulty();
 	peerNode["height"] = connectedPeer.GetHeight();
+	peerNode["send_queue_depth"] = Json::UInt64(connectedPeer.GetSendQueueDepth());
+	peerNode["bytes_in_flight"] = Json::UInt64(connectedPeer.GetBytesInFlight());
 
 	return peerNode;
+}
+
+Json::Value JSONFactory::BuildBlockDownloadStatsJSON(const BlockDownloadStats& stats)
+{
+	Json::Value statsNode;
+	statsNode["num_in_flight"] = Json::UInt64(stats.numInFlight);
+	statsNode["lowest_requested"] = Json::UInt64(stats.lowestRequested);
+	statsNode["highest_requested"] = Json::UInt64(stats.highestRequested);
+
+	Json::Value peersNode(Json::arrayValue);
+	for (const BlockDownloadPeerStats& peer : stats.peers)
+	{
+		Json::Value peerNode;
+		peerNode["addr"] = peer.address.Format();
+		peerNode["in_flight"] = Json::UInt64(peer.numInFlight);
+		peerNode["window"] = Json::UInt64(peer.window);
+		peerNode["latency_ms"] = Json::UInt64(peer.latencyMs);
+		peerNode["blocks_per_second"] = peer.blocksPerSecond;
+		peerNode["blocks_received"] = Json::UInt64(peer.blocksReceived);
+		peerNode["requests_timed_out"] = Json::UInt64(peer.requestsTimedOut);
+		peerNode["requests_reassigned"] = Json::UInt64(peer.requestsReassigned);
+		peersNode.append(peerNode);
+	}
+	statsNode["peers"] = peersNode;
+
+	return statsNode;
 }
\ No newline at end of file
@@ -5,8 +5,10 @@
 #include <Core/Models/CompactBlock.h>
 #include <Core/Models/FullBlock.h>
 #include <Core/Models/Transaction.h>
+#include <Core/Models/DTOs/OutputDTO.h>
 #include <P2P/Peer.h>
 #include <P2P/ConnectedPeer.h>
+#include <P2P/BlockDownloadStats.h>
 
 class JSONFactory
 {
@@ -18,7 +20,9 @@ public:
 	static Json::Value BuildTransactionInputJSON(const TransactionInput& input);
 	static Json::Value BuildTransactionOutputJSON(const TransactionOutput& output, const uint64_t blockHeight);
 	static Json::Value BuildTransactionKernelJSON(const TransactionKernel& kernel);
+	static Json::Value BuildOutputJSON(const OutputDTO& output, const bool spent);
 
 	static Json::Value BuildPeerJSON(const Peer& peer);
 	static Json::Value BuildConnectedPeerJSON(const ConnectedPeer& connectedPeer);
+	static Json::Value BuildBlockDownloadStatsJSON(const BlockDownloadStats& stats);
 };
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include <Net/Util/HTTPUtil.h>
 #include <Common/Util/StringUtil.h>
+#include <Common/Util/HexUtil.h>
+#include <Core/Util/JsonUtil.h>
 #include <Infrastructure/Logger.h>
 
 //
@@ -21,6 +23,20 @@ int BlockAPI::GetBlock_Handler(struct mg_connection* conn, void* pNodeContext)
 	const std::string requestedBlock = HTTPUtil::GetURIParam(conn, "/v1/blocks/");
 	const std::string queryString = HTTPUtil::GetQueryString(conn);
 
+	// A block requested by hash never changes, so its response can be cached.
+	auto pResponseCache = ((NodeContext*)pNodeContext)->m_pResponseCache;
+	const bool cacheable = requestedBlock.length() == 64 && HexUtil::IsValidHex(requestedBlock);
+	const ResponseCacheKey cacheKey{
+		cacheable ? Hash::FromHex(requestedBlock) : ZERO_HASH,
+		queryString == "compact" ? EResponseType::COMPACT_BLOCK : EResponseType::BLOCK
+	};
+
+	std::string response;
+	if (cacheable && pResponseCache->Get(cacheKey, response))
+	{
+		return HTTPUtil::BuildSuccessResponse(conn, response);
+	}
+
 	IBlockChainServerPtr pBlockChainServer = ((NodeContext*)pNodeContext)->m_pBlockChainServer;
 	if (queryString == "compact")
 	{
@@ -31,8 +47,7 @@ int BlockAPI::GetBlock_Handler(struct mg_connection* conn, void* pNodeContext)
 			std::unique_ptr<CompactBlock> pCompactBlock = pBlockChainServer->GetCompactBlockByHash(pBlock->GetHash());
 			if (pCompactBlock != nullptr)
 			{
-				const Json::Value compactBlockJSON = JSONFactory::BuildCompactBlockJSON(*pCompactBlock);
-				return HTTPUtil::BuildSuccessResponse(conn, compactBlockJSON.toStyledString());
+				response = JsonUtil::WriteCondensed(JSONFactory::BuildCompactBlockJSON(*pCompactBlock));
 			}
 		}
 	}
@@ -42,13 +57,21 @@ int BlockAPI::GetBlock_Handler(struct mg_connection* conn, void* pNodeContext)
 
 		if (nullptr != pFullBlock)
 		{
-			const Json::Value blockJSON = JSONFactory::BuildBlockJSON(*pFullBlock);
-			return HTTPUtil::BuildSuccessResponse(conn, blockJSON.toStyledString());
+			response = JsonUtil::WriteCondensed(JSONFactory::BuildBlockJSON(*pFullBlock));
+		}
+	}
+
+	if (!response.empty())
+	{
+		if (cacheable)
+		{
+			pResponseCache->Put(cacheKey, response);
 		}
+
+		return HTTPUtil::BuildSuccessResponse(conn, response);
 	}
 
-	const std::string response = "BLOCK NOT FOUND";
-	return HTTPUtil::BuildBadRequestResponse(conn, response);
+	return HTTPUtil::BuildBadRequestResponse(conn, "BLOCK NOT FOUND");
 }
 
 std::unique_ptr<FullBlock> BlockAPI::GetBlock(const std::string& requestedBlock, IBlockChainServerPtr pBlockChainServer)
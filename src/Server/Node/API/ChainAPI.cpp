@@ -1,7 +1,9 @@
 #include "ChainAPI.h"
+#include "../../JSONFactory.h"
 #include "../NodeContext.h"
 
 #include <Net/Util/HTTPUtil.h>
+#include <Net/Util/JsonStreamWriter.h>
 #include <Common/Util/StringUtil.h>
 #include <Crypto/Crypto.h>
 #include <json/json.h>
@@ -20,7 +22,7 @@ int ChainAPI::GetChain_Handler(struct mg_connection* conn, void* pNodeContext)
 		chainNode["prev_block_to_last"] = pTip->GetPreviousBlockHash().ToHex();
 		chainNode["total_difficulty"] = pTip->GetTotalDifficulty();
 
-		return HTTPUtil::BuildSuccessResponse(conn, chainNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, chainNode);
 	}
 	else
 	{
@@ -68,66 +70,58 @@ int ChainAPI::GetChainOutputsByHeight_Handler(struct mg_connection* conn, void*
 		endHeight = startHeight;
 	}
 
-	Json::Value rootNode;
-
 	std::vector<BlockWithOutputs> blocksWithOutputs = pServer->m_pBlockChainServer->GetOutputsByHeight(startHeight, endHeight);
+
+	/*
+		[
+		  {
+			"header": {
+			  "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
+			  "height": 0,
+			  "previous": "0000000000000000000000000000000000000000000000000000000000000000"
+			},
+			"outputs": [
+			  {
+				"output_type": "Coinbase",
+				"commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
+				"spent": false,
+				"proof": null,
+				"proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
+				"block_height": 0,
+				"merkle_proof": "00000000000000010000000000000000",
+				"mmr_index": 1
+			  }
+			]
+		  }
+		]
+	*/
+	// Stream one block at a time, rather than building the whole range in memory.
+	JsonStreamWriter writer(conn);
+	writer.BeginArray();
 	for (const BlockWithOutputs& block : blocksWithOutputs)
 	{
-			/*
-			
-    "header": {
-      "hash": "40adad0aec27797b48840aa9e00472015c21baea118ce7a2ff1a82c0f8f5bf82",
-      "height": 0,
-      "previous": "0000000000000000000000000000000000000000000000000000000000000000"
-    },
-    "outputs": [
-      {
-        "output_type": "Coinbase",
-        "commit": "08b7e57c448db5ef25aa119dde2312c64d7ff1b890c416c6dda5ec73cbfed2edea",
-        "spent": false,
-        "proof": null,
-        "proof_hash": "6c301688d9186c3a99444f827bdfe3b858fe87fc314737a4dc1155d9884491d2",
-        "block_height": 0,
-        "merkle_proof": "00000000000000010000000000000000",
-        "mmr_index": 1
-      }
-    ]
-			*/
-		Json::Value blockNode;
+		writer.BeginObject();
 
 		Json::Value headerNode;
 		headerNode["hash"] = block.GetBlockIdentifier().GetHash().ToHex();
 		headerNode["height"] = block.GetBlockIdentifier().GetHeight();
 		headerNode["previous"] = block.GetBlockIdentifier().GetPreviousHash().ToHex();
-		blockNode["header"] = headerNode;
+		writer.KeyValue("header", headerNode);
 
-		Json::Value outputsNode;
+		writer.Key("outputs");
+		writer.BeginArray();
 		for (const OutputDTO& output : block.GetOutputs())
 		{
-			// TODO: Move to JSONFactory
-			Json::Value outputNode;
-			const EOutputFeatures features = output.GetIdentifier().GetFeatures();
-			outputNode["output_type"] = features == DEFAULT_OUTPUT ? "Transaction" : "Coinbase";
-			outputNode["commit"] = output.GetIdentifier().GetCommitment().ToHex();
-			outputNode["spent"] = false;
-			outputNode["proof"] = output.GetRangeProof().Format();
-
-			Serializer proofSerializer;
-			output.GetRangeProof().Serialize(proofSerializer);
-			outputNode["proof_hash"] = Crypto::Blake2b(proofSerializer.GetBytes()).ToHex();
-
-			outputNode["block_height"] = output.GetLocation().GetBlockHeight();
-			outputNode["merkle_proof"] = Json::nullValue;
-			outputNode["mmr_index"] = output.GetLocation().GetMMRIndex() + 1;
-			outputsNode.append(outputNode);
+			writer.Value(JSONFactory::BuildOutputJSON(output, false));
 		}
 
-		blockNode["outputs"] = outputsNode;
-
-		rootNode.append(blockNode);
+		writer.EndArray();
+		writer.EndObject();
 	}
 
-	return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+	writer.EndArray();
+
+	return writer.Finish();
 }
 
 int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNodeContext)
@@ -157,15 +151,23 @@ int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNo
 
 	std::shared_ptr<Locked<IBlockDB>> pBlockDB = pServer->m_pDatabase->GetBlockDB();
 
-	Json::Value rootNode;
+	std::vector<Commitment> commitments;
+	commitments.reserve(ids.size());
 	for (const std::string& id : ids)
 	{
-		Commitment commitment(CBigInteger<33>::FromHex(id));
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->Read()->GetOutputPosition(commitment);
+		commitments.emplace_back(Commitment(CBigInteger<33>::FromHex(id)));
+	}
+
+	const std::vector<std::unique_ptr<OutputLocation>> outputPositions = pBlockDB->Read()->GetOutputPositions(commitments);
+
+	Json::Value rootNode;
+	for (size_t i = 0; i < commitments.size(); i++)
+	{
+		const std::unique_ptr<OutputLocation>& pOutputPosition = outputPositions[i];
 		if (pOutputPosition != nullptr)
 		{
 			Json::Value outputNode;
-			outputNode["commit"] = commitment.Format();
+			outputNode["commit"] = commitments[i].Format();
 			outputNode["height"] = pOutputPosition->GetBlockHeight();
 			outputNode["mmr_index"] = pOutputPosition->GetMMRIndex() + 1;
 
@@ -173,5 +175,5 @@ int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNo
 		}
 	}
 
-	return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+	return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 }
\ No newline at end of file
@@ -79,7 +79,7 @@ int BlockInfoAPI::GetLatestBlockInfo(struct mg_connection* conn, NodeContext& se
 
 		rootNode["blocks"] = blocksNode;
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 	}
 	else
 	{
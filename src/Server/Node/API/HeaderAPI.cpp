@@ -7,6 +7,7 @@
 #include <Infrastructure/Logger.h>
 #include <Common/Util/StringUtil.h>
 #include <Common/Util/HexUtil.h>
+#include <Core/Util/JsonUtil.h>
 #include <string>
 
 //
@@ -20,17 +21,33 @@
 int HeaderAPI::GetHeader_Handler(struct mg_connection* conn, void* pNodeContext)
 {
 	const std::string requestedHeader = HTTPUtil::GetURIParam(conn, "/v1/headers/");
+
+	// A header requested by hash never changes, so its response can be cached.
+	auto pResponseCache = ((NodeContext*)pNodeContext)->m_pResponseCache;
+	const bool cacheable = requestedHeader.length() == 64 && HexUtil::IsValidHex(requestedHeader);
+	const ResponseCacheKey cacheKey{ cacheable ? Hash::FromHex(requestedHeader) : ZERO_HASH, EResponseType::HEADER };
+
+	std::string response;
+	if (cacheable && pResponseCache->Get(cacheKey, response))
+	{
+		return HTTPUtil::BuildSuccessResponse(conn, response);
+	}
+
 	auto pBlockHeader = GetHeader(requestedHeader, ((NodeContext*)pNodeContext)->m_pBlockChainServer);
 
 	if (nullptr != pBlockHeader)
 	{
-		const Json::Value headerNode = JSONFactory::BuildHeaderJSON(*pBlockHeader);
-		return HTTPUtil::BuildSuccessResponse(conn, headerNode.toStyledString());
+		response = JsonUtil::WriteCondensed(JSONFactory::BuildHeaderJSON(*pBlockHeader));
+		if (cacheable)
+		{
+			pResponseCache->Put(cacheKey, response);
+		}
+
+		return HTTPUtil::BuildSuccessResponse(conn, response);
 	}
 	else
 	{
-		const std::string response = "HEADER NOT FOUND";
-		return HTTPUtil::BuildBadRequestResponse(conn, response);
+		return HTTPUtil::BuildBadRequestResponse(conn, "HEADER NOT FOUND");
 	}
 }
 
@@ -25,7 +25,7 @@ int PeersAPI::GetAllPeers_Handler(struct mg_connection* conn, void* pNodeContext
 		rootNode.append(JSONFactory::BuildPeerJSON(*peer));
 	}
 
-	return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+	return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 }
 
 //
@@ -47,7 +47,7 @@ int PeersAPI::GetConnectedPeers_Handler(struct mg_connection* conn, void* pNodeC
 		rootNode.append(JSONFactory::BuildConnectedPeerJSON(connectedPeer));
 	}
 
-	return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+	return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 }
 
 //
@@ -97,7 +97,7 @@ int PeersAPI::Peer_Handler(struct mg_connection* conn, void* pNodeContext)
 				Json::Value rootNode;
 				rootNode.append(JSONFactory::BuildPeerJSON(*peerOpt.value()));
 
-				return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+				return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 			}
 		}
 		else
@@ -1,6 +1,9 @@
 #include "ServerAPI.h"
 #include "../NodeContext.h"
 
+#include "../../JSONFactory.h"
+
+#include <Core/Validation/VerificationCache.h>
 #include <Net/Util/HTTPUtil.h>
 #include <P2P/Common.h>
 #include <json/json.h>
@@ -12,6 +15,7 @@
 	mg_set_request_handler(ctx, "/v1/chain/outputs/byids", ChainAPI::GetChainOutputsByIds_Handler, &m_nodeContext);
 	mg_set_request_handler(ctx, "/v1/chain/outputs/byheight", ChainAPI::GetChainOutputsByHeight_Handler, &m_nodeContext);
 	mg_set_request_handler(ctx, "/v1/chain", ChainAPI::GetChain_Handler, m_pBlockChainServer);
+	mg_set_request_handler(ctx, "/v1/sync/blocks", ServerAPI::GetBlockDownload_Handler, &m_nodeContext);
 	mg_set_request_handler(ctx, "/v1/peers/all", PeersAPI::GetAllPeers_Handler, &m_nodeContext);
 	mg_set_request_handler(ctx, "/v1/peers/connected", PeersAPI::GetConnectedPeers_Handler, &m_nodeContext);
 	mg_set_request_handler(ctx, "/v1/peers/", PeersAPI::Peer_Handler, &m_nodeContext);
@@ -33,6 +37,7 @@ int ServerAPI::V1_Handler(struct mg_connection* conn, void*)
 		rootNode.append("GET /v1/chain/");
 		rootNode.append("GET /v1/chain/outputs/byids?id=xxx,yyy&id=zzz");
 		rootNode.append("GET /v1/chain/outputs/byheight?start_height=100&end_height=200");
+		rootNode.append("GET /v1/sync/blocks");
 		rootNode.append("GET /v1/peers/all");
 		rootNode.append("GET /v1/peers/connected");
 		rootNode.append("GET /v1/peers/a.b.c.d");
@@ -43,8 +48,10 @@ int ServerAPI::V1_Handler(struct mg_connection* conn, void*)
 		rootNode.append("GET /v1/txhashset/lastoutputs?n=###");
 		rootNode.append("GET /v1/txhashset/lastrangeproofs?n=###");
 		rootNode.append("GET /v1/txhashset/outputs?start_index=1&max=100");
+		rootNode.append("GET /v1/txhashset/outputs/bulk?start_index=0&max=10000");
+		rootNode.append("GET /v1/txhashset/outputs/bulk?cursor=<id>&max=10000");
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 	}
 	else
 	{
@@ -93,7 +100,16 @@ int ServerAPI::GetStatus_Handler(struct mg_connection* conn, void* pNodeContext)
 	const uint64_t headerHeight = pServer->m_pBlockChainServer->GetHeight(EChainType::CANDIDATE);
 	statusNode["header_height"] = headerHeight;
 
-	return HTTPUtil::BuildSuccessResponse(conn, statusNode.toStyledString());
+	// How often range proofs and kernel signatures were found already verified, and so skipped.
+	const VerificationCache& verificationCache = VerificationCache::GetInstance();
+	Json::Value cacheNode;
+	cacheNode["rangeproof_hits"] = verificationCache.GetRangeProofHits();
+	cacheNode["rangeproof_misses"] = verificationCache.GetRangeProofMisses();
+	cacheNode["kernel_hits"] = verificationCache.GetKernelHits();
+	cacheNode["kernel_misses"] = verificationCache.GetKernelMisses();
+	statusNode["verification_cache"] = cacheNode;
+
+	return HTTPUtil::BuildSuccessResponseJSON(conn, statusNode);
 }
 
 std::string ServerAPI::GetStatusString(const SyncStatus& syncStatus)
@@ -139,4 +155,18 @@ int ServerAPI::ResyncChain_Handler(struct mg_connection* conn, void* pNodeContex
 	pServer->m_pP2PServer->UnbanAllPeers();
 
 	return HTTPUtil::BuildSuccessResponse(conn, "");
+}
+
+//
+// Handles requests for the state of the block download scheduler.
+//
+// APIs:
+// GET /v1/sync/blocks
+//
+int ServerAPI::GetBlockDownload_Handler(struct mg_connection* conn, void* pNodeContext)
+{
+	NodeContext* pServer = (NodeContext*)pNodeContext;
+
+	const BlockDownloadStats stats = pServer->m_pP2PServer->GetBlockDownloadStats();
+	return HTTPUtil::BuildSuccessResponseJSON(conn, JSONFactory::BuildBlockDownloadStatsJSON(stats));
 }
\ No newline at end of file
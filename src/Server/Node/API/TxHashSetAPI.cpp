@@ -3,9 +3,12 @@
 #include "../NodeContext.h"
 
 #include <Net/Util/HTTPUtil.h>
+#include <Net/Util/JsonStreamWriter.h>
 #include <Common/Util/StringUtil.h>
 #include <Crypto/Crypto.h>
+#include <Infrastructure/Logger.h>
 #include <json/json.h>
+#include <zlib.h>
 
 /*
   "get txhashset/roots",
@@ -13,6 +16,8 @@
   "get txhashset/lastrangeproofs",
   "get txhashset/lastkernels",
   "get txhashset/outputs?start_index=1&max=100",
+  "get txhashset/outputs/bulk?start_index=0&max=10000",
+  "get txhashset/outputs/bulk?cursor=<id>&max=10000",
 */
 
 
@@ -27,7 +32,7 @@ int TxHashSetAPI::GetRoots_Handler(struct mg_connection* conn, void* pNodeContex
 		rootNode["range_proof_root_hash"] = pTipHeader->GetRangeProofRoot().ToHex();
 		rootNode["kernel_root_hash"] = pTipHeader->GetKernelRoot().ToHex();
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 	}
 	else
 	{
@@ -66,7 +71,7 @@ int TxHashSetAPI::GetLastKernels_Handler(struct mg_connection* conn, void* pNode
 			rootNode.append(kernelNode);
 		}
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 	}
 	else
 	{
@@ -105,7 +110,7 @@ int TxHashSetAPI::GetLastOutputs_Handler(struct mg_connection* conn, void* pNode
 			rootNode.append(outputNode);
 		}
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 	}
 	else
 	{
@@ -144,7 +149,7 @@ int TxHashSetAPI::GetLastRangeproofs_Handler(struct mg_connection* conn, void* p
 			rootNode.append(rangeProofNode);
 		}
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return HTTPUtil::BuildSuccessResponseJSON(conn, rootNode);
 	}
 	else
 	{
@@ -214,39 +219,162 @@ int TxHashSetAPI::GetOutputs_Handler(struct mg_connection* conn, void* pNodeCont
 	auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
 	if (pTxHashSet != nullptr)
 	{
-		Json::Value rootNode;
-
 		auto pBlockDB = pServer->m_pDatabase->GetBlockDB()->Read();
 		OutputRange range = pTxHashSet->Read()->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
-		rootNode["highest_index"] = range.GetHighestIndex();
-		rootNode["last_retrieved_index"] = range.GetLastRetrievedIndex();
 
-		Json::Value outputsNode;
+		// Stream the outputs, rather than building the whole response in memory.
+		JsonStreamWriter writer(conn);
+		writer.BeginObject();
+		writer.KeyValue("highest_index", range.GetHighestIndex());
+		writer.KeyValue("last_retrieved_index", range.GetLastRetrievedIndex());
+
+		writer.Key("outputs");
+		writer.BeginArray();
 		for (const OutputDTO& info : range.GetOutputs())
 		{
-			Json::Value outputNode;
-			const EOutputFeatures features = info.GetIdentifier().GetFeatures();
-			outputNode["output_type"] = features == DEFAULT_OUTPUT ? "Transaction" : "Coinbase";
-			outputNode["commit"] = info.GetIdentifier().GetCommitment().ToHex();
-			outputNode["spent"] = info.IsSpent();
-			outputNode["proof"] = info.GetRangeProof().Format();
-
-			Serializer proofSerializer;
-			info.GetRangeProof().Serialize(proofSerializer);
-			outputNode["proof_hash"] = Crypto::Blake2b(proofSerializer.GetBytes()).ToHex();
-
-			outputNode["block_height"] = info.GetLocation().GetBlockHeight();
-			outputNode["merkle_proof"] = Json::nullValue;
-			outputNode["mmr_index"] = info.GetLocation().GetMMRIndex() + 1;
-			outputsNode.append(outputNode);
+			writer.Value(JSONFactory::BuildOutputJSON(info, info.IsSpent()));
 		}
 
-		rootNode["outputs"] = outputsNode;
+		writer.EndArray();
+		writer.EndObject();
 
-		return HTTPUtil::BuildSuccessResponse(conn, rootNode.toStyledString());
+		return writer.Finish();
 	}
 	else
 	{
 		return HTTPUtil::BuildInternalErrorResponse(conn, "Failed to find TxHashSet.");
 	}
+}
+
+static const uint64_t MAX_BULK_OUTPUTS = 10000;
+
+// get txhashset/outputs/bulk?start_index=0&max=10000
+// get txhashset/outputs/bulk?cursor=<id>&max=10000
+//
+// Returns the unspent outputs starting at the given leaf index (or where the given cursor left off) in a compact binary form,
+// for clients that need to read the whole output set (e.g. wallet restores) without the cost of JSON.
+// max defaults to (and is capped at) 10000.
+//
+// The application/octet-stream body is the id of the cursor to pass to get the next batch (u64, 0 once all outputs have been read),
+// followed by the OutputRange serialization. It's deflated (Content-Encoding: deflate) when the request's Accept-Encoding allows it.
+// A cursor that's been idle for too long expires, and requesting it returns 404 "Cursor expired". The client can then continue
+// with start_index set to one past the last leaf index it received.
+int TxHashSetAPI::GetOutputsBulk_Handler(struct mg_connection* conn, void* pNodeContext)
+{
+	NodeContext* pServer = (NodeContext*)pNodeContext;
+
+	uint64_t cursorId = 0;
+	uint64_t startIndex = 0;
+	uint64_t max = MAX_BULK_OUTPUTS;
+	try
+	{
+		const std::optional<std::string> cursorOpt = HTTPUtil::GetQueryParam(conn, "cursor");
+		const std::optional<std::string> startIndexOpt = HTTPUtil::GetQueryParam(conn, "start_index");
+		const std::optional<std::string> maxOpt = HTTPUtil::GetQueryParam(conn, "max");
+
+		if (maxOpt.has_value())
+		{
+			max = (std::min)((uint64_t)std::stoull(maxOpt.value()), MAX_BULK_OUTPUTS);
+		}
+
+		if (cursorOpt.has_value())
+		{
+			cursorId = std::stoull(cursorOpt.value());
+
+			const OutputCursors::EStatus status = pServer->m_pOutputCursors->Take(cursorId, startIndex);
+			if (status == OutputCursors::EStatus::EXPIRED)
+			{
+				return HTTPUtil::BuildNotFoundResponse(conn, "Cursor expired");
+			}
+			else if (status == OutputCursors::EStatus::IN_USE)
+			{
+				return HTTPUtil::BuildConflictResponse(conn, "Cursor is already being read");
+			}
+		}
+		else if (startIndexOpt.has_value())
+		{
+			startIndex = std::stoull(startIndexOpt.value());
+		}
+	}
+	catch (const std::exception&)
+	{
+		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/txhashset/outputs/bulk?start_index=0&max=10000 or /v1/txhashset/outputs/bulk?cursor=<id>&max=10000");
+	}
+
+	const uint64_t takenCursorId = cursorId;
+	try
+	{
+		auto pTxHashSet = pServer->m_pTxHashSetManager->GetTxHashSet();
+		if (pTxHashSet == nullptr)
+		{
+			throw std::runtime_error("Failed to find TxHashSet.");
+		}
+
+		auto pBlockDB = pServer->m_pDatabase->GetBlockDB()->Read();
+		const OutputRange range = pTxHashSet->Read()->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, max);
+
+		// Only keep the cursor open while there are outputs left to read.
+		if (range.GetLastRetrievedIndex() != 0 && range.GetLastRetrievedIndex() < range.GetHighestIndex())
+		{
+			if (cursorId != 0)
+			{
+				pServer->m_pOutputCursors->Advance(cursorId, range.GetLastRetrievedIndex() + 1);
+			}
+			else
+			{
+				std::optional<uint64_t> cursorIdOpt = pServer->m_pOutputCursors->Open(range.GetLastRetrievedIndex() + 1);
+				if (!cursorIdOpt.has_value())
+				{
+					return HTTPUtil::BuildConflictResponse(conn, "Too many cursors are being read. Try again later.");
+				}
+
+				cursorId = cursorIdOpt.value();
+			}
+		}
+		else
+		{
+			pServer->m_pOutputCursors->Close(cursorId);
+			cursorId = 0;
+		}
+
+		Serializer serializer;
+		serializer.Append<uint64_t>(cursorId);
+		range.Serialize(serializer);
+
+		const std::optional<std::string> acceptEncodingOpt = HTTPUtil::GetHeaderValue(conn, "Accept-Encoding");
+		if (acceptEncodingOpt.has_value() && HTTPUtil::AcceptsEncoding(acceptEncodingOpt.value(), "deflate"))
+		{
+			return HTTPUtil::BuildSuccessResponseBinary(conn, Deflate(serializer.GetBytes()), "deflate");
+		}
+
+		return HTTPUtil::BuildSuccessResponseBinary(conn, serializer.GetBytes());
+	}
+	catch (const std::exception& e)
+	{
+		// Leave the cursor where it was, so the client can retry the same batch.
+		if (takenCursorId != 0)
+		{
+			pServer->m_pOutputCursors->Release(takenCursorId);
+		}
+
+		LOG_ERROR_F("Failed to read outputs from leaf index {}: {}", startIndex, e.what());
+		return HTTPUtil::BuildInternalErrorResponse(conn, e.what());
+	}
+}
+
+// Compresses the bytes into the zlib format, which is what HTTP calls "deflate".
+std::vector<unsigned char> TxHashSetAPI::Deflate(const std::vector<unsigned char>& bytes)
+{
+	uLongf compressedSize = compressBound((uLong)bytes.size());
+	std::vector<unsigned char> compressed(compressedSize);
+
+	const int result = compress2(compressed.data(), &compressedSize, bytes.data(), (uLong)bytes.size(), Z_BEST_SPEED);
+	if (result != Z_OK)
+	{
+		LOG_ERROR_F("Failed to compress response: {}", result);
+		throw std::runtime_error("Failed to compress response");
+	}
+
+	compressed.resize(compressedSize);
+	return compressed;
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "../../civetweb/include/civetweb.h"
 
+#include <vector>
+
 class TxHashSetAPI
 {
 public:
@@ -10,4 +12,8 @@ public:
 	static int GetLastOutputs_Handler(struct mg_connection* conn, void* pNodeContext);
 	static int GetLastRangeproofs_Handler(struct mg_connection* conn, void* pNodeContext);
 	static int GetOutputs_Handler(struct mg_connection* conn, void* pNodeContext);
+	static int GetOutputsBulk_Handler(struct mg_connection* conn, void* pNodeContext);
+
+private:
+	static std::vector<unsigned char> Deflate(const std::vector<unsigned char>& bytes);
 };
\ No newline at end of file
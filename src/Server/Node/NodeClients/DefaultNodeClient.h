@@ -92,6 +92,19 @@ public:
 		return std::make_unique<OutputRange>(pTxHashSet->Read()->GetOutputsByLeafIndex(pBlockDB.GetShared(), startIndex, maxNumOutputs));
 	}
 
+	virtual std::vector<unsigned char> GetOutputsBulk(const uint64_t startIndex, const uint64_t maxNumOutputs) const override final
+	{
+		std::unique_ptr<OutputRange> pOutputRange = GetOutputsByLeafIndex(startIndex, maxNumOutputs);
+		if (pOutputRange == nullptr)
+		{
+			return std::vector<unsigned char>();
+		}
+
+		Serializer serializer;
+		pOutputRange->Serialize(serializer);
+		return serializer.GetBytes();
+	}
+
 	virtual bool PostTransaction(TransactionPtr pTransaction, const EPoolType poolType) override final
 	{
 		auto pTipHeader = m_pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED);
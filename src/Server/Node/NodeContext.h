@@ -1,5 +1,8 @@
 #pragma once
 
+#include "OutputCursors.h"
+#include "ResponseCache.h"
+
 #include <Database/Database.h>
 #include <BlockChain/BlockChainServer.h>
 #include <P2P/P2PServer.h>
@@ -9,7 +12,9 @@
 struct NodeContext
 {
 	NodeContext(IDatabasePtr pDatabase, IBlockChainServerPtr pBlockChainServer, IP2PServerPtr pP2PServer, TxHashSetManagerPtr pTxHashSetManager, ITransactionPoolPtr pTransactionPool)
-		: m_pDatabase(pDatabase), m_pBlockChainServer(pBlockChainServer), m_pP2PServer(pP2PServer), m_pTxHashSetManager(pTxHashSetManager), m_pTransactionPool(pTransactionPool)
+		: m_pDatabase(pDatabase), m_pBlockChainServer(pBlockChainServer), m_pP2PServer(pP2PServer), m_pTxHashSetManager(pTxHashSetManager), m_pTransactionPool(pTransactionPool),
+		m_pResponseCache(std::make_shared<ResponseCache>(0)),
+		m_pOutputCursors(std::make_shared<OutputCursors>())
 	{
 
 	}
@@ -19,4 +24,9 @@ struct NodeContext
 	IP2PServerPtr m_pP2PServer;
 	TxHashSetManagerPtr m_pTxHashSetManager;
 	ITransactionPoolPtr m_pTransactionPool;
+
+	// Disabled (capacity 0) until the REST server sets its capacity in bytes.
+	std::shared_ptr<ResponseCache> m_pResponseCache;
+
+	std::shared_ptr<OutputCursors> m_pOutputCursors;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <BlockChain/BlockChainServer.h>
 #include <Crypto/Crypto.h>
 #include <Consensus/BlockDifficulty.h>
+#include <Core/Validation/VerificationCache.h>
 #include <Database/Database.h>
 #include <Infrastructure/Logger.h>
 #include <PMMR/TxHashSetManager.h>
@@ -22,6 +23,9 @@ NodeDaemon::NodeDaemon(const Config& config, std::shared_ptr<NodeRestServer> pNo
 
 std::shared_ptr<NodeDaemon> NodeDaemon::Create(const Config& config)
 {
+	const VerificationCacheConfig& cacheConfig = config.GetNodeConfig().GetVerificationCache();
+	VerificationCache::GetInstance().SetCapacity(cacheConfig.GetRangeProofCapacity(), cacheConfig.GetKernelCapacity());
+
 	std::shared_ptr<DefaultNodeClient> pNodeClient = DefaultNodeClient::Create(config);
 	std::shared_ptr<NodeRestServer> pNodeRestServer = NodeRestServer::Create(config, pNodeClient->GetNodeContext());
 
@@ -54,18 +54,22 @@ void NodeRestServer::Initialize()
 	/* Start the server */
 	const uint32_t port = m_config.GetServerConfig().GetRestAPIPort();
 	const std::string listeningPorts = StringUtil::Format("127.0.0.1:{}", port);
+	const std::string numThreads = std::to_string(m_config.GetServerConfig().GetRestAPIThreads());
 	const char* mg_options[] = {
-		"num_threads", "5",
+		"num_threads", numThreads.c_str(),
 		"listening_ports", listeningPorts.c_str(),
 		NULL
 	};
 	m_pNodeCivetContext = mg_start(NULL, 0, mg_options);
 
+	m_pNodeContext->m_pResponseCache->SetCapacity(m_config.GetServerConfig().GetRestAPICacheSize());
+
 	/* Add handlers */
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/explorer/blockinfo/", BlockInfoAPI::GetBlockInfo_Handler, m_pNodeContext.get());
 
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/status", ServerAPI::GetStatus_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/resync", ServerAPI::ResyncChain_Handler, m_pNodeContext.get());
+	mg_set_request_handler(m_pNodeCivetContext, "/v1/sync/blocks", ServerAPI::GetBlockDownload_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/headers/", HeaderAPI::GetHeader_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/blocks/", BlockAPI::GetBlock_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/chain/outputs/byids", ChainAPI::GetChainOutputsByIds_Handler, m_pNodeContext.get());
@@ -78,6 +82,7 @@ void NodeRestServer::Initialize()
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/txhashset/lastkernels", TxHashSetAPI::GetLastKernels_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/txhashset/lastoutputs", TxHashSetAPI::GetLastOutputs_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/txhashset/lastrangeproofs", TxHashSetAPI::GetLastRangeproofs_Handler, m_pNodeContext.get());
+	mg_set_request_handler(m_pNodeCivetContext, "/v1/txhashset/outputs/bulk", TxHashSetAPI::GetOutputsBulk_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/txhashset/outputs", TxHashSetAPI::GetOutputs_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/shutdown", Shutdown_Handler, m_pNodeContext.get());
 	mg_set_request_handler(m_pNodeCivetContext, "/v1/", ServerAPI::V1_Handler, m_pNodeContext.get());
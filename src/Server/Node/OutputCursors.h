@@ -0,0 +1,177 @@
+#pragma once
+
+#include <Crypto/RandomNumberGenerator.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+//
+// Server-side cursors for the bulk output API (/v1/txhashset/outputs/bulk).
+//
+// A client opens a cursor by requesting its first batch by leaf index, and then just passes the cursor's id back
+// to get each following batch. Ids are random, so one client can't guess (and advance) another client's cursor.
+//
+// A cursor is marked in use while its batch is being read, so the same cursor can't be used by two requests at once,
+// and a cursor that's in use is never evicted. Cursors that sit idle for CURSOR_TIMEOUT expire. Once MAX_CURSORS are open,
+// opening another evicts the one that's been idle the longest.
+//
+class OutputCursors
+{
+	static constexpr std::chrono::minutes CURSOR_TIMEOUT = std::chrono::minutes(10);
+	static const size_t MAX_CURSORS = 64;
+
+public:
+	enum class EStatus
+	{
+		SUCCESS,
+		EXPIRED,
+		IN_USE
+	};
+
+	//
+	// Marks the cursor as in use, and returns the leaf index its next batch starts at.
+	// Returns EXPIRED if the cursor doesn't exist, either because it timed out, was evicted, or was never opened.
+	//
+	EStatus Take(const uint64_t cursorId, uint64_t& nextIndex)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		RemoveExpired();
+
+		auto iter = m_cursors.find(cursorId);
+		if (iter == m_cursors.end())
+		{
+			return EStatus::EXPIRED;
+		}
+
+		if (iter->second.inUse)
+		{
+			return EStatus::IN_USE;
+		}
+
+		iter->second.inUse = true;
+		iter->second.lastUsed = std::chrono::steady_clock::now();
+		nextIndex = iter->second.nextIndex;
+		return EStatus::SUCCESS;
+	}
+
+	//
+	// Opens a cursor whose next batch starts at nextIndex, and returns its id.
+	// Returns std::nullopt if MAX_CURSORS are already open, and they're all in use.
+	//
+	std::optional<uint64_t> Open(const uint64_t nextIndex)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		RemoveExpired();
+
+		if (m_cursors.size() >= MAX_CURSORS)
+		{
+			auto leastRecent = m_cursors.end();
+			for (auto iter = m_cursors.begin(); iter != m_cursors.end(); iter++)
+			{
+				if (!iter->second.inUse && (leastRecent == m_cursors.end() || iter->second.lastUsed < leastRecent->second.lastUsed))
+				{
+					leastRecent = iter;
+				}
+			}
+
+			if (leastRecent == m_cursors.end())
+			{
+				return std::nullopt;
+			}
+
+			m_cursors.erase(leastRecent);
+		}
+
+		uint64_t cursorId = 0;
+		while (cursorId == 0 || m_cursors.count(cursorId) > 0)
+		{
+			cursorId = GenerateId();
+		}
+
+		m_cursors[cursorId] = Cursor{ nextIndex, std::chrono::steady_clock::now(), false };
+		return std::make_optional(cursorId);
+	}
+
+	//
+	// Moves a taken cursor to nextIndex, and marks it as no longer in use.
+	//
+	void Advance(const uint64_t cursorId, const uint64_t nextIndex)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto iter = m_cursors.find(cursorId);
+		if (iter != m_cursors.end())
+		{
+			iter->second.nextIndex = nextIndex;
+			iter->second.lastUsed = std::chrono::steady_clock::now();
+			iter->second.inUse = false;
+		}
+	}
+
+	//
+	// Marks a taken cursor as no longer in use, without moving it, so the same batch can be requested again.
+	//
+	void Release(const uint64_t cursorId)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto iter = m_cursors.find(cursorId);
+		if (iter != m_cursors.end())
+		{
+			iter->second.lastUsed = std::chrono::steady_clock::now();
+			iter->second.inUse = false;
+		}
+	}
+
+	//
+	// Removes a cursor once all of its outputs have been read.
+	//
+	void Close(const uint64_t cursorId)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cursors.erase(cursorId);
+	}
+
+private:
+	struct Cursor
+	{
+		uint64_t nextIndex;
+		std::chrono::steady_clock::time_point lastUsed;
+		bool inUse;
+	};
+
+	static uint64_t GenerateId()
+	{
+		const SecureVector bytes = RandomNumberGenerator::GenerateRandomBytes(sizeof(uint64_t));
+
+		uint64_t id = 0;
+		for (const unsigned char byte : bytes)
+		{
+			id = (id << 8) | byte;
+		}
+
+		return id;
+	}
+
+	// Caller must hold m_mutex.
+	void RemoveExpired()
+	{
+		const auto now = std::chrono::steady_clock::now();
+		for (auto iter = m_cursors.begin(); iter != m_cursors.end();)
+		{
+			if (!iter->second.inUse && now - iter->second.lastUsed > CURSOR_TIMEOUT)
+			{
+				iter = m_cursors.erase(iter);
+			}
+			else
+			{
+				iter++;
+			}
+		}
+	}
+
+	std::mutex m_mutex;
+	std::unordered_map<uint64_t, Cursor> m_cursors;
+};
\ No newline at end of file
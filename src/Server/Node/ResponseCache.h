@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Crypto/Hash.h>
+#include <Common/ShardedLRUCache.h>
+#include <cstdint>
+#include <string>
+
+//
+// Serialized responses to immutable resources (blocks and headers requested by hash).
+//
+// Entries are keyed by the resource's hash and the kind of response, not by the request URI,
+// so unrelated query strings can't fill the cache with copies of the same response.
+// The cache is bounded by the total number of bytes of the cached responses.
+//
+enum class EResponseType : uint8_t
+{
+	BLOCK,
+	COMPACT_BLOCK,
+	HEADER
+};
+
+struct ResponseCacheKey
+{
+	Hash hash;
+	EResponseType type;
+
+	bool operator==(const ResponseCacheKey& other) const { return type == other.type && hash == other.hash; }
+};
+
+struct ResponseCacheKeyHasher
+{
+	size_t operator()(const ResponseCacheKey& key) const
+	{
+		return std::hash<Hash>()(key.hash) ^ ((size_t)key.type << 8);
+	}
+};
+
+struct ResponseSizer
+{
+	size_t operator()(const ResponseCacheKey&, const std::string& response) const
+	{
+		return sizeof(ResponseCacheKey) + response.size();
+	}
+};
+
+typedef ShardedLRUCache<ResponseCacheKey, std::string, ResponseCacheKeyHasher, 16, ResponseSizer> ResponseCache;
\ No newline at end of file
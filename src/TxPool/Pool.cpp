@@ -5,62 +5,66 @@
 #include <Common/Util/VectorUtil.h>
 #include <Infrastructure/Logger.h>
 #include <algorithm>
-#include <unordered_map>
+#include <iterator>
 
 std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
 {
-	std::vector<TransactionPtr> transactionsFound;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	std::unique_lock<std::mutex> lock(m_shortIdMutex);
+
+	if (m_pShortIdIndex == nullptr || m_pShortIdIndex->blockHash != hash || m_pShortIdIndex->nonce != nonce)
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
+		m_pShortIdIndex = std::make_unique<ShortIdIndex>(ShortIdIndex{ hash, nonce, {} });
+		for (const TxPoolEntry& txPoolEntry : m_transactions)
 		{
-			const ShortId shortId = ShortId::Create(kernel.GetHash(), hash, nonce);
-			if (missingShortIds.find(shortId) != missingShortIds.cend())
+			for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
 			{
-				transactionsFound.push_back(txPoolEntry.GetTransaction());
-
-				if (transactionsFound.size() == missingShortIds.size())
-				{
-					return transactionsFound;
-				}
+				const ShortId shortId = ShortId::Create(kernel.GetHash(), hash, nonce);
+				m_pShortIdIndex->transactionsByShortId.insert({ shortId, txPoolEntry.GetTransaction() });
 			}
 		}
 	}
 
+	std::vector<TransactionPtr> transactionsFound;
+	for (const ShortId& shortId : missingShortIds)
+	{
+		auto iter = m_pShortIdIndex->transactionsByShortId.find(shortId);
+		if (iter != m_pShortIdIndex->transactionsByShortId.cend())
+		{
+			transactionsFound.push_back(iter->second);
+		}
+	}
+
 	return transactionsFound;
 }
 
 void Pool::AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status)
 {
+	if (m_txByHash.find(pTransaction->GetHash()) != m_txByHash.cend())
+	{
+		LOG_DEBUG_F("Transaction already in pool: {}", pTransaction->GetHash());
+		return;
+	}
+
 	LOG_DEBUG_F("Transaction added: {}", pTransaction->GetHash());
 
 	m_transactions.emplace_back(TxPoolEntry(pTransaction, status, std::time_t()));
+	AddToIndexes(std::prev(m_transactions.end()));
 }
 
 bool Pool::ContainsTransaction(const Transaction& transaction) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
-	{
-		if (*txPoolEntry.GetTransaction() == transaction)
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return m_txByHash.find(transaction.GetHash()) != m_txByHash.cend();
 }
 
 std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const
 {
 	std::set<TransactionPtr> transactionSet;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const TransactionKernel& kernel : kernels)
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
+		auto range = m_txByKernelHash.equal_range(kernel.GetHash());
+		for (auto iter = range.first; iter != range.second; iter++)
 		{
-			if (kernels.count(kernel) > 0)
-			{
-				transactionSet.insert(txPoolEntry.GetTransaction());
-			}
+			transactionSet.insert(iter->second->GetTransaction());
 		}
 	}
 
@@ -72,15 +76,10 @@ std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<Transa
 
 TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	auto iter = m_txByKernelHash.find(kernelHash);
+	if (iter != m_txByKernelHash.cend())
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
-		{
-			if (kernel.GetHash() == kernelHash)
-			{
-				return txPoolEntry.GetTransaction();
-			}
-		}
+		return iter->second->GetTransaction();
 	}
 
 	return nullptr;
@@ -118,85 +117,198 @@ std::vector<TransactionPtr> Pool::GetExpiredTransactions(const uint16_t embargoS
 
 void Pool::RemoveTransaction(const Transaction& transaction)
 {
-	auto iter = m_transactions.begin();
-	while (iter != m_transactions.end())
+	auto iter = m_txByHash.find(transaction.GetHash());
+	if (iter != m_txByHash.end())
 	{
-		if (transaction == *iter->GetTransaction())
-		{
-			m_transactions.erase(iter);
-			break;
-		}
-
-		++iter;
+		Remove(iter->second);
 	}
 }
 
 // Quick reconciliation step - we can evict any txs in the pool where
-// inputs or kernels intersect with the block.
+// inputs, outputs, or kernels intersect with the block.
 void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block, TransactionPtr pMemPoolAggTx)
 {
-	std::vector<TransactionPtr> filteredTransactions;
-	std::unordered_map<Hash, TxPoolEntry> filteredEntriesByHash;
-
 	// Filter txs in the pool based on the latest block.
 	// Reject any txs where we see a matching tx kernel in the block.
 	// Also reject any txs where we see a conflicting tx,
-	// where an input is spent in a different tx.
-	for (auto& txPoolEntry : m_transactions)
+	// where an input is spent or an output is created in a different tx.
+	const std::set<Hash> transactionsToEvict = FindTransactionsToEvict(block);
+
+	std::vector<TransactionPtr> filteredTransactions;
+	for (const TxPoolEntry& txPoolEntry : m_transactions)
 	{
-		if (!ShouldEvict(*txPoolEntry.GetTransaction(), block))
+		if (transactionsToEvict.count(txPoolEntry.GetTransaction()->GetHash()) == 0)
 		{
 			filteredTransactions.push_back(txPoolEntry.GetTransaction());
-			filteredEntriesByHash.insert(std::pair<Hash, TxPoolEntry>(txPoolEntry.GetTransaction()->GetHash(), txPoolEntry));
 		}
 	}
 
-	m_transactions.clear();
+	// Every tx in the pool was fully validated when it was added, so only conflicts with the new UTXO set need to be checked.
+	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindNonConflictingTransactions(pBlockDB, pTxHashSet, filteredTransactions, pMemPoolAggTx);
 
-	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(pBlockDB, pTxHashSet, filteredTransactions, pMemPoolAggTx);
+	std::unordered_map<Hash, TransactionPtr> validTransactionsByHash;
 	for (auto& pTransaction : validTransactions)
 	{
-		const TxPoolEntry& txPoolEntry = filteredEntriesByHash.at(pTransaction->GetHash());
-		m_transactions.push_back(txPoolEntry);
+		validTransactionsByHash.insert({ pTransaction->GetHash(), pTransaction });
+	}
+
+	auto iter = m_transactions.begin();
+	while (iter != m_transactions.end())
+	{
+		if (validTransactionsByHash.count(iter->GetTransaction()->GetHash()) == 0)
+		{
+			iter = Remove(iter);
+		}
+		else
+		{
+			++iter;
+		}
 	}
 }
 
 void Pool::ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
 {
-	for (auto& txPoolEntry : m_transactions)
+	for (auto& pTransaction : transactions)
+	{
+		auto iter = m_txByHash.find(pTransaction->GetHash());
+		if (iter != m_txByHash.end())
+		{
+			iter->second->SetStatus(status);
+		}
+	}
+}
+
+void Pool::Clear()
+{
+	m_transactions.clear();
+	m_txByHash.clear();
+	m_txByKernelHash.clear();
+	m_txByInput.clear();
+	m_txByOutput.clear();
+
+	std::unique_lock<std::mutex> lock(m_shortIdMutex);
+	m_pShortIdIndex.reset();
+}
+
+void Pool::AddToIndexes(EntryIter iter)
+{
+	const TransactionPtr& pTransaction = iter->GetTransaction();
+	m_txByHash.insert({ pTransaction->GetHash(), iter });
+
+	for (const TransactionKernel& kernel : pTransaction->GetKernels())
+	{
+		m_txByKernelHash.insert({ kernel.GetHash(), iter });
+	}
+
+	for (const TransactionInput& input : pTransaction->GetInputs())
+	{
+		m_txByInput.insert({ input.GetCommitment(), iter });
+	}
+
+	for (const TransactionOutput& output : pTransaction->GetOutputs())
+	{
+		m_txByOutput.insert({ output.GetCommitment(), iter });
+	}
+
+	std::unique_lock<std::mutex> lock(m_shortIdMutex);
+	if (m_pShortIdIndex != nullptr)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			const ShortId shortId = ShortId::Create(kernel.GetHash(), m_pShortIdIndex->blockHash, m_pShortIdIndex->nonce);
+			m_pShortIdIndex->transactionsByShortId.insert({ shortId, pTransaction });
+		}
+	}
+}
+
+template<class KEY>
+static void EraseFromIndex(std::unordered_multimap<KEY, std::list<TxPoolEntry>::iterator>& index, const KEY& key, std::list<TxPoolEntry>::iterator entryIter)
+{
+	auto range = index.equal_range(key);
+	for (auto iter = range.first; iter != range.second; iter++)
 	{
-		for (auto& transaction : transactions)
+		if (iter->second == entryIter)
 		{
-			if (txPoolEntry.GetTransaction() == transaction)
+			index.erase(iter);
+			return;
+		}
+	}
+}
+
+void Pool::RemoveFromIndexes(EntryIter iter)
+{
+	const TransactionPtr& pTransaction = iter->GetTransaction();
+	m_txByHash.erase(pTransaction->GetHash());
+
+	for (const TransactionKernel& kernel : pTransaction->GetKernels())
+	{
+		EraseFromIndex(m_txByKernelHash, kernel.GetHash(), iter);
+	}
+
+	for (const TransactionInput& input : pTransaction->GetInputs())
+	{
+		EraseFromIndex(m_txByInput, input.GetCommitment(), iter);
+	}
+
+	for (const TransactionOutput& output : pTransaction->GetOutputs())
+	{
+		EraseFromIndex(m_txByOutput, output.GetCommitment(), iter);
+	}
+
+	std::unique_lock<std::mutex> lock(m_shortIdMutex);
+	if (m_pShortIdIndex != nullptr)
+	{
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
+		{
+			const ShortId shortId = ShortId::Create(kernel.GetHash(), m_pShortIdIndex->blockHash, m_pShortIdIndex->nonce);
+			auto shortIdIter = m_pShortIdIndex->transactionsByShortId.find(shortId);
+			if (shortIdIter != m_pShortIdIndex->transactionsByShortId.end() && shortIdIter->second == pTransaction)
 			{
-				txPoolEntry.SetStatus(status);
-				break;
+				m_pShortIdIndex->transactionsByShortId.erase(shortIdIter);
 			}
 		}
 	}
 }
 
-bool Pool::ShouldEvict(const Transaction& transaction, const FullBlock& block) const
+Pool::EntryIter Pool::Remove(EntryIter iter)
+{
+	RemoveFromIndexes(iter);
+	return m_transactions.erase(iter);
+}
+
+std::set<Hash> Pool::FindTransactionsToEvict(const FullBlock& block) const
 {
-	const std::vector<TransactionInput>& blockInputs = block.GetInputs();
-	for (const TransactionInput& input : transaction.GetInputs())
+	std::set<Hash> transactionsToEvict;
+
+	for (const TransactionInput& input : block.GetInputs())
+	{
+		auto range = m_txByInput.equal_range(input.GetCommitment());
+		for (auto iter = range.first; iter != range.second; iter++)
+		{
+			transactionsToEvict.insert(iter->second->GetTransaction()->GetHash());
+		}
+	}
+
+	// An output the block created can't be created again, so a tx creating it would only be rejected by the UTXO check.
+	for (const TransactionOutput& output : block.GetOutputs())
 	{
-		if (std::find(blockInputs.begin(), blockInputs.end(), input) != blockInputs.end())
+		auto range = m_txByOutput.equal_range(output.GetCommitment());
+		for (auto iter = range.first; iter != range.second; iter++)
 		{
-			return true;
+			transactionsToEvict.insert(iter->second->GetTransaction()->GetHash());
 		}
 	}
 
-	const std::vector<TransactionKernel>& blockKernels = block.GetKernels();
-	for (const TransactionKernel& kernel : transaction.GetKernels())
+	for (const TransactionKernel& kernel : block.GetKernels())
 	{
-		if (std::find(blockKernels.begin(), blockKernels.end(), kernel) != blockKernels.end())
+		auto range = m_txByKernelHash.equal_range(kernel.GetHash());
+		for (auto iter = range.first; iter != range.second; iter++)
 		{
-			return true;
+			transactionsToEvict.insert(iter->second->GetTransaction()->GetHash());
 		}
 	}
 
-	return false;
+	return transactionsToEvict;
 }
 
 TransactionPtr Pool::Aggregate() const
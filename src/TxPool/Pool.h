@@ -10,14 +10,25 @@
 #include <Config/Config.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Crypto/Hash.h>
+#include <Crypto/Commitment.h>
+#include <list>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
+//
+// Transactions are kept in insertion order, with hash indexes (maintained on every add/remove)
+// for looking up transactions by tx hash, kernel hash, input commitment, and output commitment.
+//
 class Pool
 {
 public:
 	Pool() = default;
 	~Pool() = default;
 
+	Pool(const Pool&) = delete;
+	Pool& operator=(const Pool&) = delete;
+
 	void AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status);
 	bool ContainsTransaction(const Transaction& transaction) const;
 	void RemoveTransaction(const Transaction& transaction);
@@ -40,10 +51,30 @@ public:
 	std::vector<TransactionPtr> GetExpiredTransactions(const uint16_t embargoSeconds) const;
 
 	TransactionPtr Aggregate() const;
-	void Clear() { m_transactions.clear(); }
+	void Clear();
 
 private:
-	bool ShouldEvict(const Transaction& transaction, const FullBlock& block) const;
+	typedef std::list<TxPoolEntry>::iterator EntryIter;
+
+	struct ShortIdIndex
+	{
+		Hash blockHash;
+		uint64_t nonce;
+		std::unordered_map<ShortId, TransactionPtr> transactionsByShortId;
+	};
+
+	void AddToIndexes(EntryIter iter);
+	void RemoveFromIndexes(EntryIter iter);
+	EntryIter Remove(EntryIter iter);
+	std::set<Hash> FindTransactionsToEvict(const FullBlock& block) const;
+
+	std::list<TxPoolEntry> m_transactions;
+	std::unordered_map<Hash, EntryIter> m_txByHash;
+	std::unordered_multimap<Hash, EntryIter> m_txByKernelHash;
+	std::unordered_multimap<Commitment, EntryIter> m_txByInput;
+	std::unordered_multimap<Commitment, EntryIter> m_txByOutput;
 
-	std::vector<TxPoolEntry> m_transactions;
+	// Short ids depend on the block hash and nonce, so they're calculated once per compact block, and only updated incrementally until the next block.
+	mutable std::mutex m_shortIdMutex;
+	mutable std::unique_ptr<ShortIdIndex> m_pShortIdIndex;
 };
\ No newline at end of file
@@ -37,6 +37,41 @@ std::vector<TransactionPtr> ValidTransactionFinder::FindValidTransactions(
 	return validTransactions;
 }
 
+std::vector<TransactionPtr> ValidTransactionFinder::FindNonConflictingTransactions(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const std::vector<TransactionPtr>& transactions,
+	TransactionPtr pExtraTransaction)
+{
+	// Outputs created by the accepted txs that are not yet spent by another accepted tx, and inputs spent by them.
+	std::unordered_map<Commitment, EOutputFeatures> createdOutputs;
+	std::unordered_set<Commitment> spentOutputs;
+
+	if (pExtraTransaction != nullptr)
+	{
+		for (const TransactionInput& input : pExtraTransaction->GetInputs())
+		{
+			spentOutputs.insert(input.GetCommitment());
+		}
+
+		for (const TransactionOutput& output : pExtraTransaction->GetOutputs())
+		{
+			createdOutputs.insert({ output.GetCommitment(), output.GetFeatures() });
+		}
+	}
+
+	std::vector<TransactionPtr> validTransactions;
+	for (TransactionPtr pTransaction : transactions)
+	{
+		if (IsNonConflictingTransaction(pBlockDB, pTxHashSet, *pTransaction, createdOutputs, spentOutputs))
+		{
+			validTransactions.push_back(pTransaction);
+		}
+	}
+
+	return validTransactions;
+}
+
 bool ValidTransactionFinder::IsValidTransaction(
 	std::shared_ptr<const IBlockDB> pBlockDB,
 	ITxHashSetConstPtr pTxHashSet,
@@ -60,4 +95,67 @@ bool ValidTransactionFinder::IsValidTransaction(
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+bool ValidTransactionFinder::IsNonConflictingTransaction(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const Transaction& transaction,
+	std::unordered_map<Commitment, EOutputFeatures>& createdOutputs,
+	std::unordered_set<Commitment>& spentOutputs)
+{
+	try
+	{
+		// Each input must spend either an output created by an accepted tx, or an output in the current UTXO set.
+		// Either way, it must not already be spent by an accepted tx.
+		for (const TransactionInput& input : transaction.GetInputs())
+		{
+			const Commitment& commitment = input.GetCommitment();
+			if (spentOutputs.count(commitment) > 0)
+			{
+				return false;
+			}
+
+			auto iter = createdOutputs.find(commitment);
+			if (iter != createdOutputs.cend())
+			{
+				if (iter->second != input.GetFeatures())
+				{
+					return false;
+				}
+			}
+			else if (!pTxHashSet->IsValidInput(pBlockDB, input))
+			{
+				return false;
+			}
+		}
+
+		// Each output must be unique across the accepted txs and the current UTXO set.
+		for (const TransactionOutput& output : transaction.GetOutputs())
+		{
+			const Commitment& commitment = output.GetCommitment();
+			if (createdOutputs.count(commitment) > 0 || !pTxHashSet->IsUniqueOutput(pBlockDB, commitment))
+			{
+				return false;
+			}
+		}
+	}
+	catch (std::exception&)
+	{
+		return false;
+	}
+
+	// Only record the tx's inputs and outputs once it's known to be valid.
+	for (const TransactionInput& input : transaction.GetInputs())
+	{
+		createdOutputs.erase(input.GetCommitment());
+		spentOutputs.insert(input.GetCommitment());
+	}
+
+	for (const TransactionOutput& output : transaction.GetOutputs())
+	{
+		createdOutputs.insert({ output.GetCommitment(), output.GetFeatures() });
+	}
+
+	return true;
+}
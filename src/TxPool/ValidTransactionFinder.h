@@ -4,6 +4,8 @@
 #include <Core/Models/BlockHeader.h>
 #include <Database/BlockDb.h>
 #include <PMMR/TxHashSet.h>
+#include <unordered_map>
+#include <unordered_set>
 
 class ValidTransactionFinder
 {
@@ -15,10 +17,31 @@ public:
 		TransactionPtr pExtraTransaction
 	);
 
+	//
+	// Incremental alternative to FindValidTransactions for transactions that have already passed full validation,
+	// i.e. transactions already in a pool. The range proofs, signatures and kernel sums are not checked again.
+	// Instead, each transaction is only checked for conflicts with the UTXO set and with the outputs created and
+	// spent by pExtraTransaction and the transactions accepted before it.
+	//
+	static std::vector<TransactionPtr> FindNonConflictingTransactions(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const std::vector<TransactionPtr>& transactions,
+		TransactionPtr pExtraTransaction
+	);
+
 private:
 	static bool IsValidTransaction(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet,
 		TransactionPtr pTransaction
 	);
+
+	static bool IsNonConflictingTransaction(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const Transaction& transaction,
+		std::unordered_map<Commitment, EOutputFeatures>& createdOutputs,
+		std::unordered_set<Commitment>& spentOutputs
+	);
 };
\ No newline at end of file
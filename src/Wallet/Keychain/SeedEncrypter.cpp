@@ -37,8 +37,8 @@ EncryptedSeed SeedEncrypter::EncryptWalletSeed(const SecureVector& walletSeed, c
 	WALLET_INFO("Encrypting wallet seed");
 
 	CBigInteger<32> randomNumber = RandomNumberGenerator::GenerateRandom32();
-	CBigInteger<16> iv = CBigInteger<16>(&randomNumber.GetData()[0]);
-	CBigInteger<8> salt(std::vector<unsigned char>(randomNumber.GetData().cbegin() + 16, randomNumber.GetData().cbegin() + 24));
+	CBigInteger<16> iv = CBigInteger<16>(randomNumber.data());
+	CBigInteger<8> salt(randomNumber.data() + 16);
 
 	ScryptParameters parameters(32768, 8, 1);
 	SecretKey passwordHash = Crypto::PBKDF(password, salt.GetData(), parameters);
@@ -6,7 +6,7 @@
 #include <Consensus/HardForks.h>
 #include <Infrastructure/Logger.h>
 
-static const uint64_t NUM_OUTPUTS_PER_BATCH = 1000;
+static const uint64_t NUM_OUTPUTS_PER_BATCH = 10000;
 
 OutputRestorer::OutputRestorer(const Config& config, INodeClientConstPtr pNodeClient, const KeyChain& keyChain)
 	: m_config(config), m_pNodeClient(pNodeClient), m_keyChain(keyChain)
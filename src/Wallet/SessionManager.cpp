@@ -55,7 +55,7 @@ SessionToken SessionManager::Login(const std::string& username, const SecureStri
 SessionToken SessionManager::Login(const std::string& username, const SecureVector& seed)
 {
 	const CBigInteger<32> hash = Crypto::SHA256((const std::vector<unsigned char>&)seed);
-	const std::vector<unsigned char> checksum(hash.GetData().cbegin(), hash.GetData().cbegin() + 4);
+	const std::vector<unsigned char> checksum(hash.begin(), hash.begin() + 4);
 	SecureVector seedWithChecksum = SecureVector(seed.begin(), seed.end());
 	seedWithChecksum.insert(seedWithChecksum.end(), checksum.begin(), checksum.end());
 
@@ -33,7 +33,7 @@ std::pair<SecureString, SessionToken> WalletManager::InitializeNewWallet(const s
 {
 	WALLET_INFO_F("Creating new wallet with username: {}", username);
 	const SecretKey walletSeed = RandomNumberGenerator::GenerateRandom32();
-	const SecureVector walletSeedBytes(walletSeed.GetVec().begin(), walletSeed.GetVec().end());
+	const SecureVector walletSeedBytes(walletSeed.GetBytes().begin(), walletSeed.GetBytes().end());
 	const EncryptedSeed encryptedSeed = SeedEncrypter().EncryptWalletSeed(walletSeedBytes, password);
 	SecureString walletWords = Mnemonic::CreateMnemonic(walletSeed.GetVec());
 
@@ -0,0 +1,78 @@
+#include <catch.hpp>
+
+#include <BlockChain/BlockChainServer.h>
+#include <Config/Config.h>
+#include <Consensus/BlockDifficulty.h>
+#include <Consensus/HardForks.h>
+#include <Database/Database.h>
+#include <PMMR/TxHashSetManager.h>
+#include <TxPool/TransactionPool.h>
+
+//
+// Builds headers on top of pPrevious that pass every context-free rule except proof of work,
+// since their cuckoo cycles are just made up.
+//
+static std::vector<BlockHeaderPtr> BuildHeaders(const EEnvironmentType environment, BlockHeaderPtr pPrevious, const size_t numHeaders)
+{
+	std::vector<BlockHeaderPtr> headers;
+	for (size_t i = 0; i < numHeaders; i++)
+	{
+		const uint64_t height = pPrevious->GetHeight() + 1;
+
+		std::vector<uint64_t> nonces;
+		for (uint64_t j = 0; j < Consensus::PROOFSIZE; j++)
+		{
+			nonces.push_back((height * 1000) + (j * 7));
+		}
+
+		pPrevious = std::make_shared<const BlockHeader>(
+			Consensus::GetHeaderVersion(environment, height),
+			height,
+			pPrevious->GetTimestamp() + 60,
+			Hash(pPrevious->GetHash()),
+			Hash(),
+			Hash(),
+			Hash(),
+			Hash(),
+			BlindingFactor(Hash()),
+			0,
+			0,
+			pPrevious->GetTotalDifficulty() + 1,
+			1,
+			height,
+			ProofOfWork(Consensus::SECOND_POW_EDGE_BITS, std::move(nonces))
+		);
+		headers.push_back(pPrevious);
+	}
+
+	return headers;
+}
+
+TEST_CASE("BlockHeaderProcessor - A synced batch with an invalid proof of work is rejected")
+{
+	const fs::path dataPath = fs::temp_directory_path() / "Test_BlockHeaderProcessor" / "";
+	fs::remove_all(dataPath);
+
+	Json::Value json;
+	json[ConfigProps::DATA_PATH] = dataPath.u8string();
+	ConfigPtr pConfig = Config::Load(json, EEnvironmentType::FLOONET);
+
+	auto pDatabase = DatabaseAPI::OpenDatabase(*pConfig);
+	TxHashSetManagerPtr pTxHashSetManager = std::make_shared<TxHashSetManager>(*pConfig);
+	auto pTransactionPool = TxPoolAPI::CreateTransactionPool(*pConfig, pTxHashSetManager);
+	IBlockChainServerPtr pBlockChain = BlockChainAPI::StartBlockChainServer(*pConfig, pDatabase->GetBlockDB(), pTxHashSetManager, pTransactionPool);
+
+	// Spans several validation tasks, so the headers are checked on more than one of the pool's threads.
+	BlockHeaderPtr pGenesis = pBlockChain->GetTipBlockHeader(EChainType::CANDIDATE);
+	const std::vector<BlockHeaderPtr> headers = BuildHeaders(EEnvironmentType::FLOONET, pGenesis, 40);
+
+	REQUIRE(pBlockChain->AddBlockHeaders(headers) == EBlockChainStatus::INVALID);
+
+	// None of the headers were stored, or added to either chain.
+	REQUIRE(pBlockChain->GetHeight(EChainType::SYNC) == 0);
+	REQUIRE(pBlockChain->GetHeight(EChainType::CANDIDATE) == 0);
+	for (const BlockHeaderPtr& pHeader : headers)
+	{
+		REQUIRE(pBlockChain->GetBlockHeaderByHash(pHeader->GetHash()) == nullptr);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <catch.hpp>
+
+#include "../../src/PoW/DifficultyWindow.h"
+
+#include <Consensus/BlockDifficulty.h>
+#include <Consensus/BlockTime.h>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+//
+// An IBlockDB that only stores headers, and counts how many times they're looked up.
+//
+class HeaderDB : public IBlockDB
+{
+public:
+	HeaderDB() : m_numLookups(0) { }
+
+	void Commit() override final { }
+	void Rollback() override final { }
+
+	size_t GetNumLookups() const { return m_numLookups; }
+
+	BlockHeaderPtr GetBlockHeader(const Hash& hash) const override final
+	{
+		++m_numLookups;
+		auto iter = m_headers.find(hash);
+		return iter != m_headers.end() ? iter->second : nullptr;
+	}
+
+	void AddBlockHeader(BlockHeaderPtr pBlockHeader) override final { m_headers[pBlockHeader->GetHash()] = pBlockHeader; }
+	void AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) override final
+	{
+		for (const BlockHeaderPtr& pBlockHeader : blockHeaders)
+		{
+			AddBlockHeader(pBlockHeader);
+		}
+	}
+
+	void AddBlock(const FullBlock&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<FullBlock> GetBlock(const Hash&) const override final { return nullptr; }
+	void AddBlockSums(const Hash&, const BlockSums&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<BlockSums> GetBlockSums(const Hash&) const override final { return nullptr; }
+	void AddOutputPosition(const Commitment&, const OutputLocation&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment&) const override final { return nullptr; }
+	void AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>&) override final { throw std::logic_error("Not supported"); }
+	std::vector<std::unique_ptr<OutputLocation>> GetOutputPositions(const std::vector<Commitment>&) const override final { throw std::logic_error("Not supported"); }
+	void AddBlockInputBitmap(const Hash&, const Roaring&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<Roaring> GetBlockInputBitmap(const Hash&) const override final { return nullptr; }
+
+private:
+	std::unordered_map<Hash, BlockHeaderPtr> m_headers;
+	mutable size_t m_numLookups;
+};
+
+//
+// Builds headers with unique hashes and varying timestamps, difficulties and PoW types, and stores them in the HeaderDB.
+//
+class ChainBuilder
+{
+public:
+	ChainBuilder(HeaderDB& blockDB) : m_blockDB(blockDB), m_nextId(1) { }
+
+	BlockHeaderPtr Genesis()
+	{
+		return AddHeader(0, Hash(), 1500000000, Consensus::INITIAL_DIFFICULTY);
+	}
+
+	// Adds numHeaders headers on top of pPrevious, and returns all of them, earliest first.
+	std::vector<BlockHeaderPtr> Extend(BlockHeaderPtr pPrevious, const size_t numHeaders)
+	{
+		std::vector<BlockHeaderPtr> headers;
+		for (size_t i = 0; i < numHeaders; i++)
+		{
+			const uint64_t id = m_nextId;
+			pPrevious = AddHeader(
+				pPrevious->GetHeight() + 1,
+				pPrevious->GetHash(),
+				pPrevious->GetTimestamp() + 30 + (int64_t)(id * 7 % 60),
+				pPrevious->GetTotalDifficulty() + 1000 + (id * 13 % 500)
+			);
+			headers.push_back(pPrevious);
+		}
+
+		return headers;
+	}
+
+private:
+	// Spreads the id's bytes out, so they're all used by std::hash<Hash>.
+	static Hash ToHash(const uint64_t id)
+	{
+		Hash hash;
+		for (size_t i = 0; i < 8; i++)
+		{
+			hash[i * 4] = (unsigned char)(id >> (i * 8));
+		}
+
+		return hash;
+	}
+
+	BlockHeaderPtr AddHeader(const uint64_t height, const Hash& previousHash, const int64_t timestamp, const uint64_t totalDifficulty)
+	{
+		const uint64_t id = m_nextId++;
+		const uint8_t edgeBits = id % 3 == 0 ? 31 : Consensus::SECOND_POW_EDGE_BITS;
+
+		auto pHeader = std::make_shared<const BlockHeader>(
+			1,
+			height,
+			timestamp,
+			Hash(previousHash),
+			Hash(),
+			Hash(),
+			Hash(),
+			Hash(),
+			BlindingFactor(Hash()),
+			0,
+			0,
+			totalDifficulty,
+			(uint32_t)(1800 + id % 100),
+			id,
+			ProofOfWork(edgeBits, std::vector<uint64_t>(), ToHash(id))
+		);
+
+		m_blockDB.AddBlockHeader(pHeader);
+		return pHeader;
+	}
+
+	HeaderDB& m_blockDB;
+	uint64_t m_nextId;
+};
+
+//
+// Loads the difficulty data for the header after previousHeader straight from the DB, walking back one header at a time.
+// This is how the difficulty data was loaded before DifficultyWindow, so the window must always return the same data.
+//
+static std::vector<HeaderInfo> LoadFromDB(const IBlockDB& blockDB, const BlockHeader& previousHeader)
+{
+	const size_t numBlocksNeeded = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
+	std::vector<HeaderInfo> difficultyData;
+
+	BlockHeaderPtr pHeader = blockDB.GetBlockHeader(previousHeader.GetHash());
+	while (difficultyData.size() < numBlocksNeeded && pHeader != nullptr)
+	{
+		BlockHeaderPtr pPrevious = blockDB.GetBlockHeader(pHeader->GetPreviousBlockHash());
+		const uint64_t difficulty = pHeader->GetTotalDifficulty() - (pPrevious != nullptr ? pPrevious->GetTotalDifficulty() : 0);
+
+		difficultyData.emplace_back(HeaderInfo(pHeader->GetTimestamp(), difficulty, pHeader->GetScalingDifficulty(), pHeader->GetProofOfWork().IsSecondary()));
+		pHeader = pPrevious;
+	}
+
+	if (difficultyData.size() < numBlocksNeeded)
+	{
+		const uint64_t lastTimestampDelta = difficultyData.size() > 1 ? difficultyData[0].GetTimestamp() - difficultyData[1].GetTimestamp() : Consensus::BLOCK_TIME_SEC;
+		const uint64_t lastDifficulty = difficultyData[0].GetDifficulty();
+
+		uint64_t lastTimestamp = difficultyData.back().GetTimestamp();
+		while (difficultyData.size() < numBlocksNeeded)
+		{
+			lastTimestamp -= (std::min)(lastTimestamp, lastTimestampDelta);
+			difficultyData.emplace_back(HeaderInfo::FromTimeAndDiff(lastTimestamp, lastDifficulty));
+		}
+	}
+
+	std::reverse(difficultyData.begin(), difficultyData.end());
+	return difficultyData;
+}
+
+static void RequireSameData(const std::vector<HeaderInfo>& actual, const std::vector<HeaderInfo>& expected)
+{
+	REQUIRE(actual.size() == expected.size());
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		if (actual[i].GetTimestamp() != expected[i].GetTimestamp()
+			|| actual[i].GetDifficulty() != expected[i].GetDifficulty()
+			|| actual[i].GetSecondaryScaling() != expected[i].GetSecondaryScaling()
+			|| actual[i].IsSecondary() != expected[i].IsSecondary())
+		{
+			FAIL("HeaderInfo " << i << " differs");
+		}
+	}
+}
+
+//
+// Validates each header in turn, the way header sync does, checking the window against the DB at every step.
+// Returns the number of headers for which the window had to read from the DB.
+//
+static size_t ValidateHeaders(const HeaderDB& blockDB, const std::vector<BlockHeaderPtr>& headers)
+{
+	size_t numRebuilds = 0;
+	for (const BlockHeaderPtr& pHeader : headers)
+	{
+		const size_t numLookups = blockDB.GetNumLookups();
+		const std::vector<HeaderInfo> difficultyData = DifficultyWindow::GetInstance().GetDifficultyData(blockDB, *pHeader);
+		if (blockDB.GetNumLookups() != numLookups)
+		{
+			++numRebuilds;
+		}
+
+		RequireSameData(difficultyData, LoadFromDB(blockDB, *pHeader));
+	}
+
+	return numRebuilds;
+}
+
+TEST_CASE("DifficultyWindow - Matches DB across extend, reorg and rebuild")
+{
+	const size_t windowSize = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
+
+	HeaderDB blockDB;
+	ChainBuilder builder(blockDB);
+
+	// Extend from genesis, including the padded heights before the window is full.
+	// Only the first header, for which the window is still empty, needs the DB.
+	BlockHeaderPtr pGenesis = builder.Genesis();
+	std::vector<BlockHeaderPtr> chainA = builder.Extend(pGenesis, windowSize * 2 + 10);
+	REQUIRE(ValidateHeaders(blockDB, { pGenesis }) == 1);
+	REQUIRE(ValidateHeaders(blockDB, chainA) == 0);
+
+	// Asking again for the tip doesn't change anything.
+	REQUIRE(ValidateHeaders(blockDB, { chainA.back(), chainA.back() }) == 0);
+
+	// Reorg to a fork whose base is still in the window, so the window is rewound rather than rebuilt.
+	BlockHeaderPtr pShallowForkBase = chainA[chainA.size() - 10];
+	std::vector<BlockHeaderPtr> chainB = builder.Extend(pShallowForkBase, 20);
+	REQUIRE(ValidateHeaders(blockDB, { pShallowForkBase }) == 0);
+	REQUIRE(ValidateHeaders(blockDB, chainB) == 0);
+
+	// Reorg back to chain A, whose tip has since been rewound out of the window, so the window is rebuilt once.
+	std::vector<BlockHeaderPtr> chainC = builder.Extend(chainA.back(), 5);
+	REQUIRE(ValidateHeaders(blockDB, chainC) == 1);
+
+	// Reorg to a fork that's far below the window, and close enough to genesis that the window isn't full.
+	std::vector<BlockHeaderPtr> chainD = builder.Extend(chainA[windowSize / 2], windowSize);
+	REQUIRE(ValidateHeaders(blockDB, chainD) == 1);
+
+	// Alternate between two forks, like headers from two peers arriving interleaved.
+	std::vector<BlockHeaderPtr> chainE = builder.Extend(chainD.back(), 10);
+	std::vector<BlockHeaderPtr> chainF = builder.Extend(chainD.back(), 10);
+	for (size_t i = 0; i < chainE.size(); i++)
+	{
+		ValidateHeaders(blockDB, { chainE[i], chainF[i] });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <catch.hpp>
+
+#include <Core/Models/DTOs/OutputRange.h>
+#include <Core/Exceptions/DeserializationException.h>
+
+static OutputDTO CreateOutput(const unsigned char seed, const bool spent)
+{
+	return OutputDTO(
+		spent,
+		OutputIdentifier(EOutputFeatures::DEFAULT_OUTPUT, Commitment(CBigInteger<33>(std::vector<unsigned char>(33, seed)))),
+		OutputLocation(seed * 2, seed * 3),
+		RangeProof(std::vector<unsigned char>(675, seed))
+	);
+}
+
+TEST_CASE("OutputRange - Serialize and Deserialize")
+{
+	std::vector<OutputDTO> outputs;
+	for (unsigned char i = 1; i <= 10; i++)
+	{
+		outputs.push_back(CreateOutput(i, i % 2 == 0));
+	}
+
+	const OutputRange range(100, 18, std::move(outputs));
+
+	Serializer serializer;
+	range.Serialize(serializer);
+
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	const OutputRange deserialized = OutputRange::Deserialize(byteBuffer);
+	REQUIRE(byteBuffer.GetRemainingSize() == 0);
+
+	REQUIRE(deserialized.GetHighestIndex() == 100);
+	REQUIRE(deserialized.GetLastRetrievedIndex() == 18);
+	REQUIRE(deserialized.GetOutputs().size() == range.GetOutputs().size());
+	for (size_t i = 0; i < range.GetOutputs().size(); i++)
+	{
+		const OutputDTO& expected = range.GetOutputs()[i];
+		const OutputDTO& actual = deserialized.GetOutputs()[i];
+		REQUIRE(actual.IsSpent() == expected.IsSpent());
+		REQUIRE(actual.GetIdentifier().GetFeatures() == expected.GetIdentifier().GetFeatures());
+		REQUIRE(actual.GetIdentifier().GetCommitment() == expected.GetIdentifier().GetCommitment());
+		REQUIRE(actual.GetLocation().GetMMRIndex() == expected.GetLocation().GetMMRIndex());
+		REQUIRE(actual.GetLocation().GetBlockHeight() == expected.GetLocation().GetBlockHeight());
+		REQUIRE(actual.GetRangeProof().GetProofBytes() == expected.GetRangeProof().GetProofBytes());
+	}
+
+	// A corrupt output count shouldn't be trusted to reserve memory.
+	Serializer corrupt;
+	corrupt.Append<uint64_t>(100);
+	corrupt.Append<uint64_t>(18);
+	corrupt.Append<uint64_t>(UINT64_MAX);
+
+	ByteBuffer corruptBuffer(corrupt.GetBytes());
+	REQUIRE_THROWS_AS(OutputRange::Deserialize(corruptBuffer), DeserializationException);
+}
@@ -0,0 +1,105 @@
+#include <catch.hpp>
+
+#include <Core/AppendOnlyFile.h>
+#include <Common/Util/FileUtil.h>
+
+// Reads the file as 1-byte records, since a read can't straddle the position a batch rewound to.
+static std::vector<unsigned char> ReadAll(const AppendOnlyFile& file)
+{
+	std::vector<unsigned char> bytes(file.GetSize());
+	for (uint64_t i = 0; i < file.GetSize(); i++)
+	{
+		const unsigned char* pData = file.Read(i, 1);
+		if (pData == nullptr)
+		{
+			FAIL("Failed to read byte " << i);
+		}
+
+		bytes[i] = *pData;
+	}
+
+	return bytes;
+}
+
+//
+// Copies the file and its size file as they are on disk right now (including any unsynced writes to the mapping),
+// and loads the copy, which is what would be loaded if the process died at this point.
+//
+static std::vector<unsigned char> LoadAfterCrash(const fs::path& path)
+{
+	const fs::path crashPath = fs::temp_directory_path() / "Test_AppendOnlyFile_crash.bin";
+	fs::copy_file(path, crashPath, fs::copy_options::overwrite_existing);
+	fs::copy_file(path.u8string() + ".size", crashPath.u8string() + ".size", fs::copy_options::overwrite_existing);
+
+	AppendOnlyFile file(crashPath.u8string());
+	file.Load();
+	return ReadAll(file);
+}
+
+TEST_CASE("AppendOnlyFile - Append, Rewind, Discard and Flush")
+{
+	const fs::path path = fs::temp_directory_path() / "Test_AppendOnlyFile.bin";
+	fs::remove(path);
+	fs::remove(path.u8string() + ".size");
+
+	std::vector<unsigned char> committed;
+	{
+		AppendOnlyFile file(path.u8string());
+		file.Load();
+		REQUIRE(file.GetSize() == 0);
+
+		std::vector<unsigned char> data(1000);
+		for (size_t i = 0; i < data.size(); i++)
+		{
+			data[i] = (unsigned char)i;
+		}
+
+		file.Append(data);
+		REQUIRE(file.Flush());
+		committed = data;
+		REQUIRE(ReadAll(file) == committed);
+		REQUIRE(file.Read(990, 11) == nullptr);
+
+		// Rewinding into committed data and appending over it can still be discarded.
+		REQUIRE(file.Rewind(500));
+		file.Append(std::vector<unsigned char>(700, 0xAB));
+		REQUIRE(file.Rewind(100));
+		file.Append(std::vector<unsigned char>(10, 0xCD));
+		REQUIRE(file.GetSize() == 110);
+
+		std::vector<unsigned char> expected(committed.cbegin(), committed.cbegin() + 100);
+		expected.resize(110, 0xCD);
+		REQUIRE(ReadAll(file) == expected);
+		REQUIRE(file.Read(95, 10) == nullptr);
+
+		// Committed data isn't touched until the batch is flushed.
+		REQUIRE(LoadAfterCrash(path) == committed);
+
+		REQUIRE(file.Discard());
+		REQUIRE(ReadAll(file) == committed);
+
+		// Grow past the first extent.
+		REQUIRE(file.Rewind(600));
+		file.Append(std::vector<unsigned char>(9 * 1024 * 1024, 0xEF));
+		REQUIRE(file.Flush());
+		committed.resize(600);
+		committed.resize(600 + (9 * 1024 * 1024), 0xEF);
+		REQUIRE(ReadAll(file) == committed);
+
+		// Uncommitted appends are lost if the process dies, so only the persisted logical size matters.
+		file.Append(std::vector<unsigned char>(50, 0x01));
+		REQUIRE(LoadAfterCrash(path) == committed);
+
+		// Uncommitted changes are discarded when the file is closed.
+		REQUIRE(file.Rewind(300));
+		file.Append(std::vector<unsigned char>(20, 0x02));
+	}
+
+	// Closing the file trims it to its logical size.
+	REQUIRE(FileUtil::GetFileSize(path.u8string()) == committed.size());
+	REQUIRE(!fs::exists(path.u8string() + ".size"));
+
+	AppendOnlyFile file(path.u8string());
+	file.Load();
+	REQUIRE(ReadAll(file) == committed);
+}
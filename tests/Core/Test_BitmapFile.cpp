@@ -0,0 +1,89 @@
+#include <catch.hpp>
+
+#include <Core/BitmapFile.h>
+#include <Common/Util/FileUtil.h>
+#include <random>
+
+static void RequireMatches(const BitmapFile& bitmap, const std::vector<bool>& expected)
+{
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		REQUIRE(bitmap.IsSet(i) == expected[i]);
+	}
+
+	Roaring expectedRoaring;
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		if (expected[i])
+		{
+			expectedRoaring.add((uint32_t)i + 1);
+		}
+	}
+
+	REQUIRE(bitmap.ToRoaring() == expectedRoaring);
+}
+
+TEST_CASE("BitmapFile - Set, Unset, Rewind, Commit and Rollback across pages")
+{
+	const fs::path path = fs::temp_directory_path() / "Test_BitmapFile.bin";
+	fs::remove(path);
+
+	std::shared_ptr<BitmapFile> pBitmap = BitmapFile::Load(path.u8string());
+
+	// 3 pages of 4096 bytes, plus a partial page.
+	const size_t numBits = (3 * 4096 * 8) + 1000;
+	std::vector<bool> committed(numBits, false);
+	std::vector<bool> expected(numBits, false);
+
+	std::mt19937_64 rng(42);
+	for (size_t round = 0; round < 8; round++)
+	{
+		for (size_t i = 0; i < 2000; i++)
+		{
+			const size_t position = rng() % numBits;
+			if (rng() % 3 == 0)
+			{
+				pBitmap->Unset(position);
+				expected[position] = false;
+			}
+			else
+			{
+				pBitmap->Set(position);
+				expected[position] = true;
+			}
+		}
+
+		if (round % 3 == 1)
+		{
+			const size_t size = rng() % numBits;
+			Roaring positionsToAdd;
+			positionsToAdd.add((uint32_t)(rng() % numBits) + 1);
+
+			// Positions are added before truncating, so only those below size remain set.
+			pBitmap->Rewind(size, positionsToAdd);
+			for (auto iter = positionsToAdd.begin(); iter != positionsToAdd.end(); iter++)
+			{
+				expected[iter.i.current_value - 1] = true;
+			}
+			std::fill(expected.begin() + size, expected.end(), false);
+		}
+
+		RequireMatches(*pBitmap, expected);
+
+		if (round % 4 == 3)
+		{
+			pBitmap->Rollback();
+			expected = committed;
+		}
+		else
+		{
+			pBitmap->Commit();
+			committed = expected;
+		}
+
+		RequireMatches(*pBitmap, expected);
+	}
+
+	pBitmap.reset();
+	RequireMatches(*BitmapFile::Load(path.u8string()), committed);
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+
+#include <Common/ShardedLRUCache.h>
+#include <string>
+
+TEST_CASE("ShardedLRUCache - Get and Put")
+{
+	ShardedLRUCache<uint64_t, std::string> cache(64);
+
+	std::string value;
+	REQUIRE_FALSE(cache.Get(1, value));
+
+	cache.Put(1, "one");
+	cache.Put(2, "two");
+	REQUIRE(cache.Get(1, value));
+	REQUIRE(value == "one");
+	REQUIRE(cache.Contains(2));
+
+	cache.Put(1, "uno");
+	REQUIRE(cache.Get(1, value));
+	REQUIRE(value == "uno");
+	REQUIRE(cache.GetSize() == 2);
+
+	cache.Erase(1);
+	REQUIRE_FALSE(cache.Contains(1));
+
+	REQUIRE(cache.GetHits() == 3);
+	REQUIRE(cache.GetMisses() == 2);
+}
+
+TEST_CASE("ShardedLRUCache - Evicts least recently used")
+{
+	// Single shard, so eviction order is deterministic.
+	ShardedLRUCache<uint64_t, uint64_t, std::hash<uint64_t>, 1> cache(3);
+
+	cache.Put(1, 1);
+	cache.Put(2, 2);
+	cache.Put(3, 3);
+	REQUIRE(cache.Contains(1));
+
+	cache.Put(4, 4);
+	REQUIRE(cache.GetSize() == 3);
+	REQUIRE_FALSE(cache.Contains(2));
+	REQUIRE(cache.Contains(1));
+	REQUIRE(cache.Contains(3));
+	REQUIRE(cache.Contains(4));
+
+	cache.SetCapacity(1);
+	REQUIRE(cache.GetSize() == 1);
+	REQUIRE(cache.Contains(4));
+
+	cache.SetCapacity(0);
+	cache.Put(5, 5);
+	REQUIRE(cache.GetSize() == 0);
+}
+
+TEST_CASE("ShardedLRUCache - Bounded by charge")
+{
+	struct StringSizer
+	{
+		size_t operator()(const uint64_t&, const std::string& value) const { return value.size(); }
+	};
+
+	ShardedLRUCache<uint64_t, std::string, std::hash<uint64_t>, 1, StringSizer> cache(10);
+
+	cache.Put(1, "aaaa");
+	cache.Put(2, "bbbb");
+	REQUIRE(cache.GetCharge() == 8);
+
+	// Evicts 1, the least recently used, to make room.
+	cache.Put(3, "ccc");
+	REQUIRE_FALSE(cache.Contains(1));
+	REQUIRE(cache.Contains(2));
+	REQUIRE(cache.GetCharge() == 7);
+
+	// Replacing a value updates its charge.
+	cache.Put(2, "b");
+	REQUIRE(cache.GetCharge() == 4);
+
+	// Too big to ever fit, so it isn't cached, and nothing is evicted for it.
+	cache.Put(4, "dddddddddddd");
+	REQUIRE_FALSE(cache.Contains(4));
+	REQUIRE(cache.GetSize() == 2);
+
+	cache.Erase(3);
+	REQUIRE(cache.GetCharge() == 1);
+}
\ No newline at end of file
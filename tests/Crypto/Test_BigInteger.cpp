@@ -0,0 +1,34 @@
+#include <catch.hpp>
+
+#include <Crypto/BigInteger.h>
+#include <Common/Secure.h>
+
+TEST_CASE("CBigInteger - Inline storage")
+{
+	const CBigInteger<32> zero;
+	REQUIRE(zero == CBigInteger<32>::ValueOf(0));
+	REQUIRE(sizeof(CBigInteger<32>) <= 32 + sizeof(void*));
+
+	const CBigInteger<4> value = CBigInteger<4>::FromHex("0x01020304");
+	REQUIRE(value.ToHex() == "01020304");
+	REQUIRE(value.GetData() == std::vector<unsigned char>({ 1, 2, 3, 4 }));
+	REQUIRE(CBigInteger<4>(value.data()) == value);
+	REQUIRE(CBigInteger<4>(std::vector<unsigned char>({ 1, 2, 3, 4 })) == value);
+	REQUIRE_THROWS(CBigInteger<4>(std::vector<unsigned char>({ 1, 2, 3 })));
+
+	REQUIRE(CBigInteger<4>::FromHex("01020305") > value);
+	REQUIRE(CBigInteger<4>::FromHex("00ffffff") < value);
+	REQUIRE(CBigInteger<4>::GetMaximumValue().ToHex() == "ffffffff");
+	REQUIRE((value ^ value) == CBigInteger<4>::ValueOf(0));
+}
+
+TEST_CASE("CBigInteger - Allocator storage")
+{
+	typedef CBigInteger<4, secure_allocator<unsigned char>> SecureInteger;
+
+	const SecureInteger value = SecureInteger::FromHex("0x01020304");
+	REQUIRE(value.ToHex() == "01020304");
+	REQUIRE(value[3] == 4);
+	REQUIRE(SecureInteger(value.data()) == value);
+	REQUIRE(SecureInteger::ValueOf(5) < value);
+}
@@ -0,0 +1,93 @@
+#include <catch.hpp>
+
+#include <Crypto/Crypto.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <future>
+#include <vector>
+
+static std::vector<std::pair<Commitment, RangeProof>> GenerateRangeProofs(const size_t numProofs)
+{
+	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
+	rangeProofs.reserve(numProofs);
+
+	for (size_t i = 0; i < numProofs; i++)
+	{
+		const uint64_t amount = 1000 + i;
+		const SecretKey blindingFactor = RandomNumberGenerator::GenerateRandom32();
+		const SecretKey nonce = RandomNumberGenerator::GenerateRandom32();
+		const ProofMessage proofMessage(CBigInteger<20>::ValueOf(0));
+
+		Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blindingFactor.GetBytes()));
+		RangeProof rangeProof = Crypto::GenerateRangeProof(amount, blindingFactor, nonce, nonce, proofMessage);
+		rangeProofs.emplace_back(std::make_pair(std::move(commitment), std::move(rangeProof)));
+	}
+
+	return rangeProofs;
+}
+
+TEST_CASE("Bulletproofs - Concurrent prove and verify")
+{
+	const size_t numThreads = 4;
+
+	std::vector<std::vector<std::pair<Commitment, RangeProof>>> rangeProofsByThread(numThreads);
+
+	// Each thread writes only its own element of rangeProofsByThread, and hands its result back through a future.
+	std::vector<std::future<bool>> results;
+	for (size_t i = 0; i < numThreads; i++)
+	{
+		results.emplace_back(std::async(std::launch::async, [&rangeProofsByThread, i]() {
+			rangeProofsByThread[i] = GenerateRangeProofs(4);
+			return Crypto::VerifyRangeProofs(rangeProofsByThread[i]);
+		}));
+	}
+
+	for (std::future<bool>& result : results)
+	{
+		REQUIRE(result.get());
+	}
+
+	// A proof must not verify against a different commitment.
+	std::vector<std::pair<Commitment, RangeProof>> mismatched({
+		std::make_pair(rangeProofsByThread[0][0].first, rangeProofsByThread[1][0].second)
+	});
+	REQUIRE_FALSE(Crypto::VerifyRangeProofs(mismatched));
+}
+
+// Hidden by default, since generating the proofs takes a while. Run with: Crypto_Tests [benchmark]
+TEST_CASE("Bulletproofs - Verify throughput", "[.][benchmark]")
+{
+	const std::vector<std::pair<Commitment, RangeProof>> rangeProofs = GenerateRangeProofs(1000);
+
+	for (const size_t batchSize : { 1, 16, 256, 1000 })
+	{
+		const std::vector<std::pair<Commitment, RangeProof>> batch(rangeProofs.cbegin(), rangeProofs.cbegin() + batchSize);
+
+		BENCHMARK("VerifyRangeProofs - batch size " + std::to_string(batchSize))
+		{
+			REQUIRE(Crypto::VerifyRangeProofs(batch));
+		}
+	}
+
+	// Same total work as the largest batch, split across threads using separate pooled contexts.
+	const size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+	BENCHMARK("VerifyRangeProofs - 1000 proofs, batches of 16 across " + std::to_string(numThreads) + " threads")
+	{
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < numThreads; t++)
+		{
+			threads.emplace_back(std::thread([&rangeProofs, numThreads, t]() {
+				for (size_t first = t * 16; first < rangeProofs.size(); first += numThreads * 16)
+				{
+					const size_t last = std::min(first + 16, rangeProofs.size());
+					const std::vector<std::pair<Commitment, RangeProof>> batch(rangeProofs.cbegin() + first, rangeProofs.cbegin() + last);
+					Crypto::VerifyRangeProofs(batch);
+				}
+			}));
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+}
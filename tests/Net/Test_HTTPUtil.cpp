@@ -0,0 +1,19 @@
+#include <catch.hpp>
+
+#include <Net/Util/HTTPUtil.h>
+
+TEST_CASE("HTTPUtil - AcceptsEncoding")
+{
+	REQUIRE(HTTPUtil::AcceptsEncoding("deflate", "deflate"));
+	REQUIRE(HTTPUtil::AcceptsEncoding("gzip, deflate, br", "deflate"));
+	REQUIRE(HTTPUtil::AcceptsEncoding("gzip;q=1.0, Deflate;q=0.5", "deflate"));
+	REQUIRE(HTTPUtil::AcceptsEncoding("gzip, *", "deflate"));
+
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("", "deflate"));
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("gzip, br", "deflate"));
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("deflate;q=0", "deflate"));
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("gzip, deflate ; q=0.000", "deflate"));
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("gzip, *;q=0", "deflate"));
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("*, deflate;q=0", "deflate"));
+	REQUIRE_FALSE(HTTPUtil::AcceptsEncoding("x-deflate", "deflate"));
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include <catch.hpp>
+
+#include "../../src/P2P/Sync/BlockScheduler.h"
+
+#include <algorithm>
+#include <set>
+
+//
+// Drives a BlockScheduler with a fake clock, so requests can be timed out without waiting.
+// Like the BlockSyncer, blocks that were received are no longer passed to Schedule as needed.
+//
+class TestScheduler
+{
+public:
+	TestScheduler()
+		: m_now(std::chrono::steady_clock::now()),
+		m_scheduler([this]() { return m_now; })
+	{
+
+	}
+
+	void Advance(const std::chrono::milliseconds& duration) { m_now += duration; }
+
+	std::vector<BlockScheduler::Assignment> Schedule(const std::vector<PeerPtr>& peers, const uint64_t fromHeight, const uint64_t toHeight)
+	{
+		std::vector<std::pair<uint64_t, Hash>> blocksNeeded;
+		for (uint64_t height = fromHeight; height <= toHeight; height++)
+		{
+			if (m_received.count(height) == 0)
+			{
+				blocksNeeded.push_back({ height, GetHash(height) });
+			}
+		}
+
+		return m_scheduler.Schedule(peers, blocksNeeded, [](const Hash&) { return false; });
+	}
+
+	void Receive(const BlockScheduler::Assignment& assignment)
+	{
+		m_scheduler.OnBlockReceived(assignment.pPeer, assignment.height, assignment.hash);
+		m_received.insert(assignment.height);
+	}
+
+	void Receive(const std::vector<BlockScheduler::Assignment>& assignments)
+	{
+		for (const BlockScheduler::Assignment& assignment : assignments)
+		{
+			Receive(assignment);
+		}
+	}
+
+	static Hash GetHash(const uint64_t height) { return Hash::ValueOf((unsigned char)height); }
+
+	BlockScheduler& Get() { return m_scheduler; }
+
+private:
+	BlockScheduler::TimePoint m_now;
+	BlockScheduler m_scheduler;
+	std::set<uint64_t> m_received;
+};
+
+static PeerPtr CreatePeer(const uint8_t lastByte)
+{
+	return std::make_shared<Peer>(IPAddress::FromIP(10, 0, 0, lastByte));
+}
+
+static std::vector<BlockScheduler::Assignment> FilterByPeer(const std::vector<BlockScheduler::Assignment>& assignments, const PeerPtr& pPeer)
+{
+	std::vector<BlockScheduler::Assignment> filtered;
+	std::copy_if(
+		assignments.cbegin(),
+		assignments.cend(),
+		std::back_inserter(filtered),
+		[&pPeer](const BlockScheduler::Assignment& assignment) { return assignment.pPeer == pPeer; }
+	);
+	return filtered;
+}
+
+static std::set<uint64_t> GetHeights(const std::vector<BlockScheduler::Assignment>& assignments)
+{
+	std::set<uint64_t> heights;
+	for (const BlockScheduler::Assignment& assignment : assignments)
+	{
+		heights.insert(assignment.height);
+	}
+
+	return heights;
+}
+
+static BlockDownloadPeerStats GetPeerStats(BlockScheduler& scheduler, const PeerPtr& pPeer)
+{
+	const BlockDownloadStats stats = scheduler.GetStats();
+	auto iter = std::find_if(
+		stats.peers.cbegin(),
+		stats.peers.cend(),
+		[&pPeer](const BlockDownloadPeerStats& peerStats) { return peerStats.address == pPeer->GetIPAddress(); }
+	);
+	REQUIRE(iter != stats.peers.cend());
+	return *iter;
+}
+
+TEST_CASE("BlockScheduler - Assigns the lowest blocks to fill each peer's window")
+{
+	TestScheduler scheduler;
+	const std::vector<PeerPtr> peers({ CreatePeer(1), CreatePeer(2) });
+
+	REQUIRE(scheduler.Get().GetLookahead(peers.size()) == 16);
+
+	const std::vector<BlockScheduler::Assignment> assignments = scheduler.Schedule(peers, 1, 100);
+	REQUIRE(assignments.size() == 16);
+	REQUIRE(FilterByPeer(assignments, peers[0]).size() == 8);
+	REQUIRE(FilterByPeer(assignments, peers[1]).size() == 8);
+
+	const std::set<uint64_t> heights = GetHeights(assignments);
+	REQUIRE(heights.size() == 16);
+	REQUIRE(*heights.begin() == 1);
+	REQUIRE(*heights.rbegin() == 16);
+	for (const BlockScheduler::Assignment& assignment : assignments)
+	{
+		REQUIRE(assignment.hash == TestScheduler::GetHash(assignment.height));
+	}
+
+	// The windows are full, so nothing more is assigned until blocks arrive.
+	REQUIRE(scheduler.Schedule(peers, 1, 100).empty());
+	REQUIRE(scheduler.Get().GetStats().numInFlight == 16);
+
+	// A failed request is assigned again.
+	scheduler.Get().OnRequestFailed(assignments.front());
+	const std::vector<BlockScheduler::Assignment> retried = scheduler.Schedule(peers, 1, 100);
+	REQUIRE(retried.size() == 1);
+	REQUIRE(retried.front().height == assignments.front().height);
+
+	// Blocks already being processed aren't requested.
+	std::vector<std::pair<uint64_t, Hash>> blocksNeeded({ { 17, TestScheduler::GetHash(17) } });
+	REQUIRE(scheduler.Get().Schedule(peers, blocksNeeded, [](const Hash&) { return true; }).empty());
+}
+
+TEST_CASE("BlockScheduler - Fast deliveries grow a peer's window")
+{
+	TestScheduler scheduler;
+	const PeerPtr pFastPeer = CreatePeer(1);
+	const PeerPtr pSlowPeer = CreatePeer(2);
+	const std::vector<PeerPtr> peers({ pFastPeer, pSlowPeer });
+
+	const std::vector<BlockScheduler::Assignment> assignments = scheduler.Schedule(peers, 1, 100);
+
+	scheduler.Advance(std::chrono::milliseconds(100));
+	scheduler.Receive(FilterByPeer(assignments, pFastPeer));
+
+	// Each block within the target latency grows the window by 1, so the fast peer now has room for 16.
+	REQUIRE(GetPeerStats(scheduler.Get(), pFastPeer).window == 16);
+	REQUIRE(GetPeerStats(scheduler.Get(), pFastPeer).latencyMs == 100);
+
+	const std::vector<BlockScheduler::Assignment> next = scheduler.Schedule(peers, 1, 100);
+	REQUIRE(next.size() == 16);
+	REQUIRE(FilterByPeer(next, pFastPeer).size() == 16);
+
+	const std::set<uint64_t> heights = GetHeights(next);
+	REQUIRE(*heights.begin() == 17);
+	REQUIRE(*heights.rbegin() == 32);
+}
+
+TEST_CASE("BlockScheduler - Timed out requests halve the window and are reassigned")
+{
+	TestScheduler scheduler;
+	const PeerPtr pPeer = CreatePeer(1);
+
+	const std::vector<BlockScheduler::Assignment> assignments = scheduler.Schedule({ pPeer }, 1, 2);
+	REQUIRE(assignments.size() == 2);
+
+	// Past the maximum timeout. The window is halved once, however many of its requests timed out.
+	scheduler.Advance(std::chrono::seconds(21));
+	const std::vector<BlockScheduler::Assignment> reassigned = scheduler.Schedule({ pPeer }, 1, 2);
+	REQUIRE(GetHeights(reassigned) == GetHeights(assignments));
+	REQUIRE(!pPeer->IsBanned());
+
+	const BlockDownloadPeerStats stats = GetPeerStats(scheduler.Get(), pPeer);
+	REQUIRE(stats.requestsTimedOut == 2);
+	REQUIRE(stats.window == 4);
+	REQUIRE(stats.numInFlight == 2);
+
+	// A delivery resets the consecutive timeouts, so the peer isn't banned when the next request times out.
+	scheduler.Receive(reassigned.front());
+	scheduler.Advance(std::chrono::seconds(21));
+	REQUIRE(scheduler.Schedule({ pPeer }, 1, 2).size() == 1);
+	REQUIRE(!pPeer->IsBanned());
+}
+
+TEST_CASE("BlockScheduler - Peers that keep timing out are banned, and their requests reassigned")
+{
+	TestScheduler scheduler;
+	const PeerPtr pFastPeer = CreatePeer(1);
+	const PeerPtr pSlowPeer = CreatePeer(2);
+
+	REQUIRE(scheduler.Schedule({ pSlowPeer }, 1, 8).size() == 8);
+
+	// Each pass past the maximum timeout counts once, and the timed out requests are given back to the slow peer's shrinking window.
+	for (const size_t window : { 4, 2 })
+	{
+		scheduler.Advance(std::chrono::seconds(21));
+		REQUIRE(scheduler.Schedule({ pSlowPeer }, 1, 8).size() == window);
+		REQUIRE(!pSlowPeer->IsBanned());
+		REQUIRE(GetPeerStats(scheduler.Get(), pSlowPeer).window == window);
+	}
+
+	// The third consecutive timeout bans the slow peer, and all of the blocks go to the fast peer.
+	const std::vector<PeerPtr> peers({ pFastPeer, pSlowPeer });
+	scheduler.Advance(std::chrono::seconds(21));
+	const std::vector<BlockScheduler::Assignment> reassigned = scheduler.Schedule(peers, 1, 8);
+	REQUIRE(pSlowPeer->IsBanned());
+	REQUIRE(!pFastPeer->IsBanned());
+
+	REQUIRE(FilterByPeer(reassigned, pFastPeer).size() == reassigned.size());
+	REQUIRE(GetHeights(reassigned) == std::set<uint64_t>({ 1, 2, 3, 4, 5, 6, 7, 8 }));
+
+	const BlockDownloadStats stats = scheduler.Get().GetStats();
+	REQUIRE(stats.peers.size() == 1);
+	REQUIRE(stats.peers.front().requestsTimedOut == 0);
+}
+
+TEST_CASE("BlockScheduler - A stall over a large window counts as one timeout")
+{
+	TestScheduler scheduler;
+	const PeerPtr pPeer = CreatePeer(1);
+
+	// Fast deliveries grow the window from 8 to 32.
+	uint64_t nextHeight = 1;
+	for (const size_t window : { 8, 16 })
+	{
+		const std::vector<BlockScheduler::Assignment> assignments = scheduler.Schedule({ pPeer }, nextHeight, nextHeight + window - 1);
+		REQUIRE(assignments.size() == window);
+
+		scheduler.Advance(std::chrono::milliseconds(100));
+		scheduler.Receive(assignments);
+		nextHeight += window;
+	}
+
+	REQUIRE(GetPeerStats(scheduler.Get(), pPeer).window == 32);
+	REQUIRE(scheduler.Schedule({ pPeer }, nextHeight, nextHeight + 31).size() == 32);
+
+	// The peer stalls long enough for its whole window to time out, which only halves the window once.
+	scheduler.Advance(std::chrono::seconds(21));
+	REQUIRE(scheduler.Schedule({ pPeer }, nextHeight, nextHeight + 31).size() == 16);
+	REQUIRE(!pPeer->IsBanned());
+
+	const BlockDownloadPeerStats stats = GetPeerStats(scheduler.Get(), pPeer);
+	REQUIRE(stats.requestsTimedOut == 32);
+	REQUIRE(stats.window == 16);
+	REQUIRE(stats.numInFlight == 16);
+}
+
+TEST_CASE("BlockScheduler - Stragglers are re-requested from a faster peer")
+{
+	TestScheduler scheduler;
+	const PeerPtr pFastPeer = CreatePeer(1);
+	const PeerPtr pSlowPeer = CreatePeer(2);
+	const std::vector<PeerPtr> peers({ pFastPeer, pSlowPeer });
+
+	const std::vector<BlockScheduler::Assignment> assignments = scheduler.Schedule(peers, 1, 16);
+	const std::vector<BlockScheduler::Assignment> slowAssignments = FilterByPeer(assignments, pSlowPeer);
+
+	// The fast peer delivers quickly, lowering its latency estimate well below the slow peer's.
+	scheduler.Advance(std::chrono::milliseconds(100));
+	scheduler.Receive(FilterByPeer(assignments, pFastPeer));
+
+	// Longer than twice the slow peer's latency estimate, but not long enough to time out.
+	scheduler.Advance(std::chrono::milliseconds(4500));
+	const std::vector<BlockScheduler::Assignment> reassigned = scheduler.Schedule(peers, 1, 16);
+
+	// Only the lowest requests (nearest the confirmed tip) are treated as stragglers.
+	REQUIRE(!pSlowPeer->IsBanned());
+	REQUIRE(FilterByPeer(reassigned, pFastPeer).size() == reassigned.size());
+	REQUIRE(GetHeights(reassigned) == GetHeights(std::vector<BlockScheduler::Assignment>(slowAssignments.cbegin(), slowAssignments.cbegin() + 4)));
+
+	const BlockDownloadPeerStats slowStats = GetPeerStats(scheduler.Get(), pSlowPeer);
+	REQUIRE(slowStats.requestsReassigned == 4);
+	REQUIRE(slowStats.requestsTimedOut == 0);
+	REQUIRE(slowStats.numInFlight == 4);
+
+	// Stragglers are only reassigned once.
+	scheduler.Advance(std::chrono::milliseconds(100));
+	REQUIRE(scheduler.Schedule(peers, 1, 16).empty());
+
+	// The slow peer may still deliver a straggler, which completes the request now owned by the fast peer.
+	const size_t numInFlight = scheduler.Get().GetStats().numInFlight;
+	scheduler.Receive(slowAssignments.front());
+	REQUIRE(scheduler.Get().GetStats().numInFlight == numInFlight - 1);
+	REQUIRE(GetPeerStats(scheduler.Get(), pFastPeer).numInFlight == 3);
+	REQUIRE(GetPeerStats(scheduler.Get(), pSlowPeer).blocksReceived == 0);
+}
+
+TEST_CASE("BlockScheduler - Requests to dropped peers are reassigned")
+{
+	TestScheduler scheduler;
+	const PeerPtr pRemainingPeer = CreatePeer(1);
+	const PeerPtr pDroppedPeer = CreatePeer(2);
+
+	const std::vector<BlockScheduler::Assignment> assignments = scheduler.Schedule({ pRemainingPeer, pDroppedPeer }, 1, 16);
+
+	scheduler.Advance(std::chrono::milliseconds(100));
+	scheduler.Receive(FilterByPeer(assignments, pRemainingPeer));
+
+	const std::set<uint64_t> droppedHeights = GetHeights(FilterByPeer(assignments, pDroppedPeer));
+	const std::vector<BlockScheduler::Assignment> reassigned = scheduler.Schedule({ pRemainingPeer }, 1, 16);
+
+	REQUIRE(FilterByPeer(reassigned, pRemainingPeer).size() == reassigned.size());
+	REQUIRE(GetHeights(reassigned) == droppedHeights);
+	REQUIRE(!pDroppedPeer->IsBanned());
+
+	const BlockDownloadStats stats = scheduler.Get().GetStats();
+	REQUIRE(stats.peers.size() == 1);
+	REQUIRE(stats.numInFlight == droppedHeights.size());
+}
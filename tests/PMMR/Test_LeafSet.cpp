@@ -0,0 +1,106 @@
+#include <catch.hpp>
+
+#include "../../src/PMMR/Common/LeafSet.h"
+#include "../../src/PMMR/Common/MMRHashUtil.h"
+#include "../../src/PMMR/Common/MMRUtil.h"
+
+#include <Common/Util/FileUtil.h>
+#include <Core/Serialization/Serializer.h>
+
+static std::shared_ptr<LeafSet> LoadEmptyLeafSet(const std::string& filename)
+{
+	const fs::path path = fs::temp_directory_path() / filename;
+	fs::remove(path);
+	return LeafSet::Load(path.u8string());
+}
+
+//
+// Calculates the root the way LeafSet::Root did before the UBMT was kept in memory:
+// every 1024-leaf chunk is serialized from the leaf set's bits (most significant bit first),
+// appended to a fresh hash file, and the root is bagged from the hash file.
+//
+static Hash ReferenceRoot(const LeafSet& leafSet, const uint64_t numOutputs)
+{
+	const fs::path path = fs::temp_directory_path() / "Test_LeafSet_reference.bin";
+	fs::remove(path);
+	fs::remove(path.u8string() + ".size");
+	std::shared_ptr<HashFile> pHashFile = HashFile::Load(path.u8string());
+
+	uint64_t index = 0;
+	const uint64_t numChunks = (numOutputs + 1023) / 1024;
+	for (uint64_t i = 0; i < numChunks; i++)
+	{
+		Serializer serializer;
+		for (size_t j = 0; j < (1024 / 8); j++)
+		{
+			uint8_t power = 128;
+			uint8_t byte = 0;
+			for (size_t k = 0; k < 8; k++)
+			{
+				if (index < numOutputs && leafSet.Contains(MMRUtil::GetPMMRIndex(index)))
+				{
+					byte += power;
+				}
+
+				power /= 2;
+				++index;
+			}
+
+			serializer.Append(byte);
+		}
+
+		MMRPeaks peaks;
+		MMRHashUtil::AddHashes(pHashFile, serializer.GetBytes(), nullptr, peaks);
+	}
+
+	return MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr);
+}
+
+TEST_CASE("LeafSet::Root - Incremental root matches a full recalculation")
+{
+	std::shared_ptr<LeafSet> pLeafSet = LoadEmptyLeafSet("Test_LeafSet_incremental.bin");
+
+	// Spans multiple 1024-leaf chunks, with a partial last chunk.
+	const uint64_t numLeaves = 5000;
+	for (uint64_t i = 0; i < numLeaves; i++)
+	{
+		pLeafSet->Add((uint32_t)MMRUtil::GetPMMRIndex(i));
+	}
+	pLeafSet->Commit();
+
+	const Hash fullRoot = pLeafSet->Root(numLeaves);
+	REQUIRE(fullRoot == ReferenceRoot(*pLeafSet, numLeaves));
+	REQUIRE(pLeafSet->Root(numLeaves) == fullRoot);
+	REQUIRE(pLeafSet->Root(1024) == ReferenceRoot(*pLeafSet, 1024));
+	REQUIRE(pLeafSet->Root(3000) == ReferenceRoot(*pLeafSet, 3000));
+
+	// Spend a few outputs from different chunks, and recalculate.
+	for (uint64_t leafIndex : { 3, 1500, 4999 })
+	{
+		pLeafSet->Remove((uint32_t)MMRUtil::GetPMMRIndex(leafIndex));
+	}
+
+	const Hash spentRoot = pLeafSet->Root(numLeaves);
+	REQUIRE(spentRoot != fullRoot);
+	REQUIRE(spentRoot == ReferenceRoot(*pLeafSet, numLeaves));
+	REQUIRE(pLeafSet->Root(numLeaves - 2) != spentRoot);
+	REQUIRE(pLeafSet->Root(numLeaves - 2) == ReferenceRoot(*pLeafSet, numLeaves - 2));
+	REQUIRE(pLeafSet->Root(numLeaves) == spentRoot);
+
+	// A new leaf set with the same bits set must produce the same root.
+	std::shared_ptr<LeafSet> pExpected = LoadEmptyLeafSet("Test_LeafSet_expected.bin");
+	for (uint64_t i = 0; i < numLeaves; i++)
+	{
+		if (i != 3 && i != 1500 && i != 4999)
+		{
+			pExpected->Add((uint32_t)MMRUtil::GetPMMRIndex(i));
+		}
+	}
+
+	REQUIRE(pExpected->Root(numLeaves) == spentRoot);
+
+	// Rolling back restores the spent outputs.
+	pLeafSet->Rollback();
+	REQUIRE(pLeafSet->Root(numLeaves) == fullRoot);
+	REQUIRE(pLeafSet->Root(numLeaves) == ReferenceRoot(*pLeafSet, numLeaves));
+}
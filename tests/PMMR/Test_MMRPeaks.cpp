@@ -0,0 +1,123 @@
+#include <catch.hpp>
+
+#include "../../src/PMMR/Common/MMRHashUtil.h"
+#include "../../src/PMMR/Common/MMRPeaks.h"
+#include "../../src/PMMR/Common/MMRUtil.h"
+
+#include <Common/Util/FileUtil.h>
+
+static std::shared_ptr<HashFile> LoadEmptyHashFile(const std::string& filename)
+{
+	const fs::path path = fs::temp_directory_path() / filename;
+	fs::remove(path);
+	fs::remove(path.u8string() + ".size");
+	return HashFile::Load(path.u8string());
+}
+
+static std::vector<unsigned char> SerializeLeaf(const uint64_t leafIndex, const unsigned char salt)
+{
+	std::vector<unsigned char> leaf(8, salt);
+	for (size_t i = 0; i < 8; i++)
+	{
+		leaf[i] ^= (unsigned char)(leafIndex >> (i * 8));
+	}
+
+	return leaf;
+}
+
+TEST_CASE("MMRPeaks - Roots match the roots bagged from the hash file")
+{
+	std::shared_ptr<HashFile> pHashFile = LoadEmptyHashFile("Test_MMRPeaks_roots.bin");
+	MMRPeaks peaks;
+
+	REQUIRE(MMRHashUtil::Root(pHashFile, 0, nullptr, peaks) == ZERO_HASH);
+
+	for (uint64_t i = 0; i < 300; i++)
+	{
+		MMRHashUtil::AddHashes(pHashFile, SerializeLeaf(i, 0x00), nullptr, peaks);
+
+		const uint64_t size = pHashFile->GetSize();
+		REQUIRE(size == MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(i)));
+		REQUIRE(MMRHashUtil::Root(pHashFile, size, nullptr, peaks) == MMRHashUtil::Root(pHashFile, size, nullptr));
+	}
+
+	// Roots of earlier sizes are still bagged from the hash file.
+	const uint64_t earlierSize = MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(99));
+	REQUIRE(MMRHashUtil::Root(pHashFile, earlierSize, nullptr, peaks) == MMRHashUtil::Root(pHashFile, earlierSize, nullptr));
+	pHashFile->Commit();
+
+	// A fresh set of peaks loads from the hash file, and hashes the same parents as the original.
+	std::shared_ptr<HashFile> pCopy = LoadEmptyHashFile("Test_MMRPeaks_copy.bin");
+	for (uint64_t i = 0; i < 300; i++)
+	{
+		MMRPeaks freshPeaks;
+		MMRHashUtil::AddHashes(pCopy, SerializeLeaf(i, 0x00), nullptr, freshPeaks);
+	}
+
+	REQUIRE(pCopy->GetSize() == pHashFile->GetSize());
+	for (uint64_t i = 0; i < pHashFile->GetSize(); i++)
+	{
+		REQUIRE(Hash(pCopy->GetDataPtrAt(i)) == Hash(pHashFile->GetDataPtrAt(i)));
+	}
+}
+
+TEST_CASE("MMRPeaks - Rewind and Rollback")
+{
+	std::shared_ptr<HashFile> pHashFile = LoadEmptyHashFile("Test_MMRPeaks_rewind.bin");
+	MMRPeaks peaks;
+
+	for (uint64_t i = 0; i < 100; i++)
+	{
+		MMRHashUtil::AddHashes(pHashFile, SerializeLeaf(i, 0x00), nullptr, peaks);
+	}
+
+	pHashFile->Commit();
+	const uint64_t committedSize = pHashFile->GetSize();
+	const Hash committedRoot = MMRHashUtil::Root(pHashFile, committedSize, nullptr, peaks);
+
+	// Rewind to 60 leaves, and append different leaves back up to the same size.
+	pHashFile->Rewind(MMRUtil::GetNumNodes(MMRUtil::GetPMMRIndex(59)));
+	peaks.Invalidate();
+	for (uint64_t i = 60; i < 100; i++)
+	{
+		MMRHashUtil::AddHashes(pHashFile, SerializeLeaf(i, 0xFF), nullptr, peaks);
+	}
+
+	REQUIRE(pHashFile->GetSize() == committedSize);
+	const Hash rewoundRoot = MMRHashUtil::Root(pHashFile, committedSize, nullptr, peaks);
+	REQUIRE(rewoundRoot != committedRoot);
+	REQUIRE(rewoundRoot == MMRHashUtil::Root(pHashFile, committedSize, nullptr));
+
+	// Rolling back restores the committed hashes, even though the size is unchanged.
+	pHashFile->Rollback();
+	peaks.Invalidate();
+	REQUIRE(MMRHashUtil::Root(pHashFile, committedSize, nullptr, peaks) == committedRoot);
+}
+
+// Hidden by default. Run with: PMMR_Tests [benchmark]
+TEST_CASE("MMRPeaks - Append and root throughput", "[.][benchmark]")
+{
+	const uint64_t numLeaves = 100000;
+
+	BENCHMARK("Append + Root (bagged from the hash file) - " + std::to_string(numLeaves) + " leaves")
+	{
+		std::shared_ptr<HashFile> pHashFile = LoadEmptyHashFile("Test_MMRPeaks_benchmark_file.bin");
+		for (uint64_t i = 0; i < numLeaves; i++)
+		{
+			MMRPeaks peaks;
+			MMRHashUtil::AddHashes(pHashFile, SerializeLeaf(i, 0x00), nullptr, peaks);
+			MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr);
+		}
+	}
+
+	BENCHMARK("Append + Root (in-memory peaks) - " + std::to_string(numLeaves) + " leaves")
+	{
+		std::shared_ptr<HashFile> pHashFile = LoadEmptyHashFile("Test_MMRPeaks_benchmark_peaks.bin");
+		MMRPeaks peaks;
+		for (uint64_t i = 0; i < numLeaves; i++)
+		{
+			MMRHashUtil::AddHashes(pHashFile, SerializeLeaf(i, 0x00), nullptr, peaks);
+			MMRHashUtil::Root(pHashFile, pHashFile->GetSize(), nullptr, peaks);
+		}
+	}
+}
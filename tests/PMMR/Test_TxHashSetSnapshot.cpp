@@ -0,0 +1,196 @@
+#include <catch.hpp>
+
+#include "../../src/PMMR/Zip/TxHashSetSnapshot.h"
+#include "../../src/PMMR/Zip/ZipFile.h"
+#include "../../src/PMMR/KernelMMR.h"
+#include "../../src/PMMR/OutputPMMR.h"
+#include "../../src/PMMR/RangeProofPMMR.h"
+
+#include <Core/BitmapFile.h>
+#include <Common/Util/FileUtil.h>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+//
+// An IBlockDB that only stores headers and input bitmaps, which is all a snapshot reads.
+//
+class SnapshotDB : public IBlockDB
+{
+public:
+	void Commit() override final { }
+	void Rollback() override final { }
+
+	BlockHeaderPtr GetBlockHeader(const Hash& hash) const override final
+	{
+		auto iter = m_headers.find(hash);
+		return iter != m_headers.end() ? iter->second : nullptr;
+	}
+
+	void AddBlockHeader(BlockHeaderPtr pBlockHeader) override final { m_headers[pBlockHeader->GetHash()] = pBlockHeader; }
+	void AddBlockHeaders(const std::vector<BlockHeaderPtr>&) override final { throw std::logic_error("Not supported"); }
+
+	void AddBlockInputBitmap(const Hash& blockHash, const Roaring& bitmap) override final { m_inputBitmaps[blockHash] = bitmap; }
+	std::unique_ptr<Roaring> GetBlockInputBitmap(const Hash& blockHash) const override final
+	{
+		auto iter = m_inputBitmaps.find(blockHash);
+		return iter != m_inputBitmaps.end() ? std::make_unique<Roaring>(iter->second) : nullptr;
+	}
+
+	void AddBlock(const FullBlock&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<FullBlock> GetBlock(const Hash&) const override final { return nullptr; }
+	void AddBlockSums(const Hash&, const BlockSums&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<BlockSums> GetBlockSums(const Hash&) const override final { return nullptr; }
+	void AddOutputPosition(const Commitment&, const OutputLocation&) override final { throw std::logic_error("Not supported"); }
+	std::unique_ptr<OutputLocation> GetOutputPosition(const Commitment&) const override final { return nullptr; }
+	void AddOutputPositions(const std::vector<std::pair<Commitment, OutputLocation>>&) override final { throw std::logic_error("Not supported"); }
+	std::vector<std::unique_ptr<OutputLocation>> GetOutputPositions(const std::vector<Commitment>&) const override final { throw std::logic_error("Not supported"); }
+
+private:
+	std::unordered_map<Hash, BlockHeaderPtr> m_headers;
+	std::unordered_map<Hash, Roaring> m_inputBitmaps;
+};
+
+static BlockHeaderPtr CreateHeader(const uint64_t height, const Hash& previousHash, const uint64_t mmrSize)
+{
+	Hash powHash;
+	powHash[0] = (unsigned char)(height + 1);
+
+	return std::make_shared<const BlockHeader>(
+		1,
+		height,
+		1500000000 + (int64_t)height * 60,
+		Hash(previousHash),
+		Hash(),
+		Hash(),
+		Hash(),
+		Hash(),
+		BlindingFactor(Hash()),
+		mmrSize,
+		mmrSize,
+		1000 * (height + 1),
+		1,
+		height,
+		ProofOfWork(Consensus::SECOND_POW_EDGE_BITS, std::vector<uint64_t>(), std::move(powHash))
+	);
+}
+
+static std::vector<unsigned char> WriteRandomFile(const fs::path& path, const size_t numBytes)
+{
+	std::vector<unsigned char> bytes(numBytes);
+	for (size_t i = 0; i < numBytes; i++)
+	{
+		bytes[i] = (unsigned char)((i * 131 + numBytes) % 251);
+	}
+
+	fs::create_directories(path.parent_path());
+	REQUIRE(FileUtil::SafeWriteToFile(path.u8string(), bytes));
+	return bytes;
+}
+
+static std::vector<unsigned char> ReadEntry(const ZipFile& zipFile, const std::string& name)
+{
+	const fs::path destination = fs::temp_directory_path() / "Test_TxHashSetSnapshot_entry.bin";
+	fs::remove(destination);
+	zipFile.ExtractFile(name, destination);
+
+	std::vector<unsigned char> bytes;
+	REQUIRE(FileUtil::ReadFile(destination.u8string(), bytes));
+	return bytes;
+}
+
+static std::vector<unsigned char> Prefix(const std::vector<unsigned char>& bytes, const size_t numBytes)
+{
+	REQUIRE(bytes.size() >= numBytes);
+	return std::vector<unsigned char>(bytes.cbegin(), bytes.cbegin() + numBytes);
+}
+
+TEST_CASE("TxHashSetSnapshot - Writes a zip of an earlier block that reads back as its files")
+{
+	const fs::path txHashSetPath = fs::temp_directory_path() / "Test_TxHashSetSnapshot" / "txhashset" / "";
+	fs::remove_all(txHashSetPath);
+
+	// The flushed block has 5 leaves (MMR size 8), and spends the 4th leaf, which is at position 4.
+	// The snapshot is of its parent, which has 3 leaves (MMR size 4).
+	SnapshotDB blockDB;
+	BlockHeaderPtr pHeader = CreateHeader(1, Hash(), 4);
+	BlockHeaderPtr pFlushedHeader = CreateHeader(2, pHeader->GetHash(), 8);
+	blockDB.AddBlockHeader(pHeader);
+	blockDB.AddBlockHeader(pFlushedHeader);
+
+	Roaring inputBitmap;
+	inputBitmap.add(4);
+	blockDB.AddBlockInputBitmap(pFlushedHeader->GetHash(), inputBitmap);
+
+	const std::vector<unsigned char> kernelHashes = WriteRandomFile(txHashSetPath / "kernel" / "pmmr_hash.bin", 8 * HASH_SIZE);
+	const std::vector<unsigned char> kernelData = WriteRandomFile(txHashSetPath / "kernel" / "pmmr_data.bin", 5 * KERNEL_SIZE);
+	const std::vector<unsigned char> outputHashes = WriteRandomFile(txHashSetPath / "output" / "pmmr_hash.bin", 8 * HASH_SIZE);
+	const std::vector<unsigned char> outputData = WriteRandomFile(txHashSetPath / "output" / "pmmr_data.bin", 5 * OUTPUT_SIZE);
+	const std::vector<unsigned char> rangeProofHashes = WriteRandomFile(txHashSetPath / "rangeproof" / "pmmr_hash.bin", 8 * HASH_SIZE);
+	const std::vector<unsigned char> rangeProofData = WriteRandomFile(txHashSetPath / "rangeproof" / "pmmr_data.bin", 5 * RANGE_PROOF_SIZE);
+
+	Roaring flushedLeaves;
+	flushedLeaves.addMany(4, std::vector<uint32_t>({ 1, 2, 5, 8 }).data());
+	BitmapFile::Create((txHashSetPath / "output" / "pmmr_leafset.bin").u8string(), flushedLeaves);
+	BitmapFile::Create((txHashSetPath / "rangeproof" / "pmmr_leafset.bin").u8string(), flushedLeaves);
+
+	std::unique_ptr<TxHashSetSnapshot> pSnapshot = TxHashSetSnapshot::Capture(txHashSetPath, blockDB, *pFlushedHeader, *pHeader);
+	REQUIRE(pSnapshot != nullptr);
+
+	const fs::path zipPath = fs::temp_directory_path() / "Test_TxHashSetSnapshot" / "snapshot.zip";
+	fs::remove(zipPath);
+	pSnapshot->WriteZip(zipPath.u8string());
+
+	std::shared_ptr<ZipFile> pZipFile = ZipFile::Load(zipPath);
+	REQUIRE(pZipFile != nullptr);
+
+	const std::string leafName = "pmmr_leaf.bin." + pHeader->ShortHash();
+	std::vector<std::string> files = pZipFile->ListFiles();
+	std::sort(files.begin(), files.end());
+	REQUIRE(files == std::vector<std::string>({
+		"kernel/pmmr_data.bin",
+		"kernel/pmmr_hash.bin",
+		"output/pmmr_data.bin",
+		"output/pmmr_hash.bin",
+		"output/" + leafName,
+		"output/pmmr_prun.bin",
+		"rangeproof/pmmr_data.bin",
+		"rangeproof/pmmr_hash.bin",
+		"rangeproof/" + leafName,
+		"rangeproof/pmmr_prun.bin"
+	}));
+
+	// Only the prefixes that make up the TxHashSet at the earlier block are zipped.
+	REQUIRE(ReadEntry(*pZipFile, "kernel/pmmr_hash.bin") == Prefix(kernelHashes, 4 * HASH_SIZE));
+	REQUIRE(ReadEntry(*pZipFile, "kernel/pmmr_data.bin") == Prefix(kernelData, 3 * KERNEL_SIZE));
+	REQUIRE(ReadEntry(*pZipFile, "output/pmmr_hash.bin") == Prefix(outputHashes, 4 * HASH_SIZE));
+	REQUIRE(ReadEntry(*pZipFile, "output/pmmr_data.bin") == Prefix(outputData, 3 * OUTPUT_SIZE));
+	REQUIRE(ReadEntry(*pZipFile, "rangeproof/pmmr_hash.bin") == Prefix(rangeProofHashes, 4 * HASH_SIZE));
+	REQUIRE(ReadEntry(*pZipFile, "rangeproof/pmmr_data.bin") == Prefix(rangeProofData, 3 * RANGE_PROOF_SIZE));
+	REQUIRE(ReadEntry(*pZipFile, "output/pmmr_prun.bin").empty());
+
+	// The leaf set is rewound: the spent leaf is restored, and the leaves added by the flushed block are removed.
+	Roaring expectedLeaves;
+	expectedLeaves.addMany(3, std::vector<uint32_t>({ 1, 2, 4 }).data());
+	for (const std::string& directory : { "output/", "rangeproof/" })
+	{
+		const std::vector<unsigned char> leafBytes = ReadEntry(*pZipFile, directory + leafName);
+		REQUIRE(Roaring::readSafe((const char*)leafBytes.data(), leafBytes.size()) == expectedLeaves);
+	}
+
+	pZipFile.reset();
+	fs::remove_all(fs::temp_directory_path() / "Test_TxHashSetSnapshot");
+}
+
+TEST_CASE("TxHashSetSnapshot - Only captures ancestors of the flushed block")
+{
+	const fs::path txHashSetPath = fs::temp_directory_path() / "Test_TxHashSetSnapshot" / "txhashset" / "";
+
+	SnapshotDB blockDB;
+	BlockHeaderPtr pFlushedHeader = CreateHeader(2, Hash(), 8);
+	BlockHeaderPtr pOtherHeader = CreateHeader(1, Hash(), 4);
+	blockDB.AddBlockHeader(pFlushedHeader);
+	blockDB.AddBlockInputBitmap(pFlushedHeader->GetHash(), Roaring());
+
+	REQUIRE(TxHashSetSnapshot::Capture(txHashSetPath, blockDB, *pFlushedHeader, *pOtherHeader) == nullptr);
+}
\ No newline at end of file
@@ -17,5 +17,5 @@ TEST_CASE("ValidateTxHashSet")
 
 	ITxHashSetPtr pTxHashSet = pTxHashSetManager->LoadFromZip(*pConfig, "C:\\Users\\David\\AppData\\Local\\Temp\\rebuilt.txhashset_000004950266.zip", pHeader);
 	SyncStatus status;
-	pTxHashSet->ValidateTxHashSet(*pHeader, *pBlockChain, status);
+	pTxHashSet->ValidateTxHashSet(*pHeader, *pBlockChain, false, status);
 }
\ No newline at end of file
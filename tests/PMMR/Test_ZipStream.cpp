@@ -0,0 +1,315 @@
+#include <catch.hpp>
+
+#include "../../src/PMMR/Zip/ZipStream.h"
+#include "minizip/zip.h"
+
+#include <Core/Exceptions/FileException.h>
+#include <Common/Util/FileUtil.h>
+#include <algorithm>
+#include <map>
+
+//
+// An entry of a zip that's built by hand, so the test controls every field of the local header.
+//
+struct TestEntry
+{
+	std::string name;
+	std::vector<unsigned char> data;
+	bool deflated;
+	bool descriptor;
+	bool zip64;
+	bool badCRC;
+};
+
+static void AppendU16(std::vector<unsigned char>& bytes, const uint16_t value)
+{
+	bytes.push_back((unsigned char)value);
+	bytes.push_back((unsigned char)(value >> 8));
+}
+
+static void AppendU32(std::vector<unsigned char>& bytes, const uint32_t value)
+{
+	AppendU16(bytes, (uint16_t)value);
+	AppendU16(bytes, (uint16_t)(value >> 16));
+}
+
+static void AppendU64(std::vector<unsigned char>& bytes, const uint64_t value)
+{
+	AppendU32(bytes, (uint32_t)value);
+	AppendU32(bytes, (uint32_t)(value >> 32));
+}
+
+static std::vector<unsigned char> RawDeflate(const std::vector<unsigned char>& data)
+{
+	z_stream stream = {};
+	REQUIRE(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+	std::vector<unsigned char> compressed(deflateBound(&stream, (uLong)data.size()));
+	stream.next_in = (Bytef*)data.data();
+	stream.avail_in = (uInt)data.size();
+	stream.next_out = compressed.data();
+	stream.avail_out = (uInt)compressed.size();
+	REQUIRE(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+	return compressed;
+}
+
+static std::vector<unsigned char> BuildZip(const std::vector<TestEntry>& entries)
+{
+	std::vector<unsigned char> zip;
+	for (const TestEntry& entry : entries)
+	{
+		const std::vector<unsigned char> compressed = entry.deflated ? RawDeflate(entry.data) : entry.data;
+		const uint32_t crc = (uint32_t)crc32(crc32(0, Z_NULL, 0), entry.data.data(), (uInt)entry.data.size()) ^ (entry.badCRC ? 1 : 0);
+
+		// With a descriptor, the CRC and sizes in the local header are zero. With zip64, the sizes are in the extra field.
+		AppendU32(zip, 0x04034b50);
+		AppendU16(zip, entry.zip64 ? 45 : 20);
+		AppendU16(zip, entry.descriptor ? 0x0008 : 0);
+		AppendU16(zip, entry.deflated ? 8 : 0);
+		AppendU32(zip, 0);
+		AppendU32(zip, entry.descriptor ? 0 : crc);
+		AppendU32(zip, entry.zip64 ? 0xffffffff : (entry.descriptor ? 0 : (uint32_t)compressed.size()));
+		AppendU32(zip, entry.zip64 ? 0xffffffff : (entry.descriptor ? 0 : (uint32_t)entry.data.size()));
+		AppendU16(zip, (uint16_t)entry.name.size());
+		AppendU16(zip, entry.zip64 ? 20 : 0);
+		zip.insert(zip.end(), entry.name.cbegin(), entry.name.cend());
+
+		if (entry.zip64)
+		{
+			AppendU16(zip, 0x0001);
+			AppendU16(zip, 16);
+			AppendU64(zip, entry.descriptor ? 0 : entry.data.size());
+			AppendU64(zip, entry.descriptor ? 0 : compressed.size());
+		}
+
+		zip.insert(zip.end(), compressed.cbegin(), compressed.cend());
+
+		if (entry.descriptor)
+		{
+			AppendU32(zip, 0x08074b50);
+			AppendU32(zip, crc);
+			if (entry.zip64)
+			{
+				AppendU64(zip, compressed.size());
+				AppendU64(zip, entry.data.size());
+			}
+			else
+			{
+				AppendU32(zip, (uint32_t)compressed.size());
+				AppendU32(zip, (uint32_t)entry.data.size());
+			}
+		}
+	}
+
+	// The central directory isn't read, so only the end of central directory record is written.
+	AppendU32(zip, 0x06054b50);
+	zip.insert(zip.end(), 18, 0);
+	return zip;
+}
+
+static std::vector<unsigned char> TestData(const size_t numBytes, const size_t seed)
+{
+	// Repeats often enough to be compressible, but not so often that it's a single run.
+	std::vector<unsigned char> data(numBytes);
+	for (size_t i = 0; i < numBytes; i++)
+	{
+		data[i] = (unsigned char)(((i / 7) * 31 + seed) % 97);
+	}
+
+	return data;
+}
+
+struct ExtractResult
+{
+	bool finished;
+	std::map<std::string, std::vector<unsigned char>> extracted;
+};
+
+//
+// Feeds the zip to a ZipStream chunkSize bytes at a time, extracting every entry into a temporary folder.
+//
+static ExtractResult Extract(const std::vector<unsigned char>& zip, const size_t chunkSize)
+{
+	const fs::path directory = fs::temp_directory_path() / "Test_ZipStream";
+	fs::remove_all(directory);
+
+	ExtractResult result{ false, {} };
+	ZipStream zipStream(
+		[&directory](const std::string& name) { return directory / name; },
+		[&directory, &result](const std::string& name) {
+			std::vector<unsigned char> bytes;
+			FileUtil::ReadFile((directory / name).u8string(), bytes);
+			result.extracted[name] = bytes;
+		}
+	);
+
+	for (size_t offset = 0; offset < zip.size(); offset += chunkSize)
+	{
+		zipStream.Write(zip.data() + offset, (std::min)(chunkSize, zip.size() - offset));
+	}
+
+	result.finished = zipStream.IsFinished();
+	return result;
+}
+
+static std::vector<TestEntry> MixedEntries()
+{
+	return std::vector<TestEntry>({
+		TestEntry{ "kernel/stored.bin", TestData(1000, 1), false, false, false, false },
+		TestEntry{ "kernel/deflated.bin", TestData(5000, 2), true, false, false, false },
+		TestEntry{ "output/descriptor.bin", TestData(3000, 3), true, true, false, false },
+		TestEntry{ "output/empty.bin", {}, false, false, false, false },
+		TestEntry{ "rangeproof/zip64_stored.bin", TestData(700, 4), false, false, true, false },
+		TestEntry{ "rangeproof/zip64_descriptor.bin", TestData(4000, 5), true, true, true, false }
+	});
+}
+
+static void RequireExtracted(const ExtractResult& result, const std::vector<TestEntry>& entries)
+{
+	REQUIRE(result.finished);
+	REQUIRE(result.extracted.size() == entries.size());
+	for (const TestEntry& entry : entries)
+	{
+		auto iter = result.extracted.find(entry.name);
+		REQUIRE(iter != result.extracted.end());
+		REQUIRE(iter->second == entry.data);
+	}
+}
+
+TEST_CASE("ZipStream - Extracts stored and deflated zips written by minizip")
+{
+	const fs::path zipPath = fs::temp_directory_path() / "Test_ZipStream_minizip.zip";
+	fs::remove(zipPath);
+
+	const std::vector<unsigned char> storedData = TestData(20000, 6);
+	const std::vector<unsigned char> deflatedData = TestData(300000, 7);
+
+	zipFile zf = zipOpen64(zipPath.u8string().c_str(), APPEND_STATUS_CREATE);
+	REQUIRE(zf != nullptr);
+	for (const auto& file : { std::make_pair("stored.bin", &storedData), std::make_pair("deflated.bin", &deflatedData) })
+	{
+		zip_fileinfo zfi = {};
+		const bool stored = file.second == &storedData;
+		REQUIRE(zipOpenNewFileInZip64(zf, file.first, &zfi, nullptr, 0, nullptr, 0, nullptr, stored ? 0 : Z_DEFLATED, stored ? Z_NO_COMPRESSION : Z_DEFAULT_COMPRESSION, 0) == ZIP_OK);
+		REQUIRE(zipWriteInFileInZip(zf, file.second->data(), (unsigned int)file.second->size()) == ZIP_OK);
+		REQUIRE(zipCloseFileInZip(zf) == ZIP_OK);
+	}
+	REQUIRE(zipClose(zf, nullptr) == ZIP_OK);
+
+	std::vector<unsigned char> zip;
+	REQUIRE(FileUtil::ReadFile(zipPath.u8string(), zip));
+	fs::remove(zipPath);
+
+	const ExtractResult result = Extract(zip, 4096);
+	REQUIRE(result.finished);
+	REQUIRE(result.extracted.size() == 2);
+	REQUIRE(result.extracted.at("stored.bin") == storedData);
+	REQUIRE(result.extracted.at("deflated.bin") == deflatedData);
+}
+
+TEST_CASE("ZipStream - Extracts descriptor and zip64 entries across any chunk boundary")
+{
+	const std::vector<TestEntry> entries = MixedEntries();
+	const std::vector<unsigned char> zip = BuildZip(entries);
+
+	for (const size_t chunkSize : { (size_t)1, (size_t)2, (size_t)3, (size_t)7, (size_t)30, (size_t)64, (size_t)1000, zip.size() })
+	{
+		RequireExtracted(Extract(zip, chunkSize), entries);
+	}
+}
+
+TEST_CASE("ZipStream - Truncated zips never finish")
+{
+	const std::vector<TestEntry> entries = MixedEntries();
+	const std::vector<unsigned char> zip = BuildZip(entries);
+
+	// The end of central directory record is 22 bytes, and its signature must arrive before the zip is finished.
+	for (size_t length = 0; length < zip.size() - 18; length += 13)
+	{
+		const std::vector<unsigned char> truncated(zip.cbegin(), zip.cbegin() + length);
+		const ExtractResult result = Extract(truncated, 17);
+		REQUIRE_FALSE(result.finished);
+
+		// Only complete entries are reported, and they're never partial.
+		for (const auto& extracted : result.extracted)
+		{
+			auto iter = std::find_if(entries.cbegin(), entries.cend(), [&extracted](const TestEntry& entry) { return entry.name == extracted.first; });
+			REQUIRE(iter != entries.cend());
+			REQUIRE(extracted.second == iter->data);
+		}
+	}
+}
+
+TEST_CASE("ZipStream - CRC mismatch is rejected")
+{
+	for (const bool descriptor : { false, true })
+	{
+		std::vector<TestEntry> entries = {
+			TestEntry{ "good.bin", TestData(100, 8), false, false, false, false },
+			TestEntry{ "bad.bin", TestData(2000, 9), true, descriptor, false, true }
+		};
+
+		const fs::path directory = fs::temp_directory_path() / "Test_ZipStream";
+		std::vector<std::string> extracted;
+		ZipStream zipStream(
+			[&directory](const std::string& name) { return directory / name; },
+			[&extracted](const std::string& name) { extracted.push_back(name); }
+		);
+
+		const std::vector<unsigned char> zip = BuildZip(entries);
+		REQUIRE_THROWS_AS(zipStream.Write(zip.data(), zip.size()), FileException);
+		REQUIRE(extracted == std::vector<std::string>({ "good.bin" }));
+	}
+}
+
+TEST_CASE("ZipStream - Duplicate and path traversal entry names are rejected")
+{
+	const std::vector<std::string> unsafeNames = {
+		"../kernel/pmmr_data.bin",
+		"kernel/../../pmmr_data.bin",
+		"kernel/..",
+		"..\\pmmr_data.bin",
+		"/etc/pmmr_data.bin",
+		"\\pmmr_data.bin",
+		"C:pmmr_data.bin"
+	};
+
+	for (const std::string& name : unsafeNames)
+	{
+		const std::vector<unsigned char> zip = BuildZip({ TestEntry{ name, TestData(10, 10), false, false, false, false } });
+		REQUIRE_THROWS_AS(Extract(zip, zip.size()), FileException);
+	}
+
+	// Names that only look like traversal are fine.
+	const std::vector<TestEntry> safeEntries = {
+		TestEntry{ "kernel/..data", TestData(10, 11), false, false, false, false },
+		TestEntry{ "kernel/data..", TestData(10, 12), false, false, false, false }
+	};
+	RequireExtracted(Extract(BuildZip(safeEntries), 5), safeEntries);
+
+	// A repeated entry is rejected before it can overwrite the first one.
+	const std::vector<unsigned char> duplicateZip = BuildZip({
+		TestEntry{ "kernel/pmmr_data.bin", TestData(10, 13), false, false, false, false },
+		TestEntry{ "kernel/pmmr_data.bin", TestData(10, 14), true, false, false, false }
+	});
+
+	const fs::path directory = fs::temp_directory_path() / "Test_ZipStream";
+	std::vector<std::string> destinationsRequested;
+	ZipStream zipStream(
+		[&directory, &destinationsRequested](const std::string& name) {
+			destinationsRequested.push_back(name);
+			return directory / name;
+		},
+		[](const std::string&) { }
+	);
+
+	REQUIRE_THROWS_AS(zipStream.Write(duplicateZip.data(), duplicateZip.size()), FileException);
+	REQUIRE(destinationsRequested.size() == 1);
+
+	std::vector<unsigned char> extracted;
+	REQUIRE(FileUtil::ReadFile((directory / "kernel/pmmr_data.bin").u8string(), extracted));
+	REQUIRE(extracted == TestData(10, 13));
+}
\ No newline at end of file
@@ -32,6 +32,10 @@ int main(int, char*[])
 	system("pause");
 	RunTest("Net_Tests");
 
+	std::cout << "Preparing to run P2P tests\n";
+	system("pause");
+	RunTest("P2P_Tests");
+
 	std::cout << "Preparing to run PMMR tests\n";
 	system("pause");
 	RunTest("PMMR_TESTS");
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include "../../src/Server/Node/OutputCursors.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("OutputCursors - Cursors can only be read by one request at a time")
+{
+	OutputCursors cursors;
+
+	std::optional<uint64_t> cursorIdOpt = cursors.Open(100);
+	REQUIRE(cursorIdOpt.has_value());
+	const uint64_t cursorId = cursorIdOpt.value();
+	REQUIRE(cursorId != 0);
+
+	uint64_t nextIndex = 0;
+	REQUIRE(cursors.Take(cursorId, nextIndex) == OutputCursors::EStatus::SUCCESS);
+	REQUIRE(nextIndex == 100);
+	REQUIRE(cursors.Take(cursorId, nextIndex) == OutputCursors::EStatus::IN_USE);
+
+	// A failed read releases the cursor without moving it.
+	cursors.Release(cursorId);
+	REQUIRE(cursors.Take(cursorId, nextIndex) == OutputCursors::EStatus::SUCCESS);
+	REQUIRE(nextIndex == 100);
+
+	cursors.Advance(cursorId, 200);
+	REQUIRE(cursors.Take(cursorId, nextIndex) == OutputCursors::EStatus::SUCCESS);
+	REQUIRE(nextIndex == 200);
+
+	cursors.Close(cursorId);
+	REQUIRE(cursors.Take(cursorId, nextIndex) == OutputCursors::EStatus::EXPIRED);
+	REQUIRE(cursors.Take(cursorId + 1, nextIndex) == OutputCursors::EStatus::EXPIRED);
+}
+
+TEST_CASE("OutputCursors - Cursors in use are never evicted")
+{
+	OutputCursors cursors;
+
+	// Ids are random, rather than sequential.
+	std::vector<uint64_t> cursorIds;
+	for (uint64_t i = 0; i < 64; i++)
+	{
+		std::optional<uint64_t> cursorIdOpt = cursors.Open(i);
+		REQUIRE(cursorIdOpt.has_value());
+		cursorIds.push_back(cursorIdOpt.value());
+	}
+
+	REQUIRE(std::set<uint64_t>(cursorIds.cbegin(), cursorIds.cend()).size() == cursorIds.size());
+	REQUIRE(cursorIds[1] != cursorIds[0] + 1);
+
+	uint64_t nextIndex = 0;
+	for (const uint64_t cursorId : cursorIds)
+	{
+		REQUIRE(cursors.Take(cursorId, nextIndex) == OutputCursors::EStatus::SUCCESS);
+	}
+
+	// Every cursor is in use, so no more can be opened.
+	REQUIRE_FALSE(cursors.Open(1000).has_value());
+
+	// Once two are idle, the one that's been idle longest is evicted.
+	cursors.Release(cursorIds[10]);
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	cursors.Advance(cursorIds[5], 500);
+
+	std::optional<uint64_t> cursorIdOpt = cursors.Open(1000);
+	REQUIRE(cursorIdOpt.has_value());
+	REQUIRE(cursors.Take(cursorIds[10], nextIndex) == OutputCursors::EStatus::EXPIRED);
+	REQUIRE(cursors.Take(cursorIds[5], nextIndex) == OutputCursors::EStatus::SUCCESS);
+	REQUIRE(nextIndex == 500);
+
+	for (size_t i = 0; i < cursorIds.size(); i++)
+	{
+		if (i != 5 && i != 10)
+		{
+			REQUIRE(cursors.Take(cursorIds[i], nextIndex) == OutputCursors::EStatus::IN_USE);
+		}
+	}
+}
\ No newline at end of file
@@ -9,5 +9,6 @@ public:
 	virtual std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>& commitments) const override final { return std::map<Commitment, OutputLocation>(); }
 	virtual std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t startHeight, const uint64_t maxHeight) const override final { return std::vector<BlockWithOutputs>(); }
 	virtual std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const override final { return std::unique_ptr<OutputRange>(nullptr); }
+	virtual std::vector<unsigned char> GetOutputsBulk(const uint64_t startIndex, const uint64_t maxNumOutputs) const override final { return std::vector<unsigned char>(); }
 	virtual bool PostTransaction(const Transaction& transaction) override final { return true; }
 };
\ No newline at end of file
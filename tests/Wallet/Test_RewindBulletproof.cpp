@@ -12,7 +12,7 @@ TEST_CASE("REWIND_BULLETPROOF_ORIGINAL")
 
 	const std::string username = uuids::to_string(uuids::uuid_system_generator()());
 	const CBigInteger<32> masterSeed = RandomNumberGenerator::GenerateRandom32();
-	const SecureVector masterSeedBytes(masterSeed.GetData().begin(), masterSeed.GetData().end());
+	const SecureVector masterSeedBytes(masterSeed.begin(), masterSeed.end());
 	const uint64_t amount = 45;
 	KeyChainPath keyId(std::vector<uint32_t>({ 1, 2, 3 }));
 
@@ -35,7 +35,7 @@ TEST_CASE("REWIND_BULLETPROOF_ENHANCED")
 
 	const std::string username = uuids::to_string(uuids::uuid_system_generator()());
 	const CBigInteger<32> masterSeed = RandomNumberGenerator::GenerateRandom32();
-	const SecureVector masterSeedBytes(masterSeed.GetData().begin(), masterSeed.GetData().end());
+	const SecureVector masterSeedBytes(masterSeed.begin(), masterSeed.end());
 	const uint64_t amount = 45;
 	KeyChainPath keyId(std::vector<uint32_t>({ 1, 2, 3 }));
 